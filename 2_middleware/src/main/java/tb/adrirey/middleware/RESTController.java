@@ -2,12 +2,16 @@ package tb.adrirey.middleware;
 
 import org.apache.commons.codec.DecoderException;
 import org.apache.commons.codec.binary.Hex;
+import org.springframework.beans.factory.annotation.Value;
 import org.springframework.http.ResponseEntity;
 import org.springframework.web.bind.annotation.*;
 import tb.adrirey.middleware.Response.*;
 
 import java.security.SecureRandom;
 import java.time.Instant;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.stream.IntStream;
 
 import static org.apache.tomcat.util.buf.HexUtils.toHexString;
 
@@ -19,6 +23,11 @@ import static org.apache.tomcat.util.buf.HexUtils.toHexString;
  */
 @RestController
 public class RESTController {
+    private static final int CREDENTIAL_VALIDITY = 3600;       // Validity of a credential in seconds
+    private static final int CREDENTIAL_STAGGER = 1800;        // Delay between the expirations of two credentials of a batch in seconds
+    private static final int CREDENTIAL_BATCH_MAX = 64;        // Maximum number of credentials in a batch
+    private static final int READER_CHALLENGES = 2;            // One-time reader challenges per credential of a batch
+
     private ServerCommandProxy scp; // Proxy for the print manager server communication
     private Security sec;           // Security object
     
@@ -26,10 +35,12 @@ public class RESTController {
      * Default constructor
      *
      * Initialize the ServerCommandProxy and Security object
+     *
+     * @param signatureKeyFile private key file of the signed tokens (middleware.signature-key-file), empty : none
      */
-    public RESTController() {
+    public RESTController(@Value("${middleware.signature-key-file:}") String signatureKeyFile) {
         scp = new ServerCommandProxy("PaperCutServer", 9191, "authToken");  // Open XML proxy with server
-        sec = new Security();
+        sec = new Security(signatureKeyFile);
     }
 
     /**
@@ -51,6 +62,26 @@ public class RESTController {
         };
     }
 
+    /**
+     * Build a message for the card reader
+     *
+     * Message structure (see getSignedMessage) : userID, start time, expiration time, 8 bytes of padding
+     *
+     * @param userIDArray user ID (maximum 8 bytes, if more take 8 first bytes)
+     * @param startTime current time in unix timestamp
+     * @param expirationTime expiration time in unix timestamp
+     * @return 32 bytes message
+     */
+    private byte[] buildMessage(byte[] userIDArray, long startTime, long expirationTime) {
+        byte message[] = new byte[32];
+
+        System.arraycopy(userIDArray, 0, message, (8 - Math.min(userIDArray.length, 8)), Math.min(userIDArray.length, 8));    //Copy the user into the message (maximum 8 bytes, if more take 8 first bytes)
+        System.arraycopy(longTo8ByteArray(startTime), 0, message, 8, 8);              // Copy the current time into the message
+        System.arraycopy(longTo8ByteArray(expirationTime), 0, message, 16, 8);        // Copy the expiration time into the message
+
+        return message;
+    }
+
     /**
      * Get request for user name
      *
@@ -180,15 +211,115 @@ public class RESTController {
     @RequestMapping(method = RequestMethod.GET, path ="/getSignedMessage")
     public ResponseEntity<SignedMessage> getSignedMessage(@RequestParam String userID) throws DecoderException {
         int validityTime = 24 * 3600;
-        byte signedMessage[] = new byte[32];
-        byte userIDArray[] = new byte[8];
-        userIDArray = Hex.decodeHex(userID.toCharArray());
+        byte userIDArray[] = Hex.decodeHex(userID.toCharArray());
+        long currentTime = Instant.now().getEpochSecond();
 
-        System.arraycopy(userIDArray, 0, signedMessage, (8 - Math.min(userIDArray.length, 8)), Math.min(userIDArray.length, 8));                                    //Copy the user into the signed message (maximum 8 bytes, if more take 8 first bytes)
-        System.arraycopy(longTo8ByteArray(Instant.now().getEpochSecond()), 0, signedMessage, 8, 8);                            // Copy the current time into the signed message
-        System.arraycopy(longTo8ByteArray(Instant.now().getEpochSecond() + validityTime) , 0, signedMessage, 16, 8);        // Copy the expiration time into the signed message (24h from current time)
+        byte signedMessage[] = buildMessage(userIDArray, currentTime, currentTime + validityTime);     // Expiration time 24h from current time
 
         SignedMessage response = new SignedMessage(toHexString(signedMessage));    ;      //Convert the byte array to hex string
         return ResponseEntity.ok(response);
     }
+
+    /**
+     * Get method for a pre-issued credential
+     *
+     * Handles a GET request to generate a credential that the phone can store and send later to the card reader,
+     * without any call to the middleware during the BLE session.
+     * The credential is a signed message valid 1h, the padding bytes are replaced by a MAC (see Security.signCredential)
+     *
+     * || 31 30 29 28 27 26 25 24 || 23 22 21 20 19 18 17 16 || 15 14 13 12 11 10  9  8 || 7  6  5  4  3  2  1  0 ||
+     *              ^                        ^                          ^                            ^
+     *        8 bytes = userID     8 bytes = current time      8 bytes = expiration time           8 bytes = MAC
+     *
+     * Return it in JSON format
+     *
+     * @param userID userName to get userID
+     * @return ResponseEntity containing the credential
+     */
+    @RequestMapping(method = RequestMethod.GET, path ="/getCredential")
+    public ResponseEntity<Credential> getCredential(@RequestParam String userID) throws DecoderException {
+        byte userIDArray[] = Hex.decodeHex(userID.toCharArray());
+        long currentTime = Instant.now().getEpochSecond();
+
+        byte credential[] = buildMessage(userIDArray, currentTime, currentTime + CREDENTIAL_VALIDITY);
+
+        if (!sec.signCredential(credential)) {
+            return ResponseEntity.internalServerError().build();
+        }
+
+        Credential response = new Credential(toHexString(credential));       //Convert the byte array to hex string
+        return ResponseEntity.ok(response);
+    }
+
+    /**
+     * Get method for a batch of pre-issued credentials
+     *
+     * Handles a GET request to generate count credentials (see getCredential) in one response.
+     * The expirations are staggered : credential i is valid from now for 1h + i * 30min, so the
+     * batch covers (count + 1) * 30min. Every window starts at the time of issue : the reader
+     * takes the start of the first message as its time until the host syncs the clock, a start
+     * in the future would push its clock ahead and expire the credentials of the other users.
+     * The phone fetches a batch only when its credentials run out, not once per print.
+     * The MACs are computed in parallel, each thread reuses its own cipher.
+     *
+     * With signature=true, the credentials are Ed25519 signed tokens (see Security.signToken) instead of MAC credentials :
+     * 96 bytes = message with 8 bytes of padding = 0x00 followed by the 64 bytes signature.
+     *
+     * The batch also holds READER_CHALLENGES one-time challenges per credential with their expected responses
+     * (challenge encrypted as the device authentication of the card reader). Offline, the phone sends a challenge
+     * to the reader and gives it a credential only if the reader answers the expected response : a reader without
+     * the key never receives a credential. Each challenge is used once.
+     *
+     * Return it in JSON format
+     *
+     * @param userID userName to get userID
+     * @param count number of credentials (1 to 64)
+     * @param signature true for signed tokens, false for MAC credentials
+     * @return ResponseEntity containing the credentials ordered by expiration time
+     */
+    @RequestMapping(method = RequestMethod.GET, path ="/getCredentialBatch")
+    public ResponseEntity<CredentialBatch> getCredentialBatch(@RequestParam String userID, @RequestParam(defaultValue = "16") int count,
+                                                              @RequestParam(defaultValue = "false") boolean signature) throws DecoderException {
+        if (count < 1 || count > CREDENTIAL_BATCH_MAX) {
+            return ResponseEntity.badRequest().build();
+        }
+
+        byte userIDArray[] = Hex.decodeHex(userID.toCharArray());
+        long currentTime = Instant.now().getEpochSecond();
+
+        List<byte[]> credentials = IntStream.range(0, count)
+                .parallel()
+                .mapToObj(i -> {
+                    long expirationTime = currentTime + CREDENTIAL_VALIDITY + (long) i * CREDENTIAL_STAGGER;
+                    byte credential[] = buildMessage(userIDArray, currentTime, expirationTime);
+                    if (signature) {
+                        return sec.signToken(credential);
+                    }
+                    return sec.signCredential(credential) ? credential : null;
+                })
+                .toList();      // Keep the order of the stream (expiration time)
+
+        if (credentials.contains(null)) {
+            return ResponseEntity.internalServerError().build();
+        }
+
+        SecureRandom sr = new SecureRandom();
+        List<String> challenges = new ArrayList<>();
+        List<String> responses = new ArrayList<>();
+
+        for (int i = 0; i < count * READER_CHALLENGES; i++) {
+            byte challenge[] = new byte[16];
+            sr.nextBytes(challenge);
+            String expected = sec.encryptData(toHexString(challenge));
+            if (expected == null) {
+                return ResponseEntity.internalServerError().build();
+            }
+            challenges.add(toHexString(challenge));
+            responses.add(expected);
+        }
+
+        CredentialBatch response = new CredentialBatch(credentials.stream().map(credential -> toHexString(credential)).toList(),   //Convert the byte arrays to hex strings
+                challenges, responses);
+        return ResponseEntity.ok(response);
+    }
 }
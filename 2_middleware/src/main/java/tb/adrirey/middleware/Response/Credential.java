@@ -0,0 +1,37 @@
+package tb.adrirey.middleware.Response;
+
+/**
+ * Credential class
+ *
+ * Signed message with a MAC that the card reader can verify without the middleware
+ */
+public class Credential {
+    private String credential;
+
+    /**
+     * Default constructor
+     *
+     * @param credential value to store
+     */
+    public Credential(String credential) {
+        this.credential = credential;
+    }
+
+    /**
+     * credential getter
+     *
+     * @return credential
+     */
+    public String getCredential() {
+        return credential;
+    }
+
+    /**
+     * credential setter
+     *
+     * @param credential value to set
+     */
+    public void setCredential(String credential) {
+        this.credential = credential;
+    }
+}
@@ -0,0 +1,82 @@
+package tb.adrirey.middleware.Response;
+
+import java.util.List;
+
+/**
+ * Credential batch class
+ *
+ * Credentials valid from the time of issue with staggered expirations, ordered by expiration time,
+ * and one-time reader challenges with their expected responses (same index)
+ */
+public class CredentialBatch {
+    private List<String> credentials;
+    private List<String> challenges;
+    private List<String> responses;
+
+    /**
+     * Default constructor
+     *
+     * @param credentials value to store
+     * @param challenges reader challenges to store
+     * @param responses expected reader responses to store
+     */
+    public CredentialBatch(List<String> credentials, List<String> challenges, List<String> responses) {
+        this.credentials = credentials;
+        this.challenges = challenges;
+        this.responses = responses;
+    }
+
+    /**
+     * credentials getter
+     *
+     * @return credentials
+     */
+    public List<String> getCredentials() {
+        return credentials;
+    }
+
+    /**
+     * credentials setter
+     *
+     * @param credentials value to set
+     */
+    public void setCredentials(List<String> credentials) {
+        this.credentials = credentials;
+    }
+
+    /**
+     * challenges getter
+     *
+     * @return challenges
+     */
+    public List<String> getChallenges() {
+        return challenges;
+    }
+
+    /**
+     * challenges setter
+     *
+     * @param challenges value to set
+     */
+    public void setChallenges(List<String> challenges) {
+        this.challenges = challenges;
+    }
+
+    /**
+     * responses getter
+     *
+     * @return responses
+     */
+    public List<String> getResponses() {
+        return responses;
+    }
+
+    /**
+     * responses setter
+     *
+     * @param responses value to set
+     */
+    public void setResponses(List<String> responses) {
+        this.responses = responses;
+    }
+}
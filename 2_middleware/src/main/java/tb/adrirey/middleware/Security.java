@@ -6,10 +6,21 @@ import javax.crypto.BadPaddingException;
 import javax.crypto.Cipher;
 import javax.crypto.IllegalBlockSizeException;
 import javax.crypto.NoSuchPaddingException;
+import javax.crypto.spec.IvParameterSpec;
 import javax.crypto.spec.SecretKeySpec;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.security.InvalidAlgorithmParameterException;
 import java.security.InvalidKeyException;
 import java.security.Key;
+import java.security.KeyFactory;
 import java.security.NoSuchAlgorithmException;
+import java.security.PrivateKey;
+import java.security.Signature;
+import java.security.SignatureException;
+import java.security.spec.InvalidKeySpecException;
+import java.security.spec.PKCS8EncodedKeySpec;
 
 import static org.apache.tomcat.util.buf.HexUtils.toHexString;
 
@@ -18,22 +29,47 @@ import static org.apache.tomcat.util.buf.HexUtils.toHexString;
  *
  * Encrypt and decrypt data using Cipher from java.
  * Using AES encryption with ECB and no padding.
+ * Compute the MAC of the pre-issued credentials using AES-CBC-MAC with a separate key.
+ * Sign the pre-issued tokens with Ed25519, the card reader only knows the public key.
  */
 public class Security {
 
     private byte[] key = {(byte) 0xbf, (byte) 0xc1, (byte) 0xc1, (byte) 0x8b, (byte) 0x3c, (byte) 0x60, (byte) 0x50, (byte) 0x2a,
             (byte) 0x4f, (byte) 0x08, (byte) 0xdf, (byte) 0xb6, (byte) 0xe0, (byte) 0xd9, (byte) 0xd1, (byte) 0x1f};
 
+    // Credential key, never used by encryptData/decryptData so that the MAC can not be computed through the REST service
+    private byte[] credentialKey = {(byte) 0x5e, (byte) 0x19, (byte) 0xa2, (byte) 0x7c, (byte) 0x83, (byte) 0xd4, (byte) 0x0b, (byte) 0xf6,
+            (byte) 0x31, (byte) 0xc8, (byte) 0x6a, (byte) 0x95, (byte) 0x2e, (byte) 0x47, (byte) 0xb0, (byte) 0xdd};
+
+    public static final int CREDENTIAL_MAC_OFFSET = 24;    // Offset of the MAC in the credential
+    public static final int CREDENTIAL_MAC_LENGTH = 8;     // Length of the MAC in bytes
+
+    public static final int TOKEN_MESSAGE_LENGTH = 32;     // Length of the signed message in the token
+    public static final int TOKEN_SIGNATURE_LENGTH = 64;   // Length of the Ed25519 signature in bytes
+
     private Cipher cipher;
     private String transformation = "AES/ECB/NoPadding";
     private Key aesKey;
 
+    private ThreadLocal<Cipher> macCipher;     // Cipher is not thread safe : one initialized cipher per thread, reused for every MAC
+    private String macTransformation = "AES/CBC/NoPadding";
+    private Key macKey;
+    private IvParameterSpec macIV = new IvParameterSpec(new byte[16]);
+
+    private ThreadLocal<Signature> tokenSigner;    // Signature is not thread safe : one initialized signer per thread
+    private String signatureAlgorithm = "Ed25519";
+    private PrivateKey signatureKey;           // Ed25519 private key of the signed tokens, null if not configured
+
     /**
      * Default constructor
      *
      * Create cipher and the aes key. Handle teh exception for the cipher creation
+     * Load the Ed25519 private key of the signed tokens from a file outside the repository (PKCS#8 DER,
+     * ex : openssl genpkey -algorithm ed25519 -outform DER -out token_key.der), its public key is set in the card reader.
+     *
+     * @param signatureKeyFile path of the private key file, empty : no signed token
      */
-    Security() {
+    Security(String signatureKeyFile) {
         try {
             // Check if AES encryption with a key size > 128 bits is supported
             if (Cipher.getMaxAllowedKeyLength("AES") < 128) {
@@ -43,7 +79,17 @@ public class Security {
             cipher = Cipher.getInstance(transformation);
             aesKey = new SecretKeySpec(key, "AES");
 
-        } catch (NoSuchPaddingException | NoSuchAlgorithmException ex) {
+            Cipher.getInstance(macTransformation);      // Check that the MAC transformation is available
+            macKey = new SecretKeySpec(credentialKey, "AES");
+            macCipher = ThreadLocal.withInitial(this::createMacCipher);
+
+            tokenSigner = ThreadLocal.withInitial(this::createTokenSigner);
+            if (!signatureKeyFile.isEmpty()) {
+                KeyFactory keyFactory = KeyFactory.getInstance(signatureAlgorithm);
+                signatureKey = keyFactory.generatePrivate(new PKCS8EncodedKeySpec(Files.readAllBytes(Path.of(signatureKeyFile))));
+            }
+
+        } catch (NoSuchPaddingException | NoSuchAlgorithmException | InvalidKeySpecException | IOException ex) {
             ex.printStackTrace();
         }
     }
@@ -92,4 +138,109 @@ public class Security {
         }
     }
 
+    /**
+     * Create the MAC cipher of the current thread
+     *
+     * The cipher is initialized once. After every doFinal, it returns to this initial state (credential key, null IV).
+     *
+     * @return initialized cipher, null if failed
+     */
+    private Cipher createMacCipher() {
+        try {
+            Cipher cipher = Cipher.getInstance(macTransformation);
+            cipher.init(Cipher.ENCRYPT_MODE, macKey, macIV);
+            return cipher;
+
+        } catch (NoSuchPaddingException | NoSuchAlgorithmException | InvalidKeyException | InvalidAlgorithmParameterException ex) {
+            ex.printStackTrace();
+            return null;
+        }
+    }
+
+    /**
+     * Sign credential method
+     *
+     * Write the MAC of the credential in its last 8 bytes (bytes 24 to 31).
+     * MAC = 8 first bytes of the last block of AES-CBC (IV = 0) over bytes 0 to 23 followed by 8 bytes 0x00.
+     * The card reader computes the same MAC to verify the credential.
+     * Thread safe, can be called in parallel.
+     *
+     * @param credential 32 bytes credential to sign
+     * @return true if succeed, else false
+     */
+    public boolean signCredential(byte[] credential) {
+        Cipher cipher = macCipher.get();
+        if (cipher == null) {
+            return false;
+        }
+
+        try {
+            byte macInput[] = new byte[32];
+            System.arraycopy(credential, 0, macInput, 0, CREDENTIAL_MAC_OFFSET);     // Bytes 24 to 31 stay at 0x00
+
+            byte macOutput[] = cipher.doFinal(macInput);
+
+            System.arraycopy(macOutput, 16, credential, CREDENTIAL_MAC_OFFSET, CREDENTIAL_MAC_LENGTH);  // Copy the MAC (last block) into the credential
+            return true;
+
+        } catch (IllegalBlockSizeException | BadPaddingException ex) {
+            ex.printStackTrace();
+            return false;
+        }
+    }
+
+    /**
+     * Create the token signer of the current thread
+     *
+     * The signer is initialized once. After every sign, it returns to this initial state (private key).
+     *
+     * @return initialized signer, null if failed or no private key
+     */
+    private Signature createTokenSigner() {
+        if (signatureKey == null) {
+            return null;
+        }
+
+        try {
+            Signature signer = Signature.getInstance(signatureAlgorithm);
+            signer.initSign(signatureKey);
+            return signer;
+
+        } catch (NoSuchAlgorithmException | InvalidKeyException ex) {
+            ex.printStackTrace();
+            return null;
+        }
+    }
+
+    /**
+     * Sign token method
+     *
+     * Build a token verified offline by the card reader : 32 bytes message followed by its 64 bytes Ed25519 signature.
+     * Unlike the credentials, the card reader can not create a token, it only knows the public key.
+     * Thread safe, can be called in parallel.
+     *
+     * @param message 32 bytes message to sign (see RESTController.buildMessage)
+     * @return 96 bytes token, null if failed
+     */
+    public byte[] signToken(byte[] message) {
+        Signature signer = tokenSigner.get();
+        if (signer == null) {
+            return null;
+        }
+
+        try {
+            signer.update(message, 0, TOKEN_MESSAGE_LENGTH);
+            byte signature[] = signer.sign();
+
+            byte token[] = new byte[TOKEN_MESSAGE_LENGTH + TOKEN_SIGNATURE_LENGTH];
+            System.arraycopy(message, 0, token, 0, TOKEN_MESSAGE_LENGTH);
+            System.arraycopy(signature, 0, token, TOKEN_MESSAGE_LENGTH, TOKEN_SIGNATURE_LENGTH);
+            return token;
+
+        } catch (SignatureException ex) {
+            ex.printStackTrace();
+            return null;
+        }
+    }
+
 }
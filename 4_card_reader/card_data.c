@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD DATA
+//
+// Read the card number of the selected card from its memory, or from the cache
+// when the same card has been read less than CARDDATA_CACHE_TTL ago.
+//
+// - MIFARE Classic : MifareClassic_Login on the sector, then MifareClassic_ReadBlock
+// - DESFire : DESFire_SelectApplication, DESFire_Authenticate (AES, EV1) and
+//   DESFire_ReadData. The session keys stay in CARDDATA_DESFIRE_CRYPTOENV.
+// - The cache is keyed by UID : a hit trusts the UID for the lifetime of the
+//   entry, keep CARDDATA_CACHE_TTL short
+// - The least recently used entry (or an expired one) is replaced on a miss
+//
+// Memory : CARDDATA_CACHE_SIZE * 40 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "card_data.h"
+
+#if CARDDATA_LENGTH > 16 || (CARDDATA_SOURCE == CARDDATA_SOURCE_MIFARECLASSIC && CARDDATA_OFFSET + CARDDATA_LENGTH > 16)
+  #error "The card number must fit in one MIFARE Classic block (16 bytes)"
+#endif
+
+#if CARDDATA_SOURCE == CARDDATA_SOURCE_MIFARECLASSIC && !defined(CARDDATA_CLASSIC_KEY)
+  #error "CARDDATA_CLASSIC_KEY must be set by the site configuration (appconfig.h)"
+#endif
+
+#if CARDDATA_SOURCE == CARDDATA_SOURCE_DESFIRE && !defined(CARDDATA_DESFIRE_KEY)
+  #error "CARDDATA_DESFIRE_KEY must be set by the site configuration (appconfig.h)"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+#if CARDDATA_SOURCE == CARDDATA_SOURCE_MIFARECLASSIC
+const byte cardDataClassicKey[6] = CARDDATA_CLASSIC_KEY;       // 48 bits MIFARE Classic key of the sector
+#elif CARDDATA_SOURCE == CARDDATA_SOURCE_DESFIRE
+const byte cardDataDESFireKey[16] = CARDDATA_DESFIRE_KEY;      // 128 bits AES key of the DESFire application
+#endif
+
+TCardDataEntry cardDataCache[CARDDATA_CACHE_SIZE];
+
+TCardDataStats cardDataStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the card data reader
+ *
+ * Clear the cache and the counters
+ *
+*/
+void cardDataInit(void)
+{
+    memset(cardDataCache, 0, sizeof(cardDataCache));
+    memset(&cardDataStats, 0, sizeof(cardDataStats));
+}
+
+/**
+ * Read the card number from the memory of the selected card
+ *
+ * @param data : pointer to the CARDDATA_LENGTH bytes card number
+ *
+ * @return true if succeed, else false
+*/
+static bool cardDataReadCard(byte* data)
+{
+#if CARDDATA_SOURCE == CARDDATA_SOURCE_MIFARECLASSIC
+    byte block[16];
+
+    if (!MifareClassic_Login(cardDataClassicKey, CARDDATA_CLASSIC_KEYTYPE, CARDDATA_CLASSIC_SECTOR) ||
+        !MifareClassic_ReadBlock(CARDDATA_CLASSIC_BLOCK, block)) {
+        return false;
+    }
+    memcpy(data, &block[CARDDATA_OFFSET], CARDDATA_LENGTH);
+    return true;
+
+#elif CARDDATA_SOURCE == CARDDATA_SOURCE_DESFIRE
+    if (!DESFire_SelectApplication(CARDDATA_DESFIRE_CRYPTOENV, CARDDATA_DESFIRE_AID)) {
+        return false;
+    }
+    CARDDATA_YIELD();
+    if (!DESFire_Authenticate(CARDDATA_DESFIRE_CRYPTOENV, CARDDATA_DESFIRE_KEYNO, cardDataDESFireKey,
+                              sizeof(cardDataDESFireKey), DESF_KEYTYPE_AES, DESF_AUTHMODE_EV1)) {
+        return false;
+    }
+    CARDDATA_YIELD();
+    return DESFire_ReadData(CARDDATA_DESFIRE_CRYPTOENV, CARDDATA_DESFIRE_FILENO, data, CARDDATA_OFFSET,
+                            CARDDATA_LENGTH, CARDDATA_DESFIRE_COMMSET);
+
+#else
+    (void)data;
+    return false;
+#endif
+}
+
+/**
+ * Get the card number of the selected card
+ *
+ * @param UID : pointer to the UID of the selected card
+ * @param UIDLength : length of the UID in bytes
+ * @param data : pointer to the CARDDATA_LENGTH bytes card number
+ *
+ * @return true if succeed, else false
+*/
+bool cardDataRead(const byte* UID, int UIDLength, byte* data)
+{
+    uint32_t startTicks = GetSysTicks();
+    int replaced = 0;
+
+    if (UIDLength <= 0 || UIDLength > CARDDATA_UIDLENGTH) {
+        return false;
+    }
+
+    for (int i = 0; i < CARDDATA_CACHE_SIZE; i++) {
+        TCardDataEntry* entry = &cardDataCache[i];
+
+        // Expired entries are free
+        if (entry->UIDLength != 0 && (uint32_t)(startTicks - entry->ReadTicks) > CARDDATA_CACHE_TTL) {
+            entry->UIDLength = 0;
+        }
+
+        if (entry->UIDLength == UIDLength && memcmp(entry->UID, UID, UIDLength) == 0) {
+            memcpy(data, entry->Data, CARDDATA_LENGTH);
+            entry->UsedTicks = startTicks;
+
+            cardDataStats.Hits++;
+            cardDataStats.HitTicks += GetSysTicks() - startTicks;
+            return true;
+        }
+
+        // Entry to replace on a miss : free entry, else least recently used
+        if (cardDataCache[replaced].UIDLength != 0 &&
+            (entry->UIDLength == 0 || (uint32_t)(startTicks - entry->UsedTicks) > (uint32_t)(startTicks - cardDataCache[replaced].UsedTicks))) {
+            replaced = i;
+        }
+    }
+
+    if (!cardDataReadCard(data)) {
+        cardDataStats.ReadErrors++;
+        return false;
+    }
+
+    memcpy(cardDataCache[replaced].UID, UID, UIDLength);
+    cardDataCache[replaced].UIDLength = UIDLength;
+    memcpy(cardDataCache[replaced].Data, data, CARDDATA_LENGTH);
+    cardDataCache[replaced].ReadTicks = startTicks;
+    cardDataCache[replaced].UsedTicks = startTicks;
+
+    uint32_t missTicks = GetSysTicks() - startTicks;
+    cardDataStats.Misses++;
+    cardDataStats.MissTicks += missTicks;
+    if (missTicks > cardDataStats.MaxMissTicks) {
+        cardDataStats.MaxMissTicks = missTicks;
+    }
+    return true;
+}
+
+/**
+ * Get the card data counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void cardDataGetStats(TCardDataStats* stats)
+{
+    *stats = cardDataStats;
+}
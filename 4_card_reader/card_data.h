@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD DATA
+//
+// Read the PaperCut card number stored in the card memory
+// - MIFARE Classic : block of a sector (key A or B)
+// - DESFire : file of an application (AES authentication, session in a CRYPTO_ENV)
+// - RAM cache keyed by UID (LRU), a repeated tap skips the card authentication
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CARD_DATA_H__
+#define __CARD_DATA_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define CARDDATA_SOURCE_UID             0       // Card number = UID (no memory read)
+#define CARDDATA_SOURCE_MIFARECLASSIC   1       // Card number in a MIFARE Classic block
+#define CARDDATA_SOURCE_DESFIRE         2       // Card number in a DESFire file
+
+#ifndef CARDDATA_SOURCE
+  #define CARDDATA_SOURCE               CARDDATA_SOURCE_UID
+#endif
+
+#define CARDDATA_FORMAT_HEX             0       // Card number converted to hexadecimal digits
+#define CARDDATA_FORMAT_ASCII           1       // Card number stored as ASCII characters (padded with 0x00)
+
+#ifndef CARDDATA_FORMAT
+  #define CARDDATA_FORMAT               CARDDATA_FORMAT_ASCII
+#endif
+
+#ifndef CARDDATA_LENGTH
+  #define CARDDATA_LENGTH               16      // Card number length in bytes (maximum 16)
+#endif
+
+#ifndef CARDDATA_OFFSET
+  #define CARDDATA_OFFSET               0       // Offset of the card number in the block or file
+#endif
+
+// MIFARE Classic
+#ifndef CARDDATA_CLASSIC_SECTOR
+  #define CARDDATA_CLASSIC_SECTOR       1       // Sector of the card number
+#endif
+
+#ifndef CARDDATA_CLASSIC_BLOCK
+  #define CARDDATA_CLASSIC_BLOCK        4       // Block of the card number (absolute number, in the sector)
+#endif
+
+#ifndef CARDDATA_CLASSIC_KEYTYPE
+  #define CARDDATA_CLASSIC_KEYTYPE      KEYA
+#endif
+
+// CARDDATA_CLASSIC_KEY : 48 bits key of the sector, e.g. {0x12, 0x34, 0x56, 0x78, 0x9a, 0xbc}
+// Site secret, no default : set it in appconfig.h (APPEXTCONFIG) with CARDDATA_SOURCE_MIFARECLASSIC
+
+// DESFire
+#ifndef CARDDATA_DESFIRE_CRYPTOENV
+  #define CARDDATA_DESFIRE_CRYPTOENV    CRYPTO_ENV2     // Environment of the authenticated session (ENV0 and ENV1 used by BLE)
+#endif
+
+#ifndef CARDDATA_DESFIRE_AID
+  #define CARDDATA_DESFIRE_AID          0x505543        // Application ID
+#endif
+
+#ifndef CARDDATA_DESFIRE_KEYNO
+  #define CARDDATA_DESFIRE_KEYNO        1               // Key number of the read access
+#endif
+
+#ifndef CARDDATA_DESFIRE_FILENO
+  #define CARDDATA_DESFIRE_FILENO       0               // File of the card number
+#endif
+
+// CARDDATA_DESFIRE_KEY : 128 bits AES key of the application (16 bytes between braces)
+// Site secret, no default : set it in appconfig.h (APPEXTCONFIG) with CARDDATA_SOURCE_DESFIRE
+
+#ifndef CARDDATA_DESFIRE_COMMSET
+  #define CARDDATA_DESFIRE_COMMSET      DESF_COMMSET_FULLY_ENC
+#endif
+
+#ifndef CARDDATA_YIELD
+  #define CARDDATA_YIELD()                      // Called between the DESFire commands (bus polls of the firmware)
+#endif
+
+// Cache
+#ifndef CARDDATA_CACHE_SIZE
+  #define CARDDATA_CACHE_SIZE           8       // Number of cards in the cache
+#endif
+
+#ifndef CARDDATA_CACHE_TTL
+  #define CARDDATA_CACHE_TTL            300000UL    // Lifetime of a cached card number in milliseconds (5 min)
+#endif
+
+#define CARDDATA_UIDLENGTH              10      // Maximum UID length in bytes
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Cached card number
+typedef struct
+{
+    byte UID[CARDDATA_UIDLENGTH];
+    int UIDLength;              // UID length in bytes, 0 = free entry
+    byte Data[CARDDATA_LENGTH];
+    uint32_t ReadTicks;         // System ticks of the card memory read (lifetime)
+    uint32_t UsedTicks;         // System ticks of the last use (LRU)
+} TCardDataEntry;
+
+// Counters reported by the card data reader
+typedef struct
+{
+    uint32_t Hits;              // Card numbers found in the cache
+    uint32_t Misses;            // Card numbers read from the card memory
+    uint32_t ReadErrors;        // Card memory reads failed (login, authentication, read)
+    uint32_t HitTicks;          // Accumulated hit latency in milliseconds
+    uint32_t MissTicks;         // Accumulated miss latency (card read) in milliseconds
+    uint32_t MaxMissTicks;      // Longest card read in milliseconds
+} TCardDataStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void cardDataInit(void);
+bool cardDataRead(const byte* UID, int UIDLength, byte* data);
+void cardDataGetStats(TCardDataStats* stats);
+
+#endif
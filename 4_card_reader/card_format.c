@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD FORMAT
+//
+// Run the format table over the ID in a single pass, the digits are written
+// directly in the card string (no copy of the ID, no intermediate buffer).
+//
+// - Radix 2, 8, 16 : every digit is a group of bits read from the MSB,
+//   CARDFORMAT_FLAG_BYTEWIDTH pads the number to whole bytes (hex ID of the
+//   former ConvertBinaryToString : 2 digits per byte)
+// - Other radix : the digits in the string are the accumulator, every bit of
+//   the range doubles it and adds the bit (least significant digit first,
+//   reversed at the end). Keeping MaxDigits digits computes the number modulo
+//   radix^MaxDigits.
+// - Over MaxDigits or the space left in the string, the HIGH-order digits are
+//   dropped : the least significant digits are kept (number modulo radix^digits),
+//   the padding zeros go first. The string is never overflowed.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "card_format.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+const char cardFormatDigitsUpper[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+const char cardFormatDigitsLower[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// Format compiled from the configuration
+const TCardFormatOp cardFormatTable[] =
+{
+#ifdef CARDFORMAT_TABLE
+    CARDFORMAT_TABLE
+#else
+    CARDFORMAT_TEXT(CARDFORMAT_PREFIX),
+    CARDFORMAT_NUMBER(CARDFORMAT_RADIX, CARDFORMAT_FLAGS, CARDFORMAT_STARTBIT, CARDFORMAT_BITCOUNT,
+                      CARDFORMAT_MINDIGITS, CARDFORMAT_MAXDIGITS),
+    CARDFORMAT_TEXT(CARDFORMAT_SUFFIX),
+    CARDFORMAT_END
+#endif
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Read one bit of the ID
+ *
+ * @param ID : pointer to the ID
+ * @param IDByteCnt : length of the ID in bytes
+ * @param bit : index of the bit, 0 = MSB of the first byte
+ * @param reverse : bytes in reverse order
+ *
+ * @return value of the bit
+*/
+static inline int cardFormatBit(const byte* ID, int IDByteCnt, int bit, bool reverse)
+{
+    int index = bit >> 3;
+
+    if (reverse) {
+        index = IDByteCnt - 1 - index;
+    }
+    return (ID[index] >> (7 - (bit & 7))) & 1;
+}
+
+/**
+ * Convert a bit range with a power of two radix
+ *
+ * @return number of characters written
+*/
+static int cardFormatPower2(const TCardFormatOp* op, const byte* ID, int IDByteCnt, int startBit, int bitCount,
+                            const char* digitChars, char* out, int space)
+{
+    int bitsPerDigit = (op->Radix == 2) ? 1 : (op->Radix == 8) ? 3 : 4;
+    int digits = (bitCount + bitsPerDigit - 1) / bitsPerDigit;
+    int bit = startBit;
+    int length = 0;
+
+    // Most significant digits over the maximum or the space left : skipped
+    int limit = (op->MaxDigits != 0 && op->MaxDigits < space) ? op->MaxDigits : space;
+    int skipped = (digits > limit) ? digits - limit : 0;
+    int firstBits = bitCount - (digits - 1) * bitsPerDigit;
+
+    if (skipped > 0) {
+        bit += firstBits + (skipped - 1) * bitsPerDigit;
+        firstBits = bitsPerDigit;
+        digits -= skipped;
+    }
+
+    // Width : MinDigits, or the digits of the whole bytes of the range
+    int width = op->MinDigits;
+
+    if (op->Flags & CARDFORMAT_FLAG_BYTEWIDTH) {
+        int byteWidth = ((bitCount + 7) / 8 * 8 + bitsPerDigit - 1) / bitsPerDigit;
+
+        width = MAX(width, (op->MaxDigits != 0) ? MIN(byteWidth, op->MaxDigits) : byteWidth);
+    }
+
+    for (int pad = MIN(width, space) - digits; pad > 0; pad--) {
+        out[length++] = '0';
+    }
+
+    for (int d = 0; d < digits; d++) {
+        int value = 0;
+
+        for (int n = (d == 0) ? firstBits : bitsPerDigit; n > 0; n--) {
+            value = (value << 1) | cardFormatBit(ID, IDByteCnt, bit++, op->Flags & CARDFORMAT_FLAG_REVERSE);
+        }
+        out[length++] = digitChars[value];
+    }
+    return length;
+}
+
+/**
+ * Convert a bit range with any radix
+ *
+ * @return number of characters written
+*/
+static int cardFormatRadix(const TCardFormatOp* op, const byte* ID, int IDByteCnt, int startBit, int bitCount,
+                           const char* digitChars, char* out, int space)
+{
+    int limit = (op->MaxDigits != 0 && op->MaxDigits < space) ? op->MaxDigits : space;
+    int length = 0;
+
+    // Digit values (0 to radix-1) stored least significant first
+    for (int bit = startBit; bit < startBit + bitCount; bit++) {
+        int carry = cardFormatBit(ID, IDByteCnt, bit, op->Flags & CARDFORMAT_FLAG_REVERSE);
+
+        for (int i = 0; i < length; i++) {
+            int value = out[i] * 2 + carry;
+            carry = value >= op->Radix;
+            out[i] = carry ? value - op->Radix : value;
+        }
+        if (carry && length < limit) {
+            out[length++] = carry;
+        }
+    }
+
+    if (length == 0 && limit > 0) {
+        out[length++] = 0;
+    }
+    while (length < op->MinDigits && length < space) {
+        out[length++] = 0;
+    }
+
+    // Most significant digit first, as characters
+    for (int i = 0, j = length - 1; i <= j; i++, j--) {
+        char low = out[i];
+        out[i] = digitChars[(int)out[j]];
+        out[j] = digitChars[(int)low];
+    }
+    return length;
+}
+
+/**
+ * Format the card ID
+ *
+ * @param ops : pointer to the format table (ended by CARDFORMAT_OP_END)
+ * @param ID : pointer to the ID of the card
+ * @param IDBitCnt : bit length of the ID
+ * @param CardString : pointer to the card string
+ * @param MaxCardStringLen : max length of the card string (W/O null-termination)
+ *
+ * @return length of the card string
+*/
+int cardFormat(const TCardFormatOp* ops, const byte* ID, int IDBitCnt, char* CardString, int MaxCardStringLen)
+{
+    int IDByteCnt = (IDBitCnt + 7) / 8;
+    int length = 0;
+
+    for (const TCardFormatOp* op = ops; op->Op != CARDFORMAT_OP_END; op++) {
+        if (op->Op == CARDFORMAT_OP_TEXT) {
+            for (const char* text = op->Text; *text != 0 && length < MaxCardStringLen; text++) {
+                CardString[length++] = *text;
+            }
+        } else if (op->Op == CARDFORMAT_OP_NUMBER && op->Radix >= 2 && op->Radix <= 36) {
+            // Bit range inside the ID (the bits of the last byte past IDBitCnt are not read)
+            int startBit = MIN(op->StartBit, IDBitCnt);
+            int bitCount = (op->BitCount == 0) ? IDBitCnt - startBit : MIN(op->BitCount, IDBitCnt - startBit);
+            const char* digitChars = (op->Flags & CARDFORMAT_FLAG_LOWERCASE) ? cardFormatDigitsLower : cardFormatDigitsUpper;
+
+            if (op->Radix == 2 || op->Radix == 8 || op->Radix == 16) {
+                length += cardFormatPower2(op, ID, IDByteCnt, startBit, bitCount, digitChars,
+                                           &CardString[length], MaxCardStringLen - length);
+            } else {
+                length += cardFormatRadix(op, ID, IDByteCnt, startBit, bitCount, digitChars,
+                                          &CardString[length], MaxCardStringLen - length);
+            }
+        }
+    }
+
+    CardString[length] = 0;
+    return length;
+}
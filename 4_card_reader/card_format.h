@@ -0,0 +1,89 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD FORMAT
+//
+// Convert the card ID to the string sent to the host
+// - The format is a table of operations compiled from the configuration
+//   (appconfig.h with APPEXTCONFIG, else the defaults below)
+// - Text (prefix, suffix) and numbers (bit range, radix, byte order, width)
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CARD_FORMAT_H__
+#define __CARD_FORMAT_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Operations
+#define CARDFORMAT_OP_END           0       // End of the table
+#define CARDFORMAT_OP_TEXT          1       // Copy a text
+#define CARDFORMAT_OP_NUMBER        2       // Convert a bit range of the ID to digits
+
+// Number flags
+#define CARDFORMAT_FLAG_REVERSE     0x01    // Bytes of the ID in reverse order (LSB first UID)
+#define CARDFORMAT_FLAG_LOWERCASE   0x02    // Lowercase letters for the digits above 9
+#define CARDFORMAT_FLAG_BYTEWIDTH   0x04    // Radix 2, 8, 16 : padded to the width of whole bytes (26 bits = 8 hex digits)
+
+// Site format : used when CARDFORMAT_TABLE is not defined
+#ifndef CARDFORMAT_PREFIX
+  #define CARDFORMAT_PREFIX         ""      // Text before the number
+#endif
+
+#ifndef CARDFORMAT_SUFFIX
+  #define CARDFORMAT_SUFFIX         ""      // Text after the number
+#endif
+
+#ifndef CARDFORMAT_RADIX
+  #define CARDFORMAT_RADIX          16      // 2 to 36 (2, 8 and 16 converted without arithmetic)
+#endif
+
+#ifndef CARDFORMAT_FLAGS
+  #define CARDFORMAT_FLAGS          CARDFORMAT_FLAG_BYTEWIDTH   // CARDFORMAT_FLAG_xxx, default : 2 hex digits per byte of the ID
+#endif
+
+#ifndef CARDFORMAT_STARTBIT
+  #define CARDFORMAT_STARTBIT       0       // First bit of the number (bit 0 = MSB of the first byte)
+#endif
+
+#ifndef CARDFORMAT_BITCOUNT
+  #define CARDFORMAT_BITCOUNT       0       // Bits of the number, 0 = up to the end of the ID
+#endif
+
+#ifndef CARDFORMAT_MINDIGITS
+  #define CARDFORMAT_MINDIGITS      0       // Padded with leading zeros to this width
+#endif
+
+#ifndef CARDFORMAT_MAXDIGITS
+  #define CARDFORMAT_MAXDIGITS      0       // Only the least significant digits are kept, 0 = no limit
+#endif
+
+// Entries of a custom table, ex : #define CARDFORMAT_TABLE CARDFORMAT_TEXT("ID"), CARDFORMAT_NUMBER(10, 0, 0, 32, 10, 10), CARDFORMAT_END
+#define CARDFORMAT_TEXT(text)       {CARDFORMAT_OP_TEXT, 0, 0, 0, 0, 0, 0, text}
+#define CARDFORMAT_NUMBER(radix, flags, startBit, bitCount, minDigits, maxDigits) \
+                                    {CARDFORMAT_OP_NUMBER, radix, flags, minDigits, maxDigits, startBit, bitCount, ""}
+#define CARDFORMAT_END              {CARDFORMAT_OP_END, 0, 0, 0, 0, 0, 0, ""}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Operation of the format
+typedef struct
+{
+    byte Op;                    // CARDFORMAT_OP_xxx
+    byte Radix;
+    byte Flags;                 // CARDFORMAT_FLAG_xxx
+    byte MinDigits;
+    byte MaxDigits;             // 0 = no limit, over : the high-order digits are dropped
+    int16_t StartBit;
+    int16_t BitCount;           // 0 = up to the end of the ID
+    const char* Text;
+} TCardFormatOp;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+int cardFormat(const TCardFormatOp* ops, const byte* ID, int IDBitCnt, char* CardString, int MaxCardStringLen);
+
+#endif
@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 CARD PRESENCE
+//
+// Remember the cards present in the field so that each card is reported once
+// per presentation, even when several cards are in the field (badges stacked
+// in a wallet).
+//
+// - Lookup by UID in a small fixed table, at most CARDPRESENCE_SIZE entries,
+//   the polling cost is bounded whatever the number of cards in the field
+// - A card not listed for longer than the timeout is removed, it is reported
+//   again on its next presentation
+//
+// Memory : CARDPRESENCE_SIZE * 20 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "card_presence.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+TCardPresenceEntry cardPresenceTable[CARDPRESENCE_SIZE];
+
+TCardPresenceStats cardPresenceStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the presence table
+ *
+ * Clear all entries and counters
+ *
+*/
+void cardPresenceInit(void)
+{
+    memset(cardPresenceTable, 0, sizeof(cardPresenceTable));
+    memset(&cardPresenceStats, 0, sizeof(cardPresenceStats));
+}
+
+/**
+ * Find a card in the table
+ *
+ * @param UID : pointer to the UID of the card
+ * @param UIDLength : length of the UID in bytes
+ *
+ * @return index of the entry, -1 if the card is not present
+*/
+static int cardPresenceFind(const byte* UID, int UIDLength)
+{
+    for (int i = 0; i < CARDPRESENCE_SIZE; i++) {
+        if (cardPresenceTable[i].UIDLength == UIDLength && memcmp(cardPresenceTable[i].UID, UID, UIDLength) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Refresh a card listed by the anticollision
+ *
+ * @param UID : pointer to the UID of the card
+ * @param UIDLength : length of the UID in bytes
+ * @param ticks : current system ticks
+ *
+ * @return true if the card is already present (its timeout is restarted), else false
+*/
+bool cardPresenceRefresh(const byte* UID, int UIDLength, uint32_t ticks)
+{
+    int entry = (UIDLength > 0) ? cardPresenceFind(UID, UIDLength) : -1;
+
+    if (entry < 0) {
+        return false;
+    }
+    cardPresenceTable[entry].LastSeenTicks = ticks;
+    return true;
+}
+
+/**
+ * Add a card entering the field
+ *
+ * @param UID : pointer to the UID of the card (not present, see cardPresenceRefresh)
+ * @param UIDLength : length of the UID in bytes
+ * @param ticks : current system ticks
+ *
+ * @return true if the card is added (to report), false if the table is full
+*/
+bool cardPresenceAdd(const byte* UID, int UIDLength, uint32_t ticks)
+{
+    if (UIDLength <= 0 || UIDLength > CARDPRESENCE_UIDLENGTH) {
+        return false;
+    }
+
+    int entry = cardPresenceFind(UID, 0);      // First free entry
+
+    if (entry < 0) {
+        cardPresenceStats.TableFull++;
+        return false;
+    }
+
+    memcpy(cardPresenceTable[entry].UID, UID, UIDLength);
+    cardPresenceTable[entry].UIDLength = UIDLength;
+    cardPresenceTable[entry].LastSeenTicks = ticks;
+
+    cardPresenceStats.Present++;
+    cardPresenceStats.Presentations++;
+    if (cardPresenceStats.Present > cardPresenceStats.MaxPresent) {
+        cardPresenceStats.MaxPresent = cardPresenceStats.Present;
+    }
+    return true;
+}
+
+/**
+ * Remove the cards not seen since the timeout
+ *
+ * @param ticks : current system ticks
+ * @param timeout : time in milliseconds after which a card not listed has left the field
+ *
+ * @return number of cards still present
+*/
+int cardPresenceExpire(uint32_t ticks, uint32_t timeout)
+{
+    for (int i = 0; i < CARDPRESENCE_SIZE; i++) {
+        if (cardPresenceTable[i].UIDLength != 0 && (uint32_t)(ticks - cardPresenceTable[i].LastSeenTicks) > timeout) {
+            cardPresenceTable[i].UIDLength = 0;
+            cardPresenceStats.Present--;
+            cardPresenceStats.Timeouts++;
+        }
+    }
+    return cardPresenceStats.Present;
+}
+
+/**
+ * Get the presence counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void cardPresenceGetStats(TCardPresenceStats* stats)
+{
+    *stats = cardPresenceStats;
+}
@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 CARD PRESENCE
+//
+// Table of the ISO14443A cards present in the field
+// - Filled with every UID listed by the anticollision (several cards at once)
+// - Every card keeps its last seen ticks and has its own timeout
+// - A card is new (reported) only when it enters the table
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CARD_PRESENCE_H__
+#define __CARD_PRESENCE_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CARDPRESENCE_SIZE
+  #define CARDPRESENCE_SIZE         4           // Maximum number of cards tracked at the same time
+#endif
+
+#define CARDPRESENCE_UIDLENGTH      10          // Maximum UID length in bytes (ISO14443A triple size UID)
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Card present in the field
+typedef struct
+{
+    byte UID[CARDPRESENCE_UIDLENGTH];
+    int UIDLength;              // UID length in bytes, 0 = free entry
+    uint32_t LastSeenTicks;     // System ticks of the last anticollision listing the card
+} TCardPresenceEntry;
+
+// Counters reported by the presence table
+typedef struct
+{
+    int Present;                // Cards in the table
+    int MaxPresent;             // Highest number of cards in the table at the same time
+    uint32_t Presentations;     // Cards entered in the table (reported once each)
+    uint32_t Timeouts;          // Cards removed after their timeout
+    uint32_t TableFull;         // Cards ignored because the table was full
+} TCardPresenceStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void cardPresenceInit(void);
+bool cardPresenceRefresh(const byte* UID, int UIDLength, uint32_t ticks);
+bool cardPresenceAdd(const byte* UID, int UIDLength, uint32_t ticks);
+int cardPresenceExpire(uint32_t ticks, uint32_t timeout);
+void cardPresenceGetStats(TCardPresenceStats* stats);
+
+#endif
@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD QUEUE
+//
+// Keep the cards identified while a BLE device is connected, a badge tapped
+// during the handshake of a phone is delivered instead of being lost.
+//
+// - Ring buffer of CARDQUEUE_SIZE card strings, the oldest card is delivered first
+// - When the queue is full the new card is dropped (counted), the cards
+//   already waiting keep their order
+// - The latency is the time between the identification and the delivery
+//
+// Memory : CARDQUEUE_SIZE * 84 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "card_queue.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+TCardQueueEntry cardQueue[CARDQUEUE_SIZE];
+int cardQueueHead = 0;          // Index of the oldest card
+
+TCardQueueStats cardQueueStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the card queue
+ *
+ * Clear the queue and the counters
+ *
+*/
+void cardQueueInit(void)
+{
+    memset(cardQueue, 0, sizeof(cardQueue));
+    memset(&cardQueueStats, 0, sizeof(cardQueueStats));
+    cardQueueHead = 0;
+}
+
+/**
+ * Queue a card identified during a BLE session
+ *
+ * @param CardString : pointer to the card string
+ * @param event : pointer to the identification of the card
+ * @param ticks : system ticks of the identification
+ *
+ * @return true if the card is queued (or already waiting), false if it is dropped
+*/
+bool cardQueuePush(const char* CardString, const TIDFrameEvent* event, uint32_t ticks)
+{
+    for (int i = 0; i < cardQueueStats.Depth; i++) {
+        if (strcmp(cardQueue[(cardQueueHead + i) % CARDQUEUE_SIZE].CardString, CardString) == 0) {
+            return true;
+        }
+    }
+
+    if (cardQueueStats.Depth >= CARDQUEUE_SIZE || strlen(CardString) > CARDQUEUE_STRINGLENGTH) {
+        cardQueueStats.Dropped++;
+        return false;
+    }
+
+    TCardQueueEntry* entry = &cardQueue[(cardQueueHead + cardQueueStats.Depth) % CARDQUEUE_SIZE];
+
+    strcpy(entry->CardString, CardString);
+    entry->Event = *event;
+    entry->QueuedTicks = ticks;
+
+    cardQueueStats.Depth++;
+    cardQueueStats.Queued++;
+    if (cardQueueStats.Depth > cardQueueStats.MaxDepth) {
+        cardQueueStats.MaxDepth = cardQueueStats.Depth;
+    }
+    return true;
+}
+
+/**
+ * Take the oldest card of the queue
+ *
+ * @param CardString : pointer to the card string to fill
+ * @param MaxCardStringLen : max length of the card string
+ * @param event : pointer to the identification of the card to fill
+ * @param ticks : system ticks of the delivery
+ *
+ * @return true if a card is taken, false if the queue is empty
+*/
+bool cardQueuePop(char* CardString, int MaxCardStringLen, TIDFrameEvent* event, uint32_t ticks)
+{
+    if (cardQueueStats.Depth == 0) {
+        return false;
+    }
+
+    TCardQueueEntry* entry = &cardQueue[cardQueueHead];
+
+    strncpy(CardString, entry->CardString, MaxCardStringLen);
+    CardString[MaxCardStringLen] = 0;
+    *event = entry->Event;
+
+    cardQueueHead = (cardQueueHead + 1) % CARDQUEUE_SIZE;
+    cardQueueStats.Depth--;
+
+    uint32_t latency = ticks - entry->QueuedTicks;
+    cardQueueStats.Delivered++;
+    cardQueueStats.LatencyTicks += latency;
+    if (latency > cardQueueStats.MaxLatencyTicks) {
+        cardQueueStats.MaxLatencyTicks = latency;
+    }
+    return true;
+}
+
+/**
+ * Get the queue counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void cardQueueGetStats(TCardQueueStats* stats)
+{
+    *stats = cardQueueStats;
+}
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CARD QUEUE
+//
+// Bounded queue of the cards identified during a BLE session
+// - The card strings and their identification (id_frame.h) are delivered in order
+//   when the session ends
+// - A card already queued is not queued again
+// - Depth, drops and delivery latency are counted
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CARD_QUEUE_H__
+#define __CARD_QUEUE_H__
+
+#include "id_frame.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define CARDQUEUE_POLICY_AFTERSESSION   0       // Card delivered when the BLE session ends
+#define CARDQUEUE_POLICY_ABORTSESSION   1       // BLE session aborted, card delivered immediately
+
+#ifndef CARDQUEUE_SIZE
+  #define CARDQUEUE_SIZE                4       // Maximum number of cards waiting for the end of a session
+#endif
+
+#define CARDQUEUE_STRINGLENGTH          64      // Maximum card string length W/O null-termination (32 bytes card data)
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Card waiting for the end of the session
+typedef struct
+{
+    char CardString[CARDQUEUE_STRINGLENGTH+1];
+    TIDFrameEvent Event;        // Source, technology and time of the identification
+    uint32_t QueuedTicks;       // System ticks of the identification
+} TCardQueueEntry;
+
+// Counters reported by the queue
+typedef struct
+{
+    int Depth;                  // Cards in the queue
+    int MaxDepth;               // Highest number of cards in the queue at the same time
+    uint32_t Queued;            // Cards queued
+    uint32_t Delivered;         // Cards delivered after the session
+    uint32_t Dropped;           // Cards lost because the queue was full
+    uint32_t LatencyTicks;      // Accumulated delivery delay in milliseconds
+    uint32_t MaxLatencyTicks;   // Longest delivery delay in milliseconds
+} TCardQueueStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void cardQueueInit(void);
+bool cardQueuePush(const char* CardString, const TIDFrameEvent* event, uint32_t ticks);
+bool cardQueuePop(char* CardString, int MaxCardStringLen, TIDFrameEvent* event, uint32_t ticks);
+void cardQueueGetStats(TCardQueueStats* stats);
+
+#endif
@@ -2,25 +2,84 @@
 //                          RFID/BLE CARD READER FIRMWARE
 //                        
 //
-// - Read MIFARE card and print ID
+// - Read MIFARE card and print ID (formatted only when a new card is found, site format in card_format.h)
+// - Report every MIFARE card in the field once per presentation (anticollision)
+// - Search first the tag types seen the most (LF and HF technologies), the others every few polls
+// - Check the presence of a MIFARE card resting on the reader without a full search
+// - Sleep while idle until the PN5180 detects a card (LPCD), threshold and period calibrated and kept in flash
+// - Read the PaperCut card number from the card memory (MIFARE Classic, DESFire), cached by UID
+// - Buffer the output to the host, sent by the transmit interrupt (the state machine never waits for the host)
+// - Optional fan-out of the output to USB, COM1 and COM2 (one buffer per channel, counters and latency per channel)
+// - Host lagging : drop the newest or the oldest messages, coalesce the duplicates or wait a bounded time (backpressure counted)
+// - Optional binary frames to the host : sequence number, source (card technology, BLE, NFC), timestamp, duration, CRC
+// - Optional Wiegand output of every identification (facility code, card number), sent by the system tick interrupt
+// - Optional Wiegand input : frames of a legacy reader decoded (length, parity) and reported as the cards
+// - Optional OSDP peripheral mode : cards, BLE and NFC users reported as OSDP card reads (secure channel)
+// - Queue the cards found during a BLE session (delivered after the session, or session aborted)
 // - Authenticate and identify via BLE
 //      o Advertise
 //      o Connect
 //      o Authentify himself and phone via double authentication using random 16 bytes numbers
 //      o Print ID
 //      o Disconnect from device
+// - Reject identification tokens already used (replay cache)
+// - Identify via BLE with a credential pre-issued by the middleware (no network call)
+// - Identify via BLE with a token signed by the middleware (Ed25519, public key only on the reader)
+// - Identify via NFC with the same signed token (phone emulating an ISO14443-4 card after a reader challenge, or NDEF record of a type 4 tag)
+// - Prepare the session values (challenge, expected response, notifications) while idle
+// - Optional command server for the host (Simple Protocol) : statistics, clock, timeouts, BLE parameters, output flush
+// - Clock synchronized by the host, drift of the system ticks estimated and corrected between the syncs
 //////////////////////////////////////////////////////////////////////////////////
 
 #include "twn4.sys.h"
 #include "apptools.h"
 
+#if APPEXTCONFIG
+#include "appconfig.h"      // Before the modules : the site configuration also sets the card format
+#endif
+
+#ifndef OSDP
+  #define OSDP                  0       // Report the identifications to an OSDP controller instead of the host (osdp_reader.h) : 0 = off, 1 = on
+#endif                                  // (the command server must use another port than the OSDP bus)
+#ifndef CMDSERVER
+  #define CMDSERVER             0       // Serve the commands of the host on CMDSERVER_CHANNEL (cmd_server.h) : 0 = off, 1 = on
+#endif                                  // (takes COM2 over, links the Simple Protocol library : 41 KB of RAM)
+
+void serviceOSDP(void);
+#define ED25519_YIELD()         serviceOSDP()       // OSDP polls answered during a signature verification
+#define CARDDATA_YIELD()        serviceOSDP()       // and between the DESFire commands
+bool lowPowerWakeUp(void);
+#define LPCD_WAKEUP()           lowPowerWakeUp()    // BLE events checked between the sleep slices (no BLE wake-up source)
+
+#include "replay_cache.c"
+#include "ed25519_verify.c"
+#include "card_presence.c"
+#include "card_data.c"
+#include "id_frame.c"
+#include "card_queue.c"
+#include "card_format.c"
+#include "tag_schedule.c"
+#include "ndef_stream.c"
+#include "lpcd.c"
+#include "host_output.c"
+#include "wiegand.c"
+#include "wiegand_input.c"
+#include "clock_sync.c"
+
+#if OSDP
+#include "osdp_reader.c"                // Only in OSDP mode : osdp.o of the library is not linked otherwise
+#endif
+#if CMDSERVER
+#include "cmd_server.c"                 // Only with the command server : prs.o of the library is not linked otherwise
+#endif
+
 //////////////////////////////////////////////////////////////////////////////////////
 //                                DEFINE CONSTANT
 //////////////////////////////////////////////////////////////////////////////////////
 
 #if APPEXTCONFIG
 
-#include "appconfig.h"
+// appconfig.h included above
 
 #else
 
@@ -28,19 +87,72 @@
   #define CONFIGENABLED         SUPPORT_CONFIGCARD_OFF
 #endif  
        		
+#define LFTAGTYPES              0       // ex : (TAGMASK(LFTAG_HIDPROX) | TAGMASK(LFTAG_EM4102))
 #define HFTAGTYPES       		(TAGMASK(HFTAG_MIFARE))
 
 #define CARDTIMEOUT				2000UL	// Timeout in milliseconds
 #define MAXCARDIDLEN            32		// Length in bytes
 #define MAXCARDSTRINGLEN		128   	// Length W/O null-termination
+#define CARDFORMAT_CALIBRATION  100     // Number of formatting to measure the cost of one
+
+#define MULTICARD               1       // List all ISO14443A cards in the field : 0 = off (one card per SearchTag), 1 = on
+
+#define PRESENCECHECK           1       // Check the presence of a resting ISO14443A card instead of SearchTag : 0 = off, 1 = on
+#define PRESENCE_RESCAN         500UL   // Full search at least every 500 milliseconds (other cards entering the field)
+
+#define LOWPOWER                0       // Sleep while idle, woken up by the low power card detection (lpcd.h) : 0 = off, 1 = on
+
+#define CARDQUEUE_POLICY        CARDQUEUE_POLICY_AFTERSESSION   // Card found during a BLE session : delivered after the session or session aborted
 
 #define LENGTH_8_BYTES			8       // 8 bytes length
 #define LENGTH_16_BYTES			16      // 16 bytes length
 #define LENGTH_32_BYTES			32      // 32 bytes length
 #define LENGTH_64_BYTES			64      // 64 bytes length
+#define LENGTH_192_BYTES        192     // 192 bytes length
 
 #define BLETIMOUT               10000   // Timeout in milliseconds
 
+#define SESSIONPREPARE          1       // Prepare the BLE session values while idle : 0 = off (generated in the states, baseline of the think time), 1 = on
+#define SESSION_CALIBRATION     100     // Number of preparations to measure the cost of one
+
+#define HOSTFORMAT_TEXT         0       // Host output : ID followed by "\r"
+#define HOSTFORMAT_FRAME        1       // Host output : binary frame of the identification (id_frame.h)
+#define HOSTFORMAT              HOSTFORMAT_TEXT
+
+#define WIEGAND                 0       // Send every identification to a Wiegand input (wiegand.h) : 0 = off, 1 = on
+#define WIEGAND_DATA0           GPIO4   // Zeros line (GPIO0 to GPIO2 drive the LEDs)
+#define WIEGAND_DATA1           GPIO5   // Ones line
+#define WIEGAND_FACILITY        0       // Facility code of the site
+#define WIEGAND_CARDRADIX       CARDFORMAT_RADIX    // Radix of the card strings (without prefix and suffix)
+#define WIEGAND_USERRADIX       10      // Radix of the user IDs (BLE, NFC)
+
+#define WIEGANDINPUT            0       // Decode the frames of a Wiegand reader (wiegand_input.h) : 0 = off, 1 = on
+#define WIEGANDINPUT_DATA0      GPIO6   // Zeros line of the reader (not the lines of the Wiegand output)
+#define WIEGANDINPUT_DATA1      GPIO7   // Ones line of the reader
+
+#define LATENCY_BINS            16      // Bins of the latency histograms : bin n counts the latencies from 2^(n-1) to 2^n milliseconds
+
+#if CMDSERVER && (HOSTOUTPUT_CHANNELS & HOSTOUTPUT_MASK(CMDSERVER_CHANNEL))
+  #error "The channel of the command server can not receive the output (HOSTOUTPUT_CHANNELS)"
+#endif
+
+#define OFFLINECREDENTIALS      1       // Accept credentials pre-issued by the middleware : 0 = off, 1 = on
+#define CREDENTIAL_MAC_OFFSET   24      // Offset of the MAC in the credential (bytes 24 to 31)
+#define CREDENTIAL_MAC_LENGTH   8       // MAC length in bytes
+#define CREDENTIAL_SKEW         300     // Message accepted this long before the start of its window in seconds (clock of the reader late)
+
+#define SIGNEDTOKENS            0       // Accept tokens signed by the middleware (Ed25519) : 0 = off, 1 = on (SIGNATURE_PUBLICKEY set by the site)
+#define SIGNEDTOKEN_LENGTH      96      // Signed token length in bytes : 32 bytes message + 64 bytes signature
+
+#define NFCTOKENS               SIGNEDTOKENS    // Accept the signed token of a phone tapped on the reader (ISO14443-4 card emulation) : 0 = off, 1 = on
+#define NFCTOKEN_NONE           0       // Not a phone with the application (card)
+#define NFCTOKEN_VALID          1       // Token valid, user identified
+#define NFCTOKEN_INVALID        2       // Phone with the application, no token or token rejected
+
+#define NDEFTOKENS              1       // Look for the token in the NDEF message of a type 4 tag : 0 = off, 1 = on
+#define NDEFTOKEN_TYPE          "netprinting.ch:token"      // External type (TNF 4) of the token record
+#define NDEFTOKEN_CHUNK         64      // Bytes read by READ BINARY, the message is parsed while it is read
+
 //////////////////////////////////////////////////////////////////////////////////////
 //                                DEFINE VARIABLES
 //////////////////////////////////////////////////////////////////////////////////////
@@ -58,13 +170,15 @@ enum States {
     ST_AppAuthenticated,        // The app is authenticated
     ST_WaitIdentification,      // Authentication protocole succeeded and finished
     ST_Identification,          // App identifies himself (transmits ID)
+    ST_CredentialVerification,  // App sent a pre-issued credential instead of the random number
+    ST_SignatureVerification,   // App sent a signed token instead of the random number
     ST_AuthenticationFailed     // A error occurred during the authentication process
 } currentState;
 
-uint64_t readerCurrentTime = 1690495200;     // Current time in Unix format (seconds since 1 januar 1970)
+uint64_t readerCurrentTime = CLOCKSYNC_DEFAULTTIME / 1000;     // Current time in Unix format (seconds since 1 januar 1970), see clock_sync.h
 
-uint32_t elapsedTicks = 0;
-uint32_t lastSysTicks = 0;
+uint32_t cardTimeout = CARDTIMEOUT;         // Timeouts in milliseconds, changed by the host (command server)
+uint32_t BLETimeout = BLETIMOUT;
 
 
 //-----------------------------  CRYPTO VARIABLES  -----------------------------------
@@ -73,11 +187,92 @@ const byte aesKey[] = {0xbf, 0xc1, 0xc1, 0x8b, 0x3c, 0x60, 0x50,
     0x2a, 0x4f, 0x08, 0xdf, 0xb6, 0xe0, 0xd9, 0xd1, 0x1f};          // 128 bits AES shared key 
 
 
+const byte credentialKey[] = {0x5e, 0x19, 0xa2, 0x7c, 0x83, 0xd4, 0x0b,
+    0xf6, 0x31, 0xc8, 0x6a, 0x95, 0x2e, 0x47, 0xb0, 0xdd};          // 128 bits AES key of the pre-issued credentials (MAC only)
+
+
+// SIGNATURE_PUBLICKEY : Ed25519 public key of the middleware.signature-key-file of the site, set in appconfig.h
+// (openssl pkey -in token_key.der -inform DER -pubout -outform DER | tail -c 32), e.g. {0x3a, 0x21, ..., 0xbe}.
+// No default key : a key known outside the site lets anyone sign tokens.
+#if SIGNEDTOKENS && !defined(SIGNATURE_PUBLICKEY)
+  #error "SIGNATURE_PUBLICKEY must be set by the site configuration (appconfig.h)"
+#endif
+
+#if NFCTOKENS && !SIGNEDTOKENS
+  #error "NFCTOKENS needs SIGNEDTOKENS (the token of the phone is signed)"
+#endif
+
+#if SIGNEDTOKENS
+const byte signaturePublicKey[32] = SIGNATURE_PUBLICKEY;   // Ed25519 public key of the middleware (signed tokens)
+#endif
+
+// Signature verification counters
+typedef struct
+{
+    uint32_t Verifications;     // Signed tokens verified
+    uint32_t Invalid;           // Signatures rejected
+    uint32_t LastTicks;         // Duration of the last signature verification in milliseconds
+    uint32_t WorstTicks;        // Longest signature verification in milliseconds
+} TSignatureStats;
+
+TSignatureStats signatureStats;
+
+const byte NFCTokenSelectAPDU[] = {0x00, 0xa4, 0x04, 0x00, 0x07, 0xf0, 0x50, 0x55, 
+    0x43, 0x49, 0x44, 0x31, 0x00};                                  // SELECT of the application AID F0505543494431, response : challenge (16 bytes) + 90 00
+const byte NFCTokenAuthenticateAPDU[] = {0x80, 0x10, 0x00, 0x00, 0x10};    // + encrypted challenge (16 bytes) + Le 00, response : token + 90 00
+const byte NFCTokenConfirmAPDU[] = {0x80, 0x12, 0x00, 0x00};       // P1 : 00 = user identified, 01 = token rejected, the phone removes the token
+
+const byte NDEFSelectAPDU[] = {0x00, 0xa4, 0x04, 0x00, 0x07, 0xd2, 0x76, 0x00, 
+    0x00, 0x85, 0x01, 0x01, 0x00};                                  // SELECT of the NDEF tag application (type 4 tag)
+const byte NDEFSelectCCAPDU[] = {0x00, 0xa4, 0x00, 0x0c, 0x02, 0xe1, 0x03};      // SELECT of the capability container file
+
+byte NFCToken[LENGTH_192_BYTES];            // Signed token received by NFC (hex characters, as the BLE write)
+byte NFCMessage[LENGTH_64_BYTES];           // Message part of the NFC token
+
+// Latency of the identifications, from the detection of the phone to the output of the user
+typedef struct
+{
+    uint32_t Count;             // Users identified
+    uint32_t Ticks;             // Accumulated latency in milliseconds
+    uint32_t WorstTicks;        // Longest latency in milliseconds
+    uint32_t Histogram[LATENCY_BINS];   // Identifications by latency (power of 2 bins)
+} TIdentificationStats;
+
+TIdentificationStats BLEIdentificationStats;    // From the connection to the output
+TIdentificationStats NFCIdentificationStats;    // From the SearchTag finding the phone to the output
+
+uint32_t sessionStartTicks = 0;             // System ticks of the BLE connection
+uint32_t cardSearchTicks = 0;               // System ticks of the start of the last SearchTag
+
+
 byte encryptedData[LENGTH_16_BYTES];
-byte decryptedData[LENGTH_16_BYTES];
 
 byte randNum[LENGTH_16_BYTES];
 
+// Values of the next BLE session that do not depend on the app, prepared while the reader is idle
+typedef struct
+{
+    bool Ready;                                 // Values prepared and not used by a session yet
+    byte Challenge[LENGTH_16_BYTES];            // Random number sent for the app authentication
+    byte ExpectedResponse[LENGTH_16_BYTES];     // Challenge encrypted with the shared key (response of the app)
+    byte AuthenticatedValue[LENGTH_16_BYTES];   // Random number notified when the app is authenticated
+    byte IdentifiedValue[LENGTH_16_BYTES];      // Random number notified when the identification succeeded
+} TSessionValues;
+
+TSessionValues sessionValues = {.Ready = false};
+
+// Reader think time : work done by chooseSMstate in a state before the transition, per state (index = state)
+// Resolution of the system ticks (1 ms) : a state shorter than 1 ms mostly adds 0, read Ticks / Steps over many sessions
+typedef struct
+{
+    uint32_t Ticks[ST_AuthenticationFailed + 1];    // Accumulated think time in milliseconds
+    uint32_t Steps[ST_AuthenticationFailed + 1];    // Number of transitions from the state
+    uint32_t PrepareMicros;     // Cost of the session values in microseconds (measured at startup) : think time per session moved out of the states
+    bool Prepared;              // SESSIONPREPARE : 1 = values prepared while idle, 0 = generated in the states (baseline)
+} TThinkTimeStats;
+
+TThinkTimeStats thinkTimeStats;
+
 
 
 //-------------------------------  CARD VARIABLES  -----------------------------------
@@ -89,6 +284,40 @@ int TagType;
 int IDBitCnt;
 byte ID[LENGTH_32_BYTES];
 
+// Raw ID of the card on the reader : the card is formatted only when it changes
+int OldCardTagType;
+int OldCardIDBitCnt;
+byte OldCardID[LENGTH_32_BYTES];
+uint32_t OldCardHash;
+bool OldCardPresent = false;
+bool OldCardPhone = false;      // The card is a phone, its NFC token has been read
+
+// Card polling counters
+typedef struct
+{
+    uint32_t Polls;             // Cards found by SearchTag
+    uint32_t SameCard;          // Polls of a card already reported, not read nor formatted (raw ID on the reader, or presence table with MULTICARD)
+    uint32_t NewCards;          // Polls of a new card, read and formatted
+    uint32_t FormatMicros;      // Cost of one formatting in microseconds (measured at startup)
+    uint32_t PresenceChecks;    // Polls done by a presence check instead of SearchTag
+    uint32_t PresenceLost;      // Presence checks failed (card removed), followed by SearchTag
+} TCardScanStats;
+
+TCardScanStats cardScanStats;   // Time saved >= SameCard * FormatMicros (with MULTICARD, also the read of the card memory)
+
+// ISO14443A card resting on the reader, its presence is checked without a full search
+typedef struct
+{
+    bool Parked;                            // A card is parked
+    bool ISO4;                              // The card is ISO14443-4 (checked with ISO14443_4_CheckPresence)
+    bool Phone;                             // Phone (NFC token) : the presence restarts the card timer
+    byte UID[CARDPRESENCE_UIDLENGTH];
+    int UIDLength;
+    uint32_t SearchTicks;                   // System ticks of the last full search
+} TParkedCard;
+
+TParkedCard parkedCard = {.Parked = false};
+
 
 //------------------------------  BLE VARIABLES  -------------------------------------
 
@@ -112,15 +341,20 @@ int attrConfigFlag;
 
 byte receivedDataBLE32[LENGTH_32_BYTES];
 byte receivedDataBLE64[LENGTH_64_BYTES];
+byte receivedDataBLE192[LENGTH_192_BYTES];  // Signed token (the characteristic must accept 192 bytes)
 
 int receivedDataBLELength;
 
 byte transformedReceivedDataBLE16[LENGTH_16_BYTES];
 byte transformedReceivedDataBLE32[LENGTH_32_BYTES];
+byte transformedReceivedDataBLE96[SIGNEDTOKEN_LENGTH];
 
 bool receivedDataLength64 = false;          // The received data lenth is 64 bytes, else 32 bytes
+bool credentialReceived = false;            // The first received data is a pre-issued credential
+bool signedTokenReceived = false;           // The first received data is a signed token
 
 bool BLEDeviceConnected = false;            // A BLE device is connected
+bool BLEConfigChanged = false;              // BLEConfig changed by the host, applied when no device is connected
 
 
 //////////////////////////////////////////////////////////////////////////////////////
@@ -140,7 +374,7 @@ void init(void)
 
 	SetParameters(Params,sizeof(Params));
 
-	SetTagTypes(0, HFTAGTYPES);
+	SetTagTypes(LFTAGTYPES, HFTAGTYPES);
 	
     OldCardString[0] = 0;
 
@@ -152,7 +386,12 @@ void init(void)
 
     //--------------------------------  CRYPTO INIT  -------------------------------------
 
-    Crypto_Init(CRYPTO_ENV0, CRYPTOMODE_CBC_AES128, &aesKey, sizeof(aesKey));   // Enable encryption initialisation with CRYPTO_ENV0 for init vector, CBC-AES128 encryption and the key
+    Crypto_Init(CRYPTO_ENV0, CRYPTOMODE_CBC_AES128, aesKey, sizeof(aesKey));   // Enable encryption initialisation with CRYPTO_ENV0 for init vector, CBC-AES128 encryption and the key
+    Crypto_Init(CRYPTO_ENV1, CRYPTOMODE_CBC_AES128, credentialKey, sizeof(credentialKey));   // CRYPTO_ENV1 computes the CBC-MAC of the pre-issued credentials
+
+#if SIGNEDTOKENS
+    ed25519Init(signaturePublicKey);        // Decode the public key and compute its comb table (once)
+#endif
 
 
     currentState = ST_OnIdle;
@@ -166,10 +405,31 @@ void init(void)
     BeepHigh();
 }
 
+/**
+ * Format card data function
+ * 
+ * Function to convert binary card data to an ASCII string with the site format (card_format.h),
+ * by default hexadecimal digits of all the bits
+ * 
+ * @param Data : pointer to the data
+ * @param DataBitCnt : bit length of the data
+ * @param CardString : pointer to the card string
+ * @param MaxCardStringLen : max length of the card string
+ * 
+ * @return true
+*/
+bool FormatCardData(const byte* Data,int DataBitCnt,char *CardString,int MaxCardStringLen)
+{
+    cardFormat(cardFormatTable,Data,DataBitCnt,CardString,MaxCardStringLen);
+    return true;
+}
+
 /**
  * Read card data function
  * 
  * Function to read card data and convert it to an ASCII string
+ * - ISO14443A card with CARDDATA_SOURCE set (card_data.h) : card number read from the card memory
+ * - Else : ID of the card
  * 
  * @param TagType : indicating the type of RFID card
  * @param ID : pointer to the ID of the card
@@ -177,19 +437,86 @@ void init(void)
  * @param CardString : pointer to the card data
  * @param MaxCardStringLen : max length of the card data
  * 
- * @return true
+ * @return true if succeed, else false (card number not readable)
 */
 bool ReadCardData(int TagType,const byte* ID,int IDBitCnt,char *CardString,int MaxCardStringLen)
 {
+    if (CARDDATA_SOURCE != CARDDATA_SOURCE_UID && TagType == HFTAG_MIFARE)
+    {
+        // Card number from the memory of the selected card or from the cache
+        byte CardNumber[CARDDATA_LENGTH];
+
+        if (!cardDataRead(ID,(IDBitCnt+7)/8,CardNumber))
+        {
+            return false;
+        }
+
+        if (CARDDATA_FORMAT == CARDDATA_FORMAT_ASCII)
+        {
+            int Length = 0;
+            while (Length < CARDDATA_LENGTH && Length < MaxCardStringLen && CardNumber[Length] != 0)
+            {
+                CardString[Length] = CardNumber[Length];
+                Length++;
+            }
+            CardString[Length] = 0;
+            return Length > 0;
+        }
+        return FormatCardData(CardNumber,CARDDATA_LENGTH*8,CardString,MaxCardStringLen);
+    }
+
 	// Select data from card (take any ID from any transponder)
-	byte CardData[32];
-	int CardDataBitCnt;
-    CardDataBitCnt = MIN(IDBitCnt,sizeof(CardData)*8);
-    CopyBits(CardData,0,ID,0,CardDataBitCnt);
+    return FormatCardData(ID,IDBitCnt,CardString,MaxCardStringLen);
+}
 
-  	// Convert data to ASCII
-    ConvertBinaryToString(CardData,0,CardDataBitCnt,CardString,16,(CardDataBitCnt+7)/8*2,MaxCardStringLen);
-    return true;
+/**
+ * Describe an identification
+ * 
+ * @param event : pointer to the identification to fill
+ * @param source : IDFRAME_SOURCE_CARD, IDFRAME_SOURCE_BLE, IDFRAME_SOURCE_NFC or IDFRAME_SOURCE_WIEGAND
+ * @param technology : tag type of the card, Wiegand format of the reader, 0 for BLE
+ * @param startTicks : system ticks of the detection (search or connection)
+ * 
+*/
+void identificationEvent(TIDFrameEvent* event, byte source, byte technology, uint32_t startTicks) {
+    event->Source = source;
+    event->Technology = technology;
+    event->Timestamp = (uint32_t)readerCurrentTime;
+    event->DurationTicks = GetSysTicks() - startTicks;
+}
+
+/**
+ * Output an ID to the host
+ * 
+ * Text line, binary frame with HOSTFORMAT_FRAME or OSDP card read with OSDP, and Wiegand frame with WIEGAND
+ * 
+ * @param IDString : pointer to the card or user string
+ * @param event : pointer to the identification
+ * 
+*/
+void outputID(const char *IDString, const TIDFrameEvent* event) {
+#if OSDP
+    osdpReaderReport(IDString, event);
+#else
+    if (HOSTFORMAT == HOSTFORMAT_FRAME) {
+        byte frame[IDFRAME_MAXLENGTH];
+        int length = idFrameEncode(event, IDString, frame, sizeof(frame));
+
+        if (length > 0) {
+            hostOutputWrite(frame, length);
+        } else {
+            hostOutputDropped(strlen(IDString));     // ID over IDFRAME_MAXID bytes : no frame
+        }
+    } else {
+        hostOutputWriteLine(IDString);
+    }
+#endif
+
+    if (WIEGAND) {
+        bool card = event->Source == IDFRAME_SOURCE_CARD || event->Source == IDFRAME_SOURCE_WIEGAND;
+
+        wiegandSendString(IDString, card ? WIEGAND_CARDRADIX : WIEGAND_USERRADIX, WIEGAND_FACILITY);
+    }
 }
 
 /**
@@ -199,13 +526,13 @@ bool ReadCardData(int TagType,const byte* ID,int IDBitCnt,char *CardString,int M
  * - Sends the card string via UART and updates LEDs and beep to signal the send
  * 
  * @param CardString : pointer to the card data
+ * @param event : pointer to the identification of the card
  * 
 */
-void OnNewCardFound(const char *CardString)
+void OnNewCardFound(const char *CardString, const TIDFrameEvent* event)
 {
-	// Output card string and suffix ("\r")
-    HostWriteString(CardString);
-    HostWriteString("\r");
+	// Output card string and suffix ("\r") or frame
+    outputID(CardString, event);
 
     LEDOff(GREENLED);
     LEDOn(REDLED);
@@ -226,6 +553,7 @@ void OnNewCardFound(const char *CardString)
 */
 void OnCardTimeout(const char *CardString)
 {
+    (void)CardString;
     LEDOn(GREENLED);
     LEDOff(REDLED);
 }
@@ -266,11 +594,16 @@ void deviceConnected(void) {
     // Different devices use the same reader and can not folloow the incrementation 
     CBC_ResetInitVector(CRYPTO_ENV0);
 
+    receivedDataLength64 = false;
+    credentialReceived = false;
+    signedTokenReceived = false;
+
     BLEDeviceConnected = true;
+    sessionStartTicks = GetSysTicks();
 
     currentState = ST_WaitAppRandNum;
 
-    StartTimer(BLETIMOUT);  // Set the disconnect device timeout to 10s for the BLE
+    StartTimer(BLETimeout);  // Set the disconnect device timeout for the BLE (10s by default)
 }
 
 /**
@@ -288,6 +621,8 @@ void deviceDisconnected(void) {
     LEDOn(GREENLED);
 
     BLEDeviceConnected = false;
+
+    sessionValues.Ready = false;    // Values used by the session, new ones are prepared by prepareSession
 }
 
 /**
@@ -322,15 +657,75 @@ void transformByteArray(byte* sourceArray, int arraySize, byte* destinationArray
  * 
 */
 void generateRandNum(byte* randNum){
-    // Set seed for random number based on the system ticks
-    // Can produce different sequences of random numbers each time the function is called, as long as the system ticks are different.
-    srand(GetSysTicks());
+    // Set seed for random number based on the system ticks and the previous sequence
+    // The session values are generated in the same millisecond, the previous sequence makes them different
+    srand(GetSysTicks() ^ rand());
 
     for (int i = 0; i < LENGTH_16_BYTES; i++) {
         randNum[i] = rand() % 256;      // % 256 ensures that the random number is within the range of 0 to 255 (one byte)
     }
 }
 
+/**
+ * Encrypt the challenge of the app authentication : expected response of the app
+ * 
+ * The app returns the challenge encrypted with the shared key, comparing the encrypted values
+ * is the same as comparing the decrypted one with the challenge
+*/
+void encryptChallenge(void) {
+    CBC_ResetInitVector(CRYPTO_ENV0);
+    Encrypt(CRYPTO_ENV0, sessionValues.Challenge, sessionValues.ExpectedResponse, sizeof(sessionValues.ExpectedResponse));
+    CBC_ResetInitVector(CRYPTO_ENV0);
+}
+
+/**
+ * Generate all the values of a session : challenge, expected response and random numbers notified on success
+*/
+void generateSessionValues(void) {
+    generateRandNum(sessionValues.Challenge);
+    encryptChallenge();
+    generateRandNum(sessionValues.AuthenticatedValue);
+    generateRandNum(sessionValues.IdentifiedValue);
+}
+
+/**
+ * Prepare the session values
+ * 
+ * Generate the values of the next BLE session that do not depend on the app, so that
+ * the states only do the work that depends on the received data. Without SESSIONPREPARE
+ * the states generate them when they need them (baseline of the think time statistics).
+ * 
+ * Called in the main loop, does nothing if the values are ready. The values are used
+ * once and prepared again after the disconnection, before the next app can connect.
+*/
+void prepareSession(void) {
+    if (sessionValues.Ready) {
+        return;
+    }
+
+    if (SESSIONPREPARE) {
+        generateSessionValues();
+    }
+    sessionValues.Ready = true;
+}
+
+/**
+ * Measure the cost of the session values
+ * 
+ * Called once at startup (after the crypto init), generate the values SESSION_CALIBRATION times.
+ * The cost of one generation is the think time per session moved out of the states by
+ * SESSIONPREPARE : reduction of the think time against the baseline (SESSIONPREPARE 0).
+*/
+void calibrateSession(void) {
+    uint32_t startTicks = GetSysTicks();
+    for (int i = 0; i < SESSION_CALIBRATION; i++) {
+        generateSessionValues();
+    }
+    thinkTimeStats.PrepareMicros = (GetSysTicks() - startTicks) * 1000 / SESSION_CALIBRATION;
+    thinkTimeStats.Prepared = SESSIONPREPARE;
+    sessionValues.Ready = false;
+}
+
 /**
  * Get specific bytes
  * 
@@ -364,152 +759,876 @@ uint64_t byteArrayToUint64_t(byte* sourceArray, int arraySize) {
 }
 
 /**
- * Update time function
+ * Verify a pre-issued credential
+ * 
+ * The credential has the same structure as the signed message, the padding bytes
+ * are replaced by a MAC computed by the middleware :
+ * MAC = 8 first bytes of the last block of AES-128-CBC(credential key, IV = 0, bytes 0 to 23 + 8 bytes 0x00)
  * 
- * If the elapsed sysTicks are greater than 1000 (> 1 second), the readerCurrentTime is incremented (the minimal unit in unix time format is a seconde)
+ * @param credential pointer to the 32 bytes credential
+ * 
+ * @return true if the MAC is valid, else false
 */
-void updateTime(void) {
-    uint64_t sysTicks = (uint64_t) GetSysTicks();
+bool verifyCredential(const byte* credential) {
+    byte macInput[LENGTH_32_BYTES];
+    byte macOutput[LENGTH_32_BYTES];
 
-    // GetSysTicks() return a value who will restart at 0 after 2^32 system ticks
-    // Manage the case when the last sysTicks is almost at the max and the new has restart
-    if(sysTicks >= lastSysTicks) {
-        elapsedTicks += (sysTicks - lastSysTicks);
-    } else {
-        elapsedTicks += ((2^32 - lastSysTicks) + sysTicks);
-    }
-    lastSysTicks = sysTicks;
+    memcpy(macInput, credential, CREDENTIAL_MAC_OFFSET);
+    memset(&macInput[CREDENTIAL_MAC_OFFSET], 0, CREDENTIAL_MAC_LENGTH);
 
-    // Update time only every second minimum (minimal time unit)
-    if (elapsedTicks >= 1000)
-    {
-        readerCurrentTime = (elapsedTicks / 1000);     // Add elapsed seconds
-        elapsedTicks = elapsedTicks % 1000;                    // Store the remaining time (when less than a second remaining)
-    } 
+    CBC_ResetInitVector(CRYPTO_ENV1);
+    Encrypt(CRYPTO_ENV1, macInput, macOutput, sizeof(macOutput));
+    CBC_ResetInitVector(CRYPTO_ENV1);
+
+    // Compare every byte (constant time) with the MAC of the credential
+    byte difference = 0;
+    for (int i = 0; i < CREDENTIAL_MAC_LENGTH; i++) {
+        difference |= macOutput[LENGTH_16_BYTES + i] ^ credential[CREDENTIAL_MAC_OFFSET + i];
+    }
+    return difference == 0;
 }
 
 /**
- * Scanning for a card
+ * Verify a signed token
  * 
- * Search a card, read his value and print his value if the a BLE device is not connected
+ * Verify the Ed25519 signature of a token of 192 hex characters (32 bytes message + 64 bytes signature)
+ * 
+ * @param token : pointer to the token
+ * @param message : pointer to the message part (64 hex characters), filled if the signature is valid
+ * 
+ * @return true if the signature is valid, else false
 */
-void scanCard(void) {
-	    if (SearchTag(&TagType,&IDBitCnt,ID,sizeof(ID)) && !BLEDeviceConnected)
-	    {
-			// A transponder was found. Read data from transponder and convert
-			// it into an ASCII string according to configuration
-			char NewCardString[MAXCARDSTRINGLEN+1];
+bool verifySignedToken(byte* token, byte* message) {
+    transformByteArray(token, LENGTH_192_BYTES, transformedReceivedDataBLE96);
 
-			if (ReadCardData(TagType,ID,IDBitCnt,NewCardString,sizeof(NewCardString)-1))
-			{
-				// Control if new card
-				if (strcmp(NewCardString,OldCardString) != 0)
-				{
-					strcpy(OldCardString,NewCardString);
-					OnNewCardFound(NewCardString);
-				}
-				// (Re-)start timeout
-			   	StartTimer(CARDTIMEOUT);
-			}
-			OnCardDone();
-	    }
+    uint32_t startTicks = GetSysTicks();
+    bool signatureValid = ed25519Verify(&transformedReceivedDataBLE96[LENGTH_32_BYTES], transformedReceivedDataBLE96, LENGTH_32_BYTES);
+
+    // Keep the duration for the worst case latency of a tap
+    signatureStats.Verifications++;
+    signatureStats.LastTicks = GetSysTicks() - startTicks;
+    if (signatureStats.LastTicks > signatureStats.WorstTicks) {
+        signatureStats.WorstTicks = signatureStats.LastTicks;
+    }
+
+    if (signatureValid) {
+        memcpy(message, token, LENGTH_64_BYTES);
+    } else {
+        signatureStats.Invalid++;
+    }
+    return signatureValid;
 }
 
 /**
- * Verify timeout
+ * Identify the user of a signed message
  * 
- * Control if the timer is used for the BLE or for a card
+ * Check the validity window and the replay cache of the message (64 hex characters),
+ * then get the user ID (16 characters, padding '0' removed)
+ * 
+ * The window starts at the time of the message (bytes 8 to 15, time of issue by the middleware,
+ * also for the credentials of a batch) and ends at its expiration time (bytes 16 to 23). A
+ * message more than CREDENTIAL_SKEW before its start is rejected. Until the host syncs the
+ * clock, a valid message moves the time forward to its start : never past the real time, also
+ * for the first estimate (default time, nothing to compare), then CLOCKSYNC_MAXADVANCE at most.
+ * 
+ * @param message : pointer to the message
+ * @param UserString : pointer to the user ID (17 bytes), filled if the message is valid
+ * 
+ * @return true if the message is valid, else false
 */
-void verifyTimeout(void) {
-    // 
-    if (TestTimer())
-    {
-        // Control if timer used for card or BLE
-        if(BLEDeviceConnected) {
-            currentState = ST_AuthenticationFailed;
-        } else {
-            OnCardTimeout(OldCardString);
-            OldCardString[0] = 0;
+bool identifyMessage(byte* message, char* UserString) {
+    // Need to read the curent and eypiration time in the format 0x11, 0x22, ... instead of 0x1, 0x1, 0x2, 0x2, ...
+    transformByteArray(message, LENGTH_64_BYTES, transformedReceivedDataBLE32);
+
+    // Get current time from the signed message (bytes 8 to 15)
+    byte messageCurrentTime[8];
+    getBytes(transformedReceivedDataBLE32, 8, 15, messageCurrentTime);
+
+    // Get expiration time from the signed message (bytes 16 to 23)
+    byte messageExpirationTime[8];
+    getBytes(transformedReceivedDataBLE32, 16, 23, messageExpirationTime);
+
+    uint64_t currentTime = byteArrayToUint64_t(messageCurrentTime, sizeof(messageCurrentTime));
+    uint64_t expirationTime = byteArrayToUint64_t(messageExpirationTime, sizeof(messageExpirationTime));
+
+    // The message's expiration time must be in the future compare to the message's current time 
+    // and the reader's current time, and its window must have started (skew tolerated), else
+    // signed message is not valid. The default time of the reader can not tell the start.
+    bool messageValid = (expirationTime >= currentTime && expirationTime >= readerCurrentTime &&
+                         (!clockSyncKnown() || currentTime <= readerCurrentTime + CREDENTIAL_SKEW));
+
+    if(messageValid) {
+        // Until the host sets the clock, the reader's time follows the message's current time
+        // (only forward, bounded). A reader synchronized by the host ignores the phone.
+        if(!clockSyncSynced() && currentTime > readerCurrentTime) {
+            clockSyncAdvance(currentTime * 1000);
+            readerCurrentTime = clockSyncNow() / 1000;
+        }
+
+        // A valid message is accepted only once, else it is a replay
+        messageValid = replayCacheCheckAndInsert(replayCacheDigest(transformedReceivedDataBLE32, sizeof(transformedReceivedDataBLE32)), 
+                                                 expirationTime, readerCurrentTime);
+    }
+
+    if(messageValid) {
+        // Get user ID from the signed message, without the padding bytes
+        int length = 0;
+        for (int i = 0; i < LENGTH_16_BYTES; i++) {
+            if(message[i] != '0'){
+                UserString[length++] = message[i];
+            }
         }
+        UserString[length] = 0;
     }
+    return messageValid;
 }
 
 /**
- *
- * Choose the state machine state
+ * Record the latency of an identification
+ * 
+ * @param stats : pointer to the counters of the path (BLE or NFC)
+ * @param startTicks : system ticks of the detection of the phone
  * 
 */
-void chooseSMstate(void) {
-    if(BLEDeviceConnected) {
-        switch(currentState) {
-
-            // -------------------------------------------------------------------------------------
-            // Start the device authentication
-            //
-            // Called when a device is connected and write a random number in a charachteristic
-            // Encrypt the data if correct length and send them to the device via a notification 
-            // -------------------------------------------------------------------------------------
-            case ST_DeviceAuthentication:
-                //HostWriteString("DeviceAuthentication");
-                //HostWriteString("\r");
+void recordIdentification(TIdentificationStats* stats, uint32_t startTicks) {
+    uint32_t latency = GetSysTicks() - startTicks;
 
-                Encrypt(CRYPTO_ENV0, (const) &transformedReceivedDataBLE16, &encryptedData, sizeof(encryptedData));
-                CBC_ResetInitVector(CRYPTO_ENV0);
+    stats->Count++;
+    stats->Ticks += latency;
+    if (latency > stats->WorstTicks) {
+        stats->WorstTicks = latency;
+    }
 
-                BLESetGattServerAttributeValue(attrHandle, 0, &encryptedData, sizeof(encryptedData));       // Write the encrypt data in the attribute and send a notification to the device
+    int bin = 0;
 
-                currentState = ST_WaitDeviceAuthenticated;
-                
-            break;
+    while (bin < LATENCY_BINS - 1 && latency >= (1UL << bin)) {
+        bin++;
+    }
+    stats->Histogram[bin]++;
+}
 
-            // -------------------------------------------------------------------------------------
-            // App being authenticated
-            //
-            // Called when the device has been authenticated
-            // Send a random number to the device via a notification 
-            // -------------------------------------------------------------------------------------
-            case ST_AppAuthentication:
-                //HostWriteString("AppAuthentication");
-                //HostWriteString("\r");
+/**
+ * Update time function
+ * 
+ * The readerCurrentTime follows the clock in milliseconds (clock_sync.h) : elapsed system ticks
+ * corrected by the drift estimated from the syncs of the host (the minimal unit in unix time format is a seconde)
+*/
+void updateTime(void) {
+    readerCurrentTime = clockSyncNow() / 1000;
+}
 
-                generateRandNum(&randNum);
+/**
+ * Get the length of a card ID
+ * 
+ * @param IDBitCnt : bit length of the ID
+ * 
+ * @return length of the ID in bytes (limited to the ID buffer)
+*/
+int cardIDLength(int IDBitCnt) {
+    return MIN((IDBitCnt + 7) / 8, LENGTH_32_BYTES);
+}
 
-                BLESetGattServerAttributeValue(attrHandle, 0, &randNum, sizeof(randNum));   // Write the random number in the attribute and send a notification to the device
+/**
+ * Compute the hash of a card ID
+ * 
+ * 32 bits FNV-1a over the tag type, the bit length and the ID bytes
+ * 
+ * @param TagType : type of the RFID card
+ * @param IDBitCnt : bit length of the ID
+ * @param ID : pointer to the ID of the card
+ * 
+ * @return hash of the card
+*/
+uint32_t cardIDHash(int TagType, int IDBitCnt, const byte* ID) {
+    uint32_t hash = 0x811c9dc5;     // FNV offset basis
 
-                currentState = ST_WaitAppAuthentication;
+    hash = (hash ^ (byte) TagType) * 0x01000193;    // FNV prime
+    hash = (hash ^ (byte) IDBitCnt) * 0x01000193;
 
-                break;
+    for (int i = 0; i < cardIDLength(IDBitCnt); i++) {
+        hash = (hash ^ ID[i]) * 0x01000193;
+    }
+    return hash;
+}
 
-            // -------------------------------------------------------------------------------------
-            // App authenticated
-            //
-            // Called when the app has return the encrypt random number
-            // Decrypt and compare to received data to the send random number
-            // -------------------------------------------------------------------------------------
-            case ST_AppAuthenticated:
-                //HostWriteString("AppAuthenticated");
-                //HostWriteString("\r");
+/**
+ * Check if a card is the card already on the reader
+ * 
+ * The hash rejects a different card in most cases, the raw ID is compared only if it matches
+ * 
+ * @param TagType : type of the RFID card
+ * @param IDBitCnt : bit length of the ID
+ * @param ID : pointer to the ID of the card
+ * @param hash : hash of the card (see cardIDHash)
+ * 
+ * @return true if the card is the card already reported, else false
+*/
+bool isOldCard(int TagType, int IDBitCnt, const byte* ID, uint32_t hash) {
+    return OldCardPresent && hash == OldCardHash && TagType == OldCardTagType && IDBitCnt == OldCardIDBitCnt &&
+           memcmp(ID, OldCardID, cardIDLength(IDBitCnt)) == 0;
+}
 
-                Decrypt(CRYPTO_ENV0, (const) &transformedReceivedDataBLE16, &decryptedData, sizeof(decryptedData));
+/**
+ * Remember the card found by SearchTag as the card on the reader
+ * 
+ * @param hash : hash of the raw ID
+ * @param phone : the card is a phone (NFC token read)
+*/
+void rememberCard(uint32_t hash, bool phone) {
+    OldCardTagType = TagType;
+    OldCardIDBitCnt = IDBitCnt;
+    memcpy(OldCardID, ID, cardIDLength(IDBitCnt));
+    OldCardHash = hash;
+    OldCardPhone = phone;
+    OldCardPresent = true;
+}
 
-                // The Decrypt function return the data in the incorrect format. It as to be transformed. 
-                //byte transformedDecryptedData[BLE_DATA_SIZE];
-                //transformByteArray(&decryptedData, &transformedDecryptedData);
-                
-                // Compare the received decrypt data with the send random number
-                if (memcmp(&decryptedData, &randNum, sizeof(decryptedData)) == 0) {    
-                
-                    // Write a random number in the attribute and send a notification to the device
-                    // to sigifie the the success of the authentication procedure
-                    generateRandNum(&randNum);                                            
-                    BLESetGattServerAttributeValue(attrHandle, 0, &randNum, sizeof(randNum));
+/**
+ * Measure the cost of the card formatting
+ * 
+ * Called once at startup, format a 7 bytes ID CARDFORMAT_CALIBRATION times.
+ * The cost of one formatting is the time saved for every poll of a card already reported.
+*/
+void calibrateCardFormat(void) {
+    byte calibrationID[7] = {0x04, 0x5a, 0x2b, 0x6c, 0x91, 0x3e, 0x80};
+    char calibrationString[MAXCARDSTRINGLEN+1];
 
-                    receivedDataLength64 = true;
+    uint32_t startTicks = GetSysTicks();
+    for (int i = 0; i < CARDFORMAT_CALIBRATION; i++) {
+        FormatCardData(calibrationID, sizeof(calibrationID) * 8, calibrationString, sizeof(calibrationString)-1);
+    }
+    cardScanStats.FormatMicros = (GetSysTicks() - startTicks) * 1000 / CARDFORMAT_CALIBRATION;
+}
 
-                    currentState = ST_WaitIdentification;
-                } else {
-                    currentState = ST_AuthenticationFailed;
-                }
+/**
+ * Report a new card
+ * 
+ * Output the card, or queue it when a BLE device is connected (the host output and the LEDs
+ * belong to the session). With CARDQUEUE_POLICY_ABORTSESSION the session is ended by the
+ * state machine and the card is delivered on the next loop.
+ * 
+ * @param CardString : pointer to the card data
+ * @param event : pointer to the identification of the card
+ * 
+*/
+void reportCard(const char *CardString, const TIDFrameEvent* event) {
+    if (!BLEDeviceConnected) {
+        OnNewCardFound(CardString, event);
+        return;
+    }
+
+    if (cardQueuePush(CardString, event, GetSysTicks()) && CARDQUEUE_POLICY == CARDQUEUE_POLICY_ABORTSESSION) {
+        currentState = ST_AuthenticationFailed;
+    }
+}
+
+/**
+ * System tick interrupt (1 millisecond)
+ * 
+ * Shared by the Wiegand output (next bit) and the Wiegand input (end of frame)
+*/
+void systemTick(void) {
+    if (WIEGAND) {
+        wiegandTick();
+    }
+    if (WIEGANDINPUT) {
+        wiegandInputTick();
+    }
+}
+
+/**
+ * Report the frames of the Wiegand reader
+ * 
+ * The facility code and card number are formatted as the ID of a card (card_format.h) and reported with
+ * its Wiegand format as technology. During a BLE session the card is queued (see reportCard).
+*/
+void scanWiegandInput(void) {
+    byte CardID[WIEGAND_MAXBITS / 8];
+    int CardIDBitCnt;
+    int format;
+    uint32_t startTicks;
+
+    while (wiegandInputRead(CardID, &CardIDBitCnt, &format, &startTicks)) {
+        char CardString[MAXCARDSTRINGLEN+1];
+        TIDFrameEvent event;
+
+        if (!FormatCardData(CardID, CardIDBitCnt, CardString, sizeof(CardString)-1)) {
+            continue;
+        }
+
+        identificationEvent(&event, IDFRAME_SOURCE_WIEGAND, format, startTicks);
+        reportCard(CardString, &event);
+        if (!BLEDeviceConnected) {
+            StartTimer(cardTimeout);    // The card timeout resets the LEDs
+        }
+    }
+}
+
+/**
+ * Deliver the queued cards
+ * 
+ * Called when no BLE device is connected, output the cards found during the last session
+ * in the order of their identification.
+*/
+void deliverQueuedCards(void) {
+    char CardString[MAXCARDSTRINGLEN+1];
+    TIDFrameEvent event;
+    bool delivered = false;
+
+    while (cardQueuePop(CardString, sizeof(CardString)-1, &event, GetSysTicks())) {
+        OnNewCardFound(CardString, &event);
+        delivered = true;
+    }
+
+    if (delivered) {
+        StartTimer(cardTimeout);    // The session timer is stopped, the card timeout resets the LEDs
+    }
+}
+
+/**
+ * Scan all the ISO14443A cards in the field
+ * 
+ * List the UIDs with the anticollision. A card entering the field is selected (to check that
+ * it answers), converted and reported once : it enters the presence table only when its card
+ * number has been read, a failed read is tried again next poll. The cards already present only restart their
+ * own timeout in the presence table, two stacked cards are not reported alternately.
+ * At most CARDPRESENCE_SIZE UIDs are listed per poll.
+*/
+void scanMultiCard(void) {
+    byte UIDList[CARDPRESENCE_SIZE * (CARDPRESENCE_UIDLENGTH + 1)];     // Entries : UID length (1 byte) + UID
+    int UIDCnt;
+    int UIDListByteCnt;
+
+    if (!ISO14443A_SearchMultiTag(&UIDCnt, &UIDListByteCnt, UIDList, sizeof(UIDList))) {
+        return;
+    }
+
+    uint32_t ticks = GetSysTicks();
+    int offset = 0;
+
+    for (int i = 0; i < UIDCnt && offset < UIDListByteCnt; i++) {
+        int UIDLength = UIDList[offset];
+        const byte* UID = &UIDList[offset + 1];
+
+        offset += UIDLength + 1;
+        if (offset > UIDListByteCnt) {
+            break;
+        }
+
+        // Debounce of the listed cards : a card of the presence table is already reported, not read again
+        if (cardPresenceRefresh(UID, UIDLength, ticks)) {
+            cardScanStats.SameCard++;
+            continue;
+        }
+        if (!ISO14443A_SelectTag(UID, UIDLength)) {
+            continue;
+        }
+
+        // Present only once read : a card whose number is not readable (torn read) is read again next poll
+        char NewCardString[MAXCARDSTRINGLEN+1];
+
+        if (ReadCardData(HFTAG_MIFARE, UID, UIDLength * 8, NewCardString, sizeof(NewCardString)-1) &&
+            cardPresenceAdd(UID, UIDLength, ticks)) {
+            TIDFrameEvent event;
+
+            cardScanStats.NewCards++;
+
+            identificationEvent(&event, IDFRAME_SOURCE_CARD, HFTAG_MIFARE, cardSearchTicks);
+            strcpy(OldCardString, NewCardString);
+            reportCard(NewCardString, &event);
+        }
+    }
+}
+
+/**
+ * Park the ISO14443A card found by SearchTag
+ * 
+ * The next polls check the presence of this card only. A card with the ISO14443-4 bit in its SAK
+ * is checked with ISO14443_4_CheckPresence, the other cards (MIFARE Classic, Ultralight, ...)
+ * with a selection of their UID (wake-up and select, no search over all tag types).
+ * With MULTICARD, the anticollision leaves the ISO14443-4 layer, the UID selection is used
+ * (except for a phone, not listed by the anticollision).
+ * 
+ * @param phone : the card is a phone, its presence restarts the card timer
+*/
+void parkCard(bool phone) {
+    byte SAK = 0;
+    int UIDLength = cardIDLength(IDBitCnt);
+
+    if (!PRESENCECHECK || TagType != HFTAG_MIFARE || UIDLength > CARDPRESENCE_UIDLENGTH) {
+        parkedCard.Parked = false;
+        return;
+    }
+
+    parkedCard.ISO4 = (!MULTICARD || phone) && ISO14443A_GetSAK(&SAK) && (SAK & 0x20) != 0;
+    parkedCard.Phone = phone;
+    memcpy(parkedCard.UID, ID, UIDLength);
+    parkedCard.UIDLength = UIDLength;
+    parkedCard.SearchTicks = GetSysTicks();
+    parkedCard.Parked = true;
+}
+
+/**
+ * Check the presence of the parked card
+ * 
+ * Restart the timeout of the card if it is still in the field. Return false to do a full
+ * search : no parked card, BLE session, card removed or PRESENCE_RESCAN elapsed.
+ * 
+ * @return true if the parked card is present, else false
+*/
+bool checkParkedCard(void) {
+    if (!parkedCard.Parked || BLEDeviceConnected) {
+        return false;
+    }
+
+    if ((uint32_t)(GetSysTicks() - parkedCard.SearchTicks) >= PRESENCE_RESCAN) {
+        parkedCard.Parked = false;
+        return false;
+    }
+
+    bool present = parkedCard.ISO4 ? ISO14443_4_CheckPresence() : ISO14443A_SelectTag(parkedCard.UID, parkedCard.UIDLength);
+
+    if (!present) {
+        parkedCard.Parked = false;
+        cardScanStats.PresenceLost++;
+        return false;
+    }
+
+    cardScanStats.PresenceChecks++;
+
+    if (MULTICARD && !parkedCard.Phone) {
+        cardPresenceRefresh(parkedCard.UID, parkedCard.UIDLength, GetSysTicks());
+    } else {
+        StartTimer(cardTimeout);
+    }
+    return true;
+}
+
+/**
+ * Search a card
+ * 
+ * SearchTag with the tag types chosen by the schedule (tag_schedule.c), the result
+ * updates the ranking of the technologies
+ * 
+ * @return true if a card is found, else false
+*/
+bool searchCard(void) {
+    cardSearchTicks = GetSysTicks();
+
+    tagScheduleNext(cardSearchTicks);
+
+    bool found = SearchTag(&TagType,&IDBitCnt,ID,sizeof(ID));
+
+    uint32_t ticks = GetSysTicks();
+
+    tagScheduleResult(found ? TagType : NOTAG, cardSearchTicks, ticks);
+    if (LOWPOWER) {
+        lpcdSearchResult(found, ticks);
+    }
+    return found;
+}
+
+/**
+ * Send an APDU to the selected ISO14443-4 card
+ * 
+ * @param APDU : pointer to the command, replaced by the response
+ * @param length : length of the command
+ * @param responseLength : pointer to the length of the response without the status word
+ * @param maxLength : size of the APDU buffer
+ * 
+ * @return true if the status word is 90 00, else false
+*/
+bool transceiveAPDU(byte* APDU, int length, int* responseLength, int maxLength) {
+    bool exchanged = ISO14443_4_TDX(APDU, length, responseLength, maxLength);
+
+    serviceOSDP();      // Multi-APDU reads : the OSDP polls are answered between the exchanges
+    if (!exchanged || *responseLength < 2) {
+        return false;
+    }
+    *responseLength -= 2;
+    return APDU[*responseLength] == 0x90 && APDU[*responseLength + 1] == 0x00;
+}
+
+/**
+ * Read the identification token from the NDEF message of a type 4 tag
+ * 
+ * The NDEF file is read by chunks of NDEFTOKEN_CHUNK bytes and parsed while it is received
+ * (ndef_stream.c) : only the payload of the token record is kept, the reading stops at the
+ * end of this record. The RAM used does not depend on the size of the message.
+ * 
+ * @param UserString : pointer to the user ID (17 bytes), filled if the token is valid
+ * 
+ * @return NFCTOKEN_NONE (no NDEF token), NFCTOKEN_VALID or NFCTOKEN_INVALID
+*/
+int readNDEFToken(char* UserString) {
+    byte APDU[NDEFTOKEN_CHUNK + 2];
+    int responseLength = 0;
+
+    // NDEF application, capability container : NDEF file ID and maximum READ BINARY length
+    memcpy(APDU, NDEFSelectAPDU, sizeof(NDEFSelectAPDU));
+    if (!transceiveAPDU(APDU, sizeof(NDEFSelectAPDU), &responseLength, sizeof(APDU))) {
+        return NFCTOKEN_NONE;
+    }
+    memcpy(APDU, NDEFSelectCCAPDU, sizeof(NDEFSelectCCAPDU));
+    if (!transceiveAPDU(APDU, sizeof(NDEFSelectCCAPDU), &responseLength, sizeof(APDU))) {
+        return NFCTOKEN_NONE;
+    }
+    byte readCC[] = {0x00, 0xb0, 0x00, 0x00, 0x0f};
+    memcpy(APDU, readCC, sizeof(readCC));
+    if (!transceiveAPDU(APDU, sizeof(readCC), &responseLength, sizeof(APDU)) || responseLength < 15 || APDU[7] != 0x04) {
+        return NFCTOKEN_NONE;
+    }
+    int maxRead = MIN((APDU[3] << 8) | APDU[4], NDEFTOKEN_CHUNK);
+    byte selectFile[] = {0x00, 0xa4, 0x00, 0x0c, 0x02, APDU[9], APDU[10]};
+
+    memcpy(APDU, selectFile, sizeof(selectFile));
+    if (maxRead <= 0 || !transceiveAPDU(APDU, sizeof(selectFile), &responseLength, sizeof(APDU))) {
+        return NFCTOKEN_NONE;
+    }
+
+    // NDEF file : NLEN (2 bytes) + message
+    TNDEFStream stream;
+    TNDEFStreamPayload payload;
+    int messageLength = 0;
+    bool tokenRecord = false;
+
+    ndefStreamInit(&stream);
+
+    for (int offset = 0; offset < messageLength + 2; offset += responseLength) {
+        int readLength = (offset == 0) ? 2 : MIN(maxRead, messageLength + 2 - offset);
+        byte readBinary[] = {0x00, 0xb0, (byte)(offset >> 8), (byte)offset, (byte)readLength};
+
+        memcpy(APDU, readBinary, sizeof(readBinary));
+        if (!transceiveAPDU(APDU, sizeof(readBinary), &responseLength, sizeof(APDU)) || responseLength == 0) {
+            return NFCTOKEN_NONE;
+        }
+
+        if (offset == 0) {
+            messageLength = (responseLength < 2) ? 0 : (APDU[0] << 8) | APDU[1];
+            continue;
+        }
+
+        int position = 0;
+        int event;
+
+        while ((event = ndefStreamNext(&stream, APDU, responseLength, &position, &payload)) > 0) {
+            if (event == NDEFSTREAM_RECORD) {
+                tokenRecord = stream.TNF == 0x04 && stream.TypeLength == strlen(NDEFTOKEN_TYPE) &&
+                              memcmp(stream.Type, NDEFTOKEN_TYPE, strlen(NDEFTOKEN_TYPE)) == 0;
+            } else if (event == NDEFSTREAM_PAYLOAD && tokenRecord && payload.Offset + payload.Length <= LENGTH_192_BYTES) {
+                memcpy(&NFCToken[payload.Offset], payload.Data, payload.Length);
+            } else if (event == NDEFSTREAM_RECORDEND && tokenRecord) {
+                // Token record complete : the rest of the message is not read
+                if (stream.PayloadLength != LENGTH_192_BYTES || !verifySignedToken(NFCToken, NFCMessage) ||
+                    !identifyMessage(NFCMessage, UserString)) {
+                    return NFCTOKEN_INVALID;
+                }
+                recordIdentification(&NFCIdentificationStats, cardSearchTicks);
+                return NFCTOKEN_VALID;
+            } else if (event == NDEFSTREAM_MESSAGEEND) {
+                return NFCTOKEN_NONE;
+            }
+        }
+        if (event == NDEFSTREAM_ERROR) {
+            return NFCTOKEN_NONE;
+        }
+    }
+    return NFCTOKEN_NONE;
+}
+
+/**
+ * Read the identification token of a phone
+ * 
+ * The phone emulates an ISO14443-4 card (host card emulation). The reader selects the application,
+ * the phone answers with a one-time challenge of the middleware. The reader proves its key (the
+ * encrypted challenge, as ST_DeviceAuthentication), the phone compares it with the response given
+ * by the middleware and only then answers with its signed token (192 hex characters, as its BLE
+ * write), verified like ST_SignatureVerification and ST_Identification. The result is confirmed to
+ * the phone, which removes the token only then (a torn transaction keeps it). A card without the
+ * application is handled as a card.
+ * 
+ * @param UserString : pointer to the user ID (17 bytes), filled if the token is valid
+ * 
+ * @return NFCTOKEN_NONE, NFCTOKEN_VALID or NFCTOKEN_INVALID
+*/
+int readNFCToken(char* UserString) {
+    byte SAK = 0;
+    byte APDU[LENGTH_192_BYTES + 2];
+    int responseLength = 0;
+
+    if (!NFCTOKENS || TagType != HFTAG_MIFARE || !ISO14443A_GetSAK(&SAK) || (SAK & 0x20) == 0) {
+        return NFCTOKEN_NONE;
+    }
+
+    memcpy(APDU, NFCTokenSelectAPDU, sizeof(NFCTokenSelectAPDU));
+    if (!ISO14443_4_TDX(APDU, sizeof(NFCTokenSelectAPDU), &responseLength, sizeof(APDU)) || responseLength < 2) {
+        return NFCTOKEN_NONE;
+    }
+
+    byte SW1 = APDU[responseLength - 2];
+    byte SW2 = APDU[responseLength - 1];
+
+    if ((SW1 == 0x6a && SW2 == 0x88) || (SW1 == 0x69 && SW2 == 0x85)) {
+        return NFCTOKEN_INVALID;    // Application without valid token or without challenge
+    }
+    if (SW1 != 0x90 || SW2 != 0x00) {
+        return NDEFTOKENS ? readNDEFToken(UserString) : NFCTOKEN_NONE;      // Application not selected (6A 82, ...)
+    }
+    if (responseLength != LENGTH_16_BYTES + 2) {
+        return NFCTOKEN_INVALID;
+    }
+
+    // Reader authentication : challenge encrypted with the key of the BLE device authentication
+    byte challenge[LENGTH_16_BYTES];
+
+    memcpy(challenge, APDU, sizeof(challenge));
+    memcpy(APDU, NFCTokenAuthenticateAPDU, sizeof(NFCTokenAuthenticateAPDU));
+    Encrypt(CRYPTO_ENV0, challenge, &APDU[sizeof(NFCTokenAuthenticateAPDU)], LENGTH_16_BYTES);
+    CBC_ResetInitVector(CRYPTO_ENV0);
+    APDU[sizeof(NFCTokenAuthenticateAPDU) + LENGTH_16_BYTES] = 0x00;
+
+    if (!transceiveAPDU(APDU, sizeof(NFCTokenAuthenticateAPDU) + LENGTH_16_BYTES + 1, &responseLength, sizeof(APDU)) ||
+        responseLength != LENGTH_192_BYTES) {
+        return NFCTOKEN_INVALID;
+    }
+    memcpy(NFCToken, APDU, LENGTH_192_BYTES);
+
+    bool valid = verifySignedToken(NFCToken, NFCMessage) && identifyMessage(NFCMessage, UserString);
+
+    memcpy(APDU, NFCTokenConfirmAPDU, sizeof(NFCTokenConfirmAPDU));
+    APDU[2] = valid ? 0x00 : 0x01;
+    transceiveAPDU(APDU, sizeof(NFCTokenConfirmAPDU), &responseLength, sizeof(APDU));  // Lost confirmation : the phone sends the token again, rejected by the replay cache
+
+    if (!valid) {
+        return NFCTOKEN_INVALID;
+    }
+
+    recordIdentification(&NFCIdentificationStats, cardSearchTicks);
+    return NFCTOKEN_VALID;
+}
+
+/**
+ * Scanning for a card
+ * 
+ * Search a card, read his value and print his value. During a BLE session the card is queued
+ * (see reportCard) and the card timeout is not started, the timer belongs to the session.
+ * The card already on the reader is recognized by its raw ID, it is not converted again
+*/
+void scanCard(void) {
+	    if (!BLEDeviceConnected)
+	    {
+	        deliverQueuedCards();
+	    }
+
+	    if (WIEGANDINPUT)
+	    {
+	        scanWiegandInput();
+	    }
+
+	    if (checkParkedCard())
+	    {
+	        // Card resting on the reader, already reported
+	    }
+	    else if (searchCard())
+	    {
+			cardScanStats.Polls++;
+
+			uint32_t hash = cardIDHash(TagType,IDBitCnt,ID);
+			char UserString[LENGTH_16_BYTES + 1];
+			int NFCResult = NFCTOKEN_NONE;
+
+			if (OldCardPhone && isOldCard(TagType,IDBitCnt,ID,hash))
+			{
+				// Same phone still on the reader, token already read
+				cardScanStats.SameCard++;
+				if (!BLEDeviceConnected)
+				{
+					StartTimer(cardTimeout);
+				}
+			}
+			else if ((NFCResult = readNFCToken(UserString)) != NFCTOKEN_NONE)
+			{
+				// Phone with the application : user of the token instead of the UID
+				rememberCard(hash,true);
+
+				if (NFCResult == NFCTOKEN_VALID)
+				{
+					TIDFrameEvent event;
+
+					identificationEvent(&event,IDFRAME_SOURCE_NFC,TagType,cardSearchTicks);
+					strcpy(OldCardString,UserString);
+					reportCard(UserString,&event);
+				}
+				else
+				{
+					BeepLow();
+				}
+				if (!BLEDeviceConnected)
+				{
+					StartTimer(cardTimeout);
+				}
+			}
+			else if (MULTICARD && TagType == HFTAG_MIFARE)
+			{
+				// Every card of the field, followed by the presence table
+				scanMultiCard();
+			}
+			else if (isOldCard(TagType,IDBitCnt,ID,hash))
+			{
+				// Same card still on the reader, already reported : no conversion
+				// (one card per SearchTag : without MULTICARD, or not an ISO14443A card)
+				cardScanStats.SameCard++;
+				if (!BLEDeviceConnected)
+				{
+					StartTimer(cardTimeout);
+				}
+			}
+			else
+			{
+				// A transponder was found. Read data from transponder and convert
+				// it into an ASCII string according to configuration
+				char NewCardString[MAXCARDSTRINGLEN+1];
+
+				if (ReadCardData(TagType,ID,IDBitCnt,NewCardString,sizeof(NewCardString)-1))
+				{
+					cardScanStats.NewCards++;
+
+					rememberCard(hash,false);
+
+					// Control if new card
+					if (strcmp(NewCardString,OldCardString) != 0)
+					{
+						TIDFrameEvent event;
+
+						identificationEvent(&event,IDFRAME_SOURCE_CARD,TagType,cardSearchTicks);
+						strcpy(OldCardString,NewCardString);
+						reportCard(NewCardString,&event);
+					}
+					// (Re-)start timeout
+					if (!BLEDeviceConnected)
+					{
+						StartTimer(cardTimeout);
+					}
+				}
+			}
+
+			// Check only the presence of a reported card until it leaves
+			// (with MULTICARD, a card in the presence table : read and reported)
+			if ((MULTICARD && TagType == HFTAG_MIFARE && cardPresenceRefresh(ID,cardIDLength(IDBitCnt),GetSysTicks())) ||
+			    isOldCard(TagType,IDBitCnt,ID,hash))
+			{
+				parkCard(OldCardPhone && isOldCard(TagType,IDBitCnt,ID,hash));
+			}
+			OnCardDone();
+	    }
+
+	    // Timeout of the cards listed by the anticollision, when the last one has left the field
+	    if (MULTICARD && cardPresenceStats.Present > 0 && cardPresenceExpire(GetSysTicks(), cardTimeout) == 0)
+	    {
+	        OnCardTimeout(OldCardString);
+	        OldCardString[0] = 0;
+	    }
+}
+
+/**
+ * Verify timeout
+ * 
+ * Control if the timer is used for the BLE or for a card
+*/
+void verifyTimeout(void) {
+    // 
+    if (TestTimer())
+    {
+        // Control if timer used for card or BLE
+        if(BLEDeviceConnected) {
+            currentState = ST_AuthenticationFailed;
+        } else {
+            OnCardTimeout(OldCardString);
+            OldCardString[0] = 0;
+            OldCardPresent = false;
+            parkedCard.Parked = false;
+        }
+    }
+}
+
+/**
+ *
+ * Choose the state machine state
+ * 
+*/
+void chooseSMstate(void) {
+    if(BLEDeviceConnected) {
+        enum States state = currentState;
+        uint32_t startTicks = GetSysTicks();
+
+        switch(currentState) {
+
+            // -------------------------------------------------------------------------------------
+            // Start the device authentication
+            //
+            // Called when a device is connected and write a random number in a charachteristic
+            // Encrypt the data if correct length and send them to the device via a notification 
+            // -------------------------------------------------------------------------------------
+            case ST_DeviceAuthentication:
+                //HostWriteString("DeviceAuthentication");
+                //HostWriteString("\r");
+
+                Encrypt(CRYPTO_ENV0, transformedReceivedDataBLE16, encryptedData, sizeof(encryptedData));
+                CBC_ResetInitVector(CRYPTO_ENV0);
+
+                BLESetGattServerAttributeValue(attrHandle, 0, encryptedData, sizeof(encryptedData));       // Write the encrypt data in the attribute and send a notification to the device
+
+                currentState = ST_WaitDeviceAuthenticated;
+                
+            break;
+
+            // -------------------------------------------------------------------------------------
+            // App being authenticated
+            //
+            // Called when the device has been authenticated
+            // Send a random number to the device via a notification 
+            // -------------------------------------------------------------------------------------
+            case ST_AppAuthentication:
+                //HostWriteString("AppAuthentication");
+                //HostWriteString("\r");
+
+                // Write the prepared challenge in the attribute and send a notification to the device
+                if (!SESSIONPREPARE) {
+                    generateRandNum(sessionValues.Challenge);
+                }
+                BLESetGattServerAttributeValue(attrHandle, 0, sessionValues.Challenge, sizeof(sessionValues.Challenge));
+
+                currentState = ST_WaitAppAuthentication;
+
+                break;
+
+            // -------------------------------------------------------------------------------------
+            // App authenticated
+            //
+            // Called when the app has return the encrypt random number
+            // Compare the received data to the expected response (challenge encrypted while idle)
+            // -------------------------------------------------------------------------------------
+            case ST_AppAuthenticated:
+                //HostWriteString("AppAuthenticated");
+                //HostWriteString("\r");
+
+                // Compare the received encrypt data with the encrypted challenge
+                if (!SESSIONPREPARE) {
+                    encryptChallenge();
+                    generateRandNum(sessionValues.AuthenticatedValue);
+                }
+                if (memcmp(&transformedReceivedDataBLE16, sessionValues.ExpectedResponse, sizeof(sessionValues.ExpectedResponse)) == 0) {    
+                
+                    // Write a random number in the attribute and send a notification to the device
+                    // to sigifie the the success of the authentication procedure
+                    BLESetGattServerAttributeValue(attrHandle, 0, sessionValues.AuthenticatedValue, sizeof(sessionValues.AuthenticatedValue));
+
+                    receivedDataLength64 = true;
+
+                    currentState = ST_WaitIdentification;
+                } else {
+                    currentState = ST_AuthenticationFailed;
+                }
 
                 break;
 
@@ -524,46 +1643,23 @@ void chooseSMstate(void) {
                 //HostWriteString("Identification");
                 //HostWriteString("\r");
 
-                //Get user ID from the signed message
-                byte userID[16];
-                memcpy(userID, receivedDataBLE64, 16);
-
-                // Need to read the curent and eypiration time in the format 0x11, 0x22, ... instead of 0x1, 0x1, 0x2, 0x2, ...
-                transformByteArray(&receivedDataBLE64, sizeof(receivedDataBLE64), &transformedReceivedDataBLE32);
-
-                // Get current time from the signed message (bytes 8 to 15)
-                byte messageCurrentTime[8];
-                getBytes(&transformedReceivedDataBLE32, 8, 15, &messageCurrentTime);
+                char userString[LENGTH_16_BYTES + 1];
 
-                // Get expiration time from the signed message (bytes 16 to 23)
-                byte messageExpirationTime[8];
-                getBytes(&transformedReceivedDataBLE32, 16, 23, &messageExpirationTime);
+                if(identifyMessage(receivedDataBLE64, userString)) {
 
-                // The message's expiration time must be in the future compare to the message's current time 
-                // and the reader's current time else signed message is not valid
-                if(byteArrayToUint64_t(messageExpirationTime, sizeof(messageExpirationTime)) >= byteArrayToUint64_t(messageCurrentTime, sizeof(messageCurrentTime)) && 
-                    byteArrayToUint64_t(messageExpirationTime, sizeof(messageExpirationTime)) >= readerCurrentTime) {
+                    // Write userID
+                    TIDFrameEvent event;
 
-                    // If the reader's current time is in the past compare to the message's current time,
-                    // the time from the reader is updated.
-                    if(messageCurrentTime > readerCurrentTime) {
-                        readerCurrentTime = messageCurrentTime;
-                    }
+                    identificationEvent(&event, IDFRAME_SOURCE_BLE, 0, sessionStartTicks);
+                    outputID(userString, &event);
 
-                    // Write userID
-                    for (int i = 0; i < 16; i++)
-                    {
-                        // Didn't write padding bytes
-                        if(userID[i] != '0'){
-                            HostWriteChar(userID[i]);
-                        }
-                        
-                    }
-                    HostWriteString("\r");
+                    recordIdentification(&BLEIdentificationStats, sessionStartTicks);
 
                     // Write a random number in the attribute to signify the succeed of the authentication procedure
-                    generateRandNum(&randNum);
-                    BLESetGattServerAttributeValue(attrHandle, 0, &randNum, sizeof(randNum));
+                    if (!SESSIONPREPARE) {
+                        generateRandNum(sessionValues.IdentifiedValue);
+                    }
+                    BLESetGattServerAttributeValue(attrHandle, 0, sessionValues.IdentifiedValue, sizeof(sessionValues.IdentifiedValue));
 
                     receivedDataLength64 = false;
 
@@ -575,6 +1671,44 @@ void chooseSMstate(void) {
             }
                 
 
+            // -------------------------------------------------------------------------------------
+            // Credential verification
+            //
+            // Called when the app has sent a pre-issued credential as first data
+            // Verify the MAC, then the credential is handled as a signed message (identification)
+            // -------------------------------------------------------------------------------------
+            case ST_CredentialVerification:
+                //HostWriteString("CredentialVerification");
+                //HostWriteString("\r");
+
+                transformByteArray(receivedDataBLE64, sizeof(receivedDataBLE64), transformedReceivedDataBLE32);
+
+                if (verifyCredential(transformedReceivedDataBLE32)) {
+                    currentState = ST_Identification;
+                } else {
+                    currentState = ST_AuthenticationFailed;
+                }
+                break;
+
+            // -------------------------------------------------------------------------------------
+            // Signature verification
+            //
+            // Called when the app has sent a signed token as first data
+            // Verify the signature of the message, then the message is handled as a signed message (identification)
+            // -------------------------------------------------------------------------------------
+            case ST_SignatureVerification:
+            {
+                //HostWriteString("SignatureVerification");
+                //HostWriteString("\r");
+
+                if (verifySignedToken(receivedDataBLE192, receivedDataBLE64)) {
+                    currentState = ST_Identification;
+                } else {
+                    currentState = ST_AuthenticationFailed;
+                }
+                break;
+            }
+
             // -------------------------------------------------------------------------------------
             // Authentification failed
             //
@@ -587,8 +1721,8 @@ void chooseSMstate(void) {
                 
                 // Write a dumb value in the attribute to overwrite the data in the characteristic
                 attrHandle -= (int)(0b1000000000000000);     // bit 15 of the attribute handle to 0 -> write without notification 
-                generateRandNum(&randNum);
-                BLESetGattServerAttributeValue(attrHandle, 0, &randNum, sizeof(randNum));
+                generateRandNum(randNum);
+                BLESetGattServerAttributeValue(attrHandle, 0, randNum, sizeof(randNum));
 
                 BLEDisconnectFromDevice();
                 deviceDisconnected();       // Call callback (normally called by the BLECheckEvent)
@@ -600,6 +1734,12 @@ void chooseSMstate(void) {
             default:
                 break;
         }
+
+        // Think time of the state, only when the state has done its work
+        if (currentState != state) {
+            thinkTimeStats.Ticks[state] += GetSysTicks() - startTicks;
+            thinkTimeStats.Steps[state]++;
+        }
     }
 }
 
@@ -616,12 +1756,17 @@ void chooseSMstateAttributeChanged(bool dataReceived) {
         // Wait authentication response
         //
         // Called when the app has return device authentication confirmation (write a random number in the attribute)
+        // or has written a pre-issued credential
         // -------------------------------------------------------------------------------------
         case ST_WaitAppRandNum:
             //HostWriteString("WaitAuthentication");
             //HostWriteString("\r");
 
-            if(dataReceived){
+            if(dataReceived && credentialReceived){
+                currentState = ST_CredentialVerification;
+            } else if(dataReceived && signedTokenReceived){
+                currentState = ST_SignatureVerification;
+            } else if(dataReceived){
                 currentState = ST_DeviceAuthentication;
             } else {
                 currentState = ST_AuthenticationFailed;
@@ -632,13 +1777,19 @@ void chooseSMstateAttributeChanged(bool dataReceived) {
         // -------------------------------------------------------------------------------------
         // Device authenticated
         //
-        // Called when the device is authenticated
+        // Called when the device is authenticated (write a random number in the attribute)
+        // or when the app has checked the reader with a challenge of the middleware and writes
+        // its pre-issued credential (the app never sends it to a reader not authenticated)
         // -------------------------------------------------------------------------------------
         case ST_WaitDeviceAuthenticated:
             //HostWriteString("DeviceAuthenticated");
             //HostWriteString("\r");
 
-            if(dataReceived){
+            if(dataReceived && credentialReceived){
+                currentState = ST_CredentialVerification;
+            } else if(dataReceived && signedTokenReceived){
+                currentState = ST_SignatureVerification;
+            } else if(dataReceived){
                 currentState = ST_AppAuthentication;
             } else {
                 currentState = ST_AuthenticationFailed;
@@ -724,10 +1875,25 @@ void checkBLEEvent(void) {
 
             //Read the modified 32 or 64 bytes value based on the read attribute handle
             if(receivedDataLength64) {
-                dataReceived = BLEGetGattServerAttributeValue(attrHandle, &receivedDataBLE64, &receivedDataBLELength, sizeof(receivedDataBLE64));
+                dataReceived = BLEGetGattServerAttributeValue(attrHandle, receivedDataBLE64, &receivedDataBLELength, sizeof(receivedDataBLE64));
+            } else if((OFFLINECREDENTIALS || SIGNEDTOKENS) && (currentState == ST_WaitAppRandNum || currentState == ST_WaitDeviceAuthenticated)) {
+                // First data of the session or data after the device authentication :
+                // 32 bytes random number, 64 bytes pre-issued credential or 192 bytes signed token
+                dataReceived = BLEGetGattServerAttributeValue(attrHandle, receivedDataBLE192, &receivedDataBLELength, sizeof(receivedDataBLE192));
+
+                if(SIGNEDTOKENS && receivedDataBLELength == LENGTH_192_BYTES) {
+                    signedTokenReceived = true;
+                } else if(OFFLINECREDENTIALS && receivedDataBLELength == LENGTH_64_BYTES) {
+                    memcpy(receivedDataBLE64, receivedDataBLE192, sizeof(receivedDataBLE64));
+                    credentialReceived = true;
+                    receivedDataLength64 = true;
+                } else {
+                    memcpy(receivedDataBLE32, receivedDataBLE192, sizeof(receivedDataBLE32));
+                    transformByteArray(receivedDataBLE32, sizeof(receivedDataBLE32), transformedReceivedDataBLE16);
+                }
             } else {
-                dataReceived = BLEGetGattServerAttributeValue(attrHandle, &receivedDataBLE32, &receivedDataBLELength, sizeof(receivedDataBLE32));  
-                transformByteArray(&receivedDataBLE32, sizeof(receivedDataBLE32), &transformedReceivedDataBLE16);       // The data is transmit in the incorrect format. It as to be transformed.
+                dataReceived = BLEGetGattServerAttributeValue(attrHandle, receivedDataBLE32, &receivedDataBLELength, sizeof(receivedDataBLE32));  
+                transformByteArray(receivedDataBLE32, sizeof(receivedDataBLE32), transformedReceivedDataBLE16);       // The data is transmit in the incorrect format. It as to be transformed.
             }
 
             chooseSMstateAttributeChanged(dataReceived);    // Choose the correct next state machine state
@@ -739,18 +1905,566 @@ void checkBLEEvent(void) {
     }
 }
 
+//---------------------------------  HOST COMMANDS  ----------------------------------
+
+#if CMDSERVER
+
+// Statistics of the command CMD_GETSTATS (structure of the counters, little endian)
+enum StatsGroups {
+    STATS_BLEIDENTIFICATION,    // TIdentificationStats
+    STATS_NFCIDENTIFICATION,    // TIdentificationStats
+    STATS_CARDPRESENCE,         // TCardPresenceStats
+    STATS_CARDDATA,             // TCardDataStats
+    STATS_CARDQUEUE,            // TCardQueueStats
+    STATS_TAGSCHEDULE,          // TTagScheduleStats
+    STATS_REPLAYCACHE,          // TReplayCacheStats
+    STATS_LPCD,                 // TLPCDStats
+    STATS_HOSTOUTPUT,           // THostOutputStats, second param : channel of the fan-out (default 0)
+    STATS_CMDSERVER,            // TCmdServerStats
+    STATS_WIEGAND,              // TWiegandStats
+    STATS_WIEGANDINPUT,         // TWiegandInputStats
+    STATS_OSDP,                 // TOSDPReaderStats
+    STATS_CLOCK,                // TClockSyncStats
+    STATS_SIGNATURE,            // TSignatureStats
+    STATS_THINKTIME,            // TThinkTimeStats
+    STATS_CARDSCAN              // TCardScanStats
+};
+
+// Functions of the application API (CMDSERVER_API)
+enum Commands {
+    CMD_GETSTATS,               // Param : group (byte), response : counters of the group
+    CMD_GETHISTOGRAM,           // Param : 0 = BLE, 1 = NFC identification, response : LATENCY_BINS uint32_t
+    CMD_GETCLOCK,               // Response : current time (uint64_t, Unix seconds)
+    CMD_SETCLOCK,               // Param : current time (uint64_t, Unix seconds), set by hand (no drift measure)
+    CMD_GETTIMEOUTS,            // Response : card timeout, BLE timeout (uint32_t, milliseconds)
+    CMD_SETTIMEOUTS,            // Param : card timeout, BLE timeout (uint32_t, milliseconds)
+    CMD_GETBLEPARAMS,           // Response : connect timeout (uint32_t), power (byte), advertisement interval (uint16_t), channel map (byte)
+    CMD_SETBLEPARAMS,           // Param : as CMD_GETBLEPARAMS, applied when no device is connected
+    CMD_FLUSHOUTPUT,            // Param : 0 = send, 1 = discard the pending output, response : bytes still pending (uint32_t)
+    CMD_SYNCCLOCK               // Param : current time (uint64_t, Unix milliseconds), response : correction (int32_t, ms), drift (int32_t, ppb)
+};
+
+#define BLEPARAMS_LENGTH        8       // Connect timeout, power, advertisement interval, channel map
+
+/**
+ * Host command : get the counters of a group
+ * 
+ * @param params : group (StatsGroups), channel for STATS_HOSTOUTPUT
+ * @param length : length of the parameters
+ * @param response : pointer to the counters
+ * @param responseLength : length of the counters
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandGetStats(const byte* params, int length, byte* response, int* responseLength) {
+    // Counters filled aligned, the response is not
+    union {
+        TIdentificationStats identification;
+        TCardPresenceStats presence;
+        TCardDataStats data;
+        TCardQueueStats queue;
+        TTagScheduleStats schedule;
+        TReplayCacheStats replay;
+        TLPCDStats lpcd;
+        THostOutputStats output;
+        TCmdServerStats server;
+        TWiegandStats wiegand;
+        TWiegandInputStats wiegandInput;
+#if OSDP
+        TOSDPReaderStats osdp;
+#endif
+        TClockSyncStats clock;
+        TSignatureStats signature;
+        TThinkTimeStats thinkTime;
+        TCardScanStats scan;
+    } stats;
+    int size;
+
+    if (length != 1 && !(length == 2 && params[0] == STATS_HOSTOUTPUT)) {
+        return ERR_LENGTH;
+    }
+
+    switch (params[0]) {
+        case STATS_BLEIDENTIFICATION:
+            stats.identification = BLEIdentificationStats;
+            size = sizeof(stats.identification);
+            break;
+        case STATS_NFCIDENTIFICATION:
+            stats.identification = NFCIdentificationStats;
+            size = sizeof(stats.identification);
+            break;
+        case STATS_CARDPRESENCE:
+            cardPresenceGetStats(&stats.presence);
+            size = sizeof(stats.presence);
+            break;
+        case STATS_CARDDATA:
+            cardDataGetStats(&stats.data);
+            size = sizeof(stats.data);
+            break;
+        case STATS_CARDQUEUE:
+            cardQueueGetStats(&stats.queue);
+            size = sizeof(stats.queue);
+            break;
+        case STATS_TAGSCHEDULE:
+            tagScheduleGetStats(&stats.schedule);
+            size = sizeof(stats.schedule);
+            break;
+        case STATS_REPLAYCACHE:
+            replayCacheGetStats(&stats.replay);
+            size = sizeof(stats.replay);
+            break;
+        case STATS_LPCD:
+            lpcdGetStats(&stats.lpcd);
+            size = sizeof(stats.lpcd);
+            break;
+        case STATS_HOSTOUTPUT:
+            if (!hostOutputGetStats((length == 2) ? params[1] : 0, &stats.output)) {
+                return ERR_INVALID_FUNCTION;
+            }
+            size = sizeof(stats.output);
+            break;
+        case STATS_CMDSERVER:
+            cmdServerGetStats(&stats.server);
+            size = sizeof(stats.server);
+            break;
+        case STATS_WIEGAND:
+            wiegandGetStats(&stats.wiegand);
+            size = sizeof(stats.wiegand);
+            break;
+        case STATS_WIEGANDINPUT:
+            wiegandInputGetStats(&stats.wiegandInput);
+            size = sizeof(stats.wiegandInput);
+            break;
+#if OSDP
+        case STATS_OSDP:
+            osdpReaderGetStats(&stats.osdp);
+            size = sizeof(stats.osdp);
+            break;
+#endif
+        case STATS_CLOCK:
+            clockSyncGetStats(&stats.clock);
+            size = sizeof(stats.clock);
+            break;
+        case STATS_SIGNATURE:
+            stats.signature = signatureStats;
+            size = sizeof(stats.signature);
+            break;
+        case STATS_THINKTIME:
+            stats.thinkTime = thinkTimeStats;
+            size = sizeof(stats.thinkTime);
+            break;
+        case STATS_CARDSCAN:
+            stats.scan = cardScanStats;
+            size = sizeof(stats.scan);
+            break;
+        default:
+            return ERR_INVALID_FUNCTION;
+    }
+
+    memcpy(response, &stats, size);
+    *responseLength = size;
+    return ERR_NONE;
+}
+
+/**
+ * Host command : get a latency histogram
+ * 
+ * @param params : 0 = BLE, 1 = NFC identification
+ * @param length : length of the parameters
+ * @param response : pointer to the bins
+ * @param responseLength : length of the bins
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandGetHistogram(const byte* params, int length, byte* response, int* responseLength) {
+    if (length != 1) {
+        return ERR_LENGTH;
+    }
+    if (params[0] > 1) {
+        return ERR_INVALID_FUNCTION;
+    }
+
+    TIdentificationStats* stats = (params[0] == 0) ? &BLEIdentificationStats : &NFCIdentificationStats;
+
+    memcpy(response, stats->Histogram, sizeof(stats->Histogram));
+    *responseLength = sizeof(stats->Histogram);
+    return ERR_NONE;
+}
+
+/**
+ * Host command : get the current time of the reader
+ * 
+ * @param params : none
+ * @param length : length of the parameters
+ * @param response : pointer to the time
+ * @param responseLength : length of the time
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandGetClock(const byte* params, int length, byte* response, int* responseLength) {
+    (void)params;
+
+    if (length != 0) {
+        return ERR_UNUSED_PARAMETERS;
+    }
+    updateTime();
+    memcpy(response, &readerCurrentTime, sizeof(readerCurrentTime));
+    *responseLength = sizeof(readerCurrentTime);
+    return ERR_NONE;
+}
+
+/**
+ * Host command : set the current time of the reader
+ * 
+ * @param params : time (Unix seconds)
+ * @param length : length of the parameters
+ * @param response : none
+ * @param responseLength : none
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandSetClock(const byte* params, int length, byte* response, int* responseLength) {
+    uint64_t time;
+
+    (void)response;
+    (void)responseLength;
+
+    if (length != sizeof(time)) {
+        return ERR_LENGTH;
+    }
+
+    memcpy(&time, params, sizeof(time));
+    clockSyncSet(time * 1000, false);
+    updateTime();
+    return ERR_NONE;
+}
+
+/**
+ * Host command : synchronize the clock
+ * 
+ * Sent periodically by the host, successive syncs give the drift of the system ticks
+ * 
+ * @param params : time of the host (Unix milliseconds)
+ * @param length : length of the parameters
+ * @param response : correction applied (milliseconds), drift estimation (ppb)
+ * @param responseLength : length of the response
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandSyncClock(const byte* params, int length, byte* response, int* responseLength) {
+    uint64_t time;
+    TClockSyncStats clockStats;
+
+    if (length != sizeof(time)) {
+        return ERR_LENGTH;
+    }
+
+    memcpy(&time, params, sizeof(time));
+    int32_t offset = clockSyncSet(time, true);
+    updateTime();
+    clockSyncGetStats(&clockStats);
+
+    memcpy(response, &offset, sizeof(offset));
+    memcpy(&response[sizeof(offset)], &clockStats.Drift, sizeof(clockStats.Drift));
+    *responseLength = sizeof(offset) + sizeof(clockStats.Drift);
+    return ERR_NONE;
+}
+
+/**
+ * Host command : get the timeouts
+ * 
+ * @param params : none
+ * @param length : length of the parameters
+ * @param response : card timeout, BLE timeout
+ * @param responseLength : length of the timeouts
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandGetTimeouts(const byte* params, int length, byte* response, int* responseLength) {
+    (void)params;
+
+    if (length != 0) {
+        return ERR_UNUSED_PARAMETERS;
+    }
+    memcpy(&response[0], &cardTimeout, sizeof(cardTimeout));
+    memcpy(&response[4], &BLETimeout, sizeof(BLETimeout));
+    *responseLength = 8;
+    return ERR_NONE;
+}
+
+/**
+ * Host command : set the timeouts, used by the next card and BLE session
+ * 
+ * @param params : card timeout, BLE timeout
+ * @param length : length of the parameters
+ * @param response : none
+ * @param responseLength : none
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandSetTimeouts(const byte* params, int length, byte* response, int* responseLength) {
+    uint32_t card;
+    uint32_t BLE;
+
+    (void)response;
+    (void)responseLength;
+
+    if (length != 8) {
+        return ERR_LENGTH;
+    }
+    memcpy(&card, &params[0], sizeof(card));
+    memcpy(&BLE, &params[4], sizeof(BLE));
+
+    if (card == 0 || BLE == 0) {
+        return ERR_INVALID_FUNCTION;
+    }
+    cardTimeout = card;
+    BLETimeout = BLE;
+    return ERR_NONE;
+}
+
+/**
+ * Host command : get the BLE parameters
+ * 
+ * @param params : none
+ * @param length : length of the parameters
+ * @param response : connect timeout, power, advertisement interval, channel map
+ * @param responseLength : length of the BLE parameters
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandGetBLEParams(const byte* params, int length, byte* response, int* responseLength) {
+    (void)params;
+
+    if (length != 0) {
+        return ERR_UNUSED_PARAMETERS;
+    }
+    memcpy(&response[0], &BLEConfig.ConnectTimeout, 4);
+    response[4] = BLEConfig.Power;
+    memcpy(&response[5], &BLEConfig.AdvInterval, 2);
+    response[7] = BLEConfig.ChannelMap;
+    *responseLength = BLEPARAMS_LENGTH;
+    return ERR_NONE;
+}
+
+/**
+ * Host command : set the BLE parameters
+ * 
+ * Applied by applyBLEConfig when no device is connected
+ * 
+ * @param params : connect timeout, power, advertisement interval, channel map
+ * @param length : length of the parameters
+ * @param response : none
+ * @param responseLength : none
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandSetBLEParams(const byte* params, int length, byte* response, int* responseLength) {
+    uint32_t connectTimeout;
+    uint16_t advInterval;
+
+    (void)response;
+    (void)responseLength;
+
+    if (length != BLEPARAMS_LENGTH) {
+        return ERR_LENGTH;
+    }
+    memcpy(&connectTimeout, &params[0], 4);
+    memcpy(&advInterval, &params[5], 2);
+
+    if (params[4] > 80 || advInterval < 20 || advInterval > 10240 || params[7] == 0 || params[7] > 0x07) {
+        return ERR_INVALID_FUNCTION;
+    }
+
+    BLEConfig.ConnectTimeout = connectTimeout;
+    BLEConfig.Power = params[4];
+    BLEConfig.AdvInterval = advInterval;
+    BLEConfig.ChannelMap = params[7];
+    BLEConfigChanged = true;
+    return ERR_NONE;
+}
+
+/**
+ * Host command : send or discard the pending output
+ * 
+ * Sending stops at the end of the poll budget, the host repeats the command
+ * until no byte is pending
+ * 
+ * @param params : 0 = send, 1 = discard
+ * @param length : length of the parameters
+ * @param response : bytes still pending
+ * @param responseLength : length of the response
+ * 
+ * @return ERR_NONE if succeed, else error code of the Simple Protocol
+*/
+int commandFlushOutput(const byte* params, int length, byte* response, int* responseLength) {
+    if (length != 1) {
+        return ERR_LENGTH;
+    }
+
+    if (params[0] != 0) {
+        hostOutputDiscard();
+    }
+
+    while (hostOutputPending() > 0 && cmdServerRemaining() > 0) {
+        hostOutputDrain();
+    }
+
+    uint32_t pending = hostOutputPending();
+
+    memcpy(response, &pending, sizeof(pending));
+    *responseLength = sizeof(pending);
+    return ERR_NONE;
+}
+
+const TCmdServerCommand hostCommands[] = {
+    {CMD_GETSTATS, commandGetStats},
+    {CMD_GETHISTOGRAM, commandGetHistogram},
+    {CMD_GETCLOCK, commandGetClock},
+    {CMD_SETCLOCK, commandSetClock},
+    {CMD_GETTIMEOUTS, commandGetTimeouts},
+    {CMD_SETTIMEOUTS, commandSetTimeouts},
+    {CMD_GETBLEPARAMS, commandGetBLEParams},
+    {CMD_SETBLEPARAMS, commandSetBLEParams},
+    {CMD_FLUSHOUTPUT, commandFlushOutput},
+    {CMD_SYNCCLOCK, commandSyncClock},
+};
+
+#endif
+
+/**
+ * Apply the BLE parameters changed by the host
+ * 
+ * Only when no device is connected : BLEInit restarts the advertisement
+ * 
+*/
+void applyBLEConfig(void) {
+    if (!BLEConfigChanged || BLEDeviceConnected) {
+        return;
+    }
+    BLEPresetConfig(&BLEConfig);
+    BLEInit(BLE_MODE_CUSTOM);
+    BLEConfigChanged = false;
+}
+
+/**
+ * Answer the OSDP polls
+ * 
+ * Called between the steps of the main loop and inside the long operations : between the
+ * APDU exchanges (NFC token, NDEF reads), the DESFire commands (CARDDATA_YIELD) and the
+ * comb columns of a signature verification (ED25519_YIELD). The gaps are measured by the
+ * OSDP reader (MaxGapTicks, LateServices of STATS_OSDP).
+*/
+void serviceOSDP(void) {
+#if OSDP
+    osdpReaderService();
+#endif
+}
+
+/**
+ * Check if the reader can sleep
+ * 
+ * Nothing to follow : no BLE session, no card in the field, no card queued or
+ * output pending (host, Wiegand), no Wiegand frame being received and the values
+ * of the next session prepared. A Wiegand frame arriving during the sleep is captured by
+ * the interrupts, but only reported after the wake-up (LPCD_SAFETYPOLL at most).
+ * An OSDP reader never sleeps, the controller polls it continuously.
+ * 
+ * @return true if idle, else false
+*/
+bool readerIdle(void) {
+    TCardPresenceStats presenceStats;
+    TCardQueueStats queueStats;
+
+    cardPresenceGetStats(&presenceStats);
+    cardQueueGetStats(&queueStats);
+
+    return !OSDP && !BLEDeviceConnected && !OldCardPresent && !parkedCard.Parked && presenceStats.Present == 0 &&
+           queueStats.Depth == 0 && hostOutputPending() == 0 && !wiegandBusy() && !wiegandInputBusy() &&
+           sessionValues.Ready;
+}
+
+/**
+ * Check the BLE events during a low power sleep : the BLE module can not wake the reader up
+ *
+ * @return true if a device is connected (sleep ended), else false
+*/
+bool lowPowerWakeUp(void) {
+    checkBLEEvent();
+    return BLEDeviceConnected;
+}
+
+/**
+ * Sleep while idle, woken up by the card detection and by the host channels
+ *
+*/
+void lowPowerSleep(void) {
+    int wakeMask = lpcdChannelMask(GetHostChannel());
+
+#if CMDSERVER
+    wakeMask |= lpcdChannelMask(CMDSERVER_CHANNEL);
+#endif
+    lpcdSleep(wakeMask);
+}
+
 
 int main(void)
 {
 	init();    	
+    clockSyncInit();
+#if OSDP
+    osdpReaderInit();           // The OSDP application owns the serial port of the bus
+#else
+    hostOutputInit();
+#endif
+    idFrameInit();
+    if (WIEGAND) {
+        wiegandInit(WIEGAND_DATA0, WIEGAND_DATA1);
+    }
+    if (WIEGANDINPUT) {
+        wiegandInputInit(WIEGANDINPUT_DATA0, WIEGANDINPUT_DATA1);
+    }
+    if (WIEGAND || WIEGANDINPUT) {
+        SetInterruptHandler(systemTick, INTNO_SYSTICK);
+    }
+    replayCacheInit();
+    calibrateCardFormat();
+    calibrateSession();
+    cardPresenceInit();
+    cardDataInit();
+    cardQueueInit();
+    tagScheduleInit(LFTAGTYPES, HFTAGTYPES, GetSysTicks());
+    if (LOWPOWER) {
+        lpcdInit(true);
+    }
+#if CMDSERVER
+    cmdServerInit(hostCommands, sizeof(hostCommands) / sizeof(hostCommands[0]));
+#endif
 
     while (true)
     {
         updateTime();
+        prepareSession();
+        serviceOSDP();
         verifyTimeout();
         scanCard();   
+        serviceOSDP();
         chooseSMstate();
         checkBLEEvent();
+        serviceOSDP();
+#if OSDP
+        osdpReaderTasks();
+#endif
+        hostOutputDrain();      // Host channels without transmit interrupt
+
+#if CMDSERVER
+        cmdServerPoll();
+        applyBLEConfig();
+#endif
+
+        if (LOWPOWER && readerIdle()) {
+            lowPowerSleep();
+        }
     }
 }
 
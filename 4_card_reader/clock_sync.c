@@ -0,0 +1,195 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CLOCK SYNC
+//
+// Keep the Unix time of the reader between the syncs of the host.
+//
+// - The time is kept as a base (Unix milliseconds at a system tick count),
+//   moved forward at every clockSyncNow by the elapsed ticks plus the drift
+//   correction. The fractions of millisecond of the correction are kept, a
+//   small drift is applied even when the loop is fast.
+// - A sync point (clockSyncSet) replaces the base by the time of the host. The
+//   drift is measured against the previous sync point : (host elapsed - ticks
+//   elapsed) / ticks elapsed, smoothed over CLOCKSYNC_SMOOTHING points. A
+//   measure beyond CLOCKSYNC_MAXDRIFT is a time change, not a drift.
+// - clockSyncAdvance only moves the time forward (time of a phone message
+//   before the first sync of the host), it is not a sync point. The first
+//   estimate replaces the default time, the next ones move it CLOCKSYNC_MAXADVANCE
+//   at most : a phone with a time in the future can not push the clock hours
+//   ahead and make the messages of the other users expire
+//
+// Memory : 72 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "clock_sync.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t clockSyncTime = CLOCKSYNC_DEFAULTTIME;     // Unix milliseconds at clockSyncTicks
+uint32_t clockSyncTicks = 0;            // System ticks of the base
+int64_t clockSyncRemainder = 0;         // Correction not applied yet (ppb x milliseconds)
+
+bool clockSyncPoint = false;            // Previous sync point kept for the drift
+uint64_t clockSyncPointTime = 0;        // Time of the host at the previous sync point
+uint32_t clockSyncPointTicks = 0;       // System ticks at the previous sync point
+uint32_t clockSyncLastTicks = 0;        // System ticks of the last sync
+bool clockSyncEstimated = false;        // Time estimated from a phone message (before the first sync)
+
+TClockSyncStats clockSyncStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the clock
+ *
+ * Default time, no drift correction
+ *
+*/
+void clockSyncInit(void)
+{
+    clockSyncTime = CLOCKSYNC_DEFAULTTIME;
+    clockSyncTicks = GetSysTicks();
+    clockSyncRemainder = 0;
+    clockSyncPoint = false;
+    clockSyncEstimated = false;
+    memset(&clockSyncStats, 0, sizeof(clockSyncStats));
+}
+
+/**
+ * Current time
+ *
+ * Move the base to the current system ticks
+ *
+ * @return Unix time in milliseconds
+*/
+uint64_t clockSyncNow(void)
+{
+    uint32_t ticks = GetSysTicks();
+    uint32_t elapsed = ticks - clockSyncTicks;
+
+    clockSyncRemainder += (int64_t)elapsed * clockSyncStats.Drift;
+
+    int64_t correction = clockSyncRemainder / CLOCKSYNC_PPB;
+
+    clockSyncRemainder -= correction * CLOCKSYNC_PPB;
+    clockSyncTime += (int64_t)elapsed + correction;
+    clockSyncTicks = ticks;
+    return clockSyncTime;
+}
+
+/**
+ * Sync point of the host
+ *
+ * @param time : time of the host in Unix milliseconds
+ * @param measure : true to update the drift (time in milliseconds), false for a time set by hand
+ *
+ * @return correction in milliseconds (host - reader)
+*/
+int32_t clockSyncSet(uint64_t time, bool measure)
+{
+    int64_t offset = (int64_t)(time - clockSyncNow());
+    uint32_t ticks = clockSyncTicks;
+    bool keepPoint = false;
+
+    if (measure && clockSyncPoint) {
+        uint32_t tickDelta = ticks - clockSyncPointTicks;
+        int64_t error = (int64_t)(time - clockSyncPointTime - tickDelta);       // Time elapsed for the host - ticks elapsed
+        int64_t maxError = (int64_t)tickDelta * CLOCKSYNC_MAXDRIFT / CLOCKSYNC_PPB;
+
+        if (tickDelta < CLOCKSYNC_MININTERVAL) {
+            keepPoint = true;       // The next sync measures over a longer interval
+        } else if (tickDelta <= CLOCKSYNC_MAXINTERVAL) {
+            // Beyond the largest drift : time changed by the host (ex. 1970 then NTP). Compared
+            // before the scaling to ppb, which overflows for a step of months
+            if (error > maxError || error < -maxError) {
+                clockSyncStats.Steps++;
+            } else {
+                int64_t drift = error * CLOCKSYNC_PPB / tickDelta;
+
+                if (clockSyncStats.DriftUpdates++ == 0) {
+                    clockSyncStats.Drift = drift;
+                } else {
+                    clockSyncStats.Drift += (drift - clockSyncStats.Drift) / CLOCKSYNC_SMOOTHING;
+                }
+            }
+        }
+    }
+
+    clockSyncTime = time;
+    clockSyncRemainder = 0;
+    clockSyncLastTicks = ticks;
+    if (!keepPoint) {
+        clockSyncPoint = measure;
+        clockSyncPointTime = time;
+        clockSyncPointTicks = ticks;
+    }
+
+    offset = MAX(MIN(offset, INT32_MAX), -INT32_MAX);
+    clockSyncStats.Syncs++;
+    clockSyncStats.Offset = offset;
+    clockSyncStats.MaxOffset = MAX(clockSyncStats.MaxOffset, (uint32_t)(offset < 0 ? -offset : offset));
+    return offset;
+}
+
+/**
+ * Move the time forward
+ *
+ * Time of a phone message, only used before the first sync of the host, limited to
+ * CLOCKSYNC_MAXADVANCE after the first estimate
+ *
+ * @param time : Unix time in milliseconds
+ *
+*/
+void clockSyncAdvance(uint64_t time)
+{
+    uint64_t now = clockSyncNow();
+
+    if (clockSyncStats.Syncs > 0 || time <= now) {
+        return;
+    }
+
+    if (clockSyncEstimated && time - now > CLOCKSYNC_MAXADVANCE) {
+        time = now + CLOCKSYNC_MAXADVANCE;
+        clockSyncStats.CappedAdvances++;
+    }
+    clockSyncTime = time;
+    clockSyncRemainder = 0;
+    clockSyncEstimated = true;
+    clockSyncStats.Advances++;
+}
+
+/**
+ * Check if the time comes from the host
+ *
+ * @return true if the host has set the time, else false
+*/
+bool clockSyncSynced(void)
+{
+    return clockSyncStats.Syncs > 0;
+}
+
+/**
+ * Check if the time is known (host sync or phone estimate)
+ *
+ * @return false while the default time is used, else true
+*/
+bool clockSyncKnown(void)
+{
+    return clockSyncStats.Syncs > 0 || clockSyncEstimated;
+}
+
+/**
+ * Get the clock counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void clockSyncGetStats(TClockSyncStats* stats)
+{
+    clockSyncNow();
+    *stats = clockSyncStats;
+    stats->SyncAgeTicks = clockSyncSynced() ? clockSyncTicks - clockSyncLastTicks : 0xffffffffUL;
+}
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  CLOCK SYNC
+//
+// Unix time of the reader in milliseconds, set by the host
+// - Sync points sent by the host (time-set command), repeated periodically
+// - Drift of the system ticks estimated from successive sync points and
+//   corrected continuously between them
+// - Before the first sync : default time, only moved forward (phone messages),
+//   CLOCKSYNC_MAXADVANCE at most per message once a first estimate is taken
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CLOCK_SYNC_H__
+#define __CLOCK_SYNC_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CLOCKSYNC_DEFAULTTIME
+  #define CLOCKSYNC_DEFAULTTIME     1690495200000ULL    // Time at start-up in Unix milliseconds (until a sync)
+#endif
+
+#ifndef CLOCKSYNC_MININTERVAL
+  #define CLOCKSYNC_MININTERVAL     60000UL     // Drift measured over 1 minute at least (shorter : offset only)
+#endif
+
+#ifndef CLOCKSYNC_MAXINTERVAL
+  #define CLOCKSYNC_MAXINTERVAL     0x7fffffffUL    // Drift not measured after 24 days (system ticks on 32 bits)
+#endif
+
+#ifndef CLOCKSYNC_MAXDRIFT
+  #define CLOCKSYNC_MAXDRIFT        500000L     // Largest drift accepted in ppb (500 ppm), beyond : time changed by the host
+#endif
+
+#ifndef CLOCKSYNC_MAXADVANCE
+  #define CLOCKSYNC_MAXADVANCE      600000UL    // Largest forward step of the time by a phone message in milliseconds (10 minutes)
+#endif
+
+#ifndef CLOCKSYNC_SMOOTHING
+  #define CLOCKSYNC_SMOOTHING       4           // Weight of a new drift measure : 1 / CLOCKSYNC_SMOOTHING
+#endif
+
+#define CLOCKSYNC_PPB               1000000000LL
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Counters reported by the clock
+typedef struct
+{
+    uint32_t Syncs;             // Sync points of the host
+    uint32_t DriftUpdates;      // Sync points used for the drift estimation
+    uint32_t Steps;             // Sync points too far from the estimation (time changed), drift not updated
+    int32_t Offset;             // Correction of the last sync in milliseconds (host - reader)
+    uint32_t MaxOffset;         // Largest correction in milliseconds (absolute value)
+    int32_t Drift;              // Drift estimation in ppb, added to the system ticks
+    uint32_t SyncAgeTicks;      // Time since the last sync in milliseconds (0xffffffff = never)
+    uint32_t Advances;          // Time moved forward by a phone message (before the first sync)
+    uint32_t CappedAdvances;    // Steps limited to CLOCKSYNC_MAXADVANCE
+} TClockSyncStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void clockSyncInit(void);
+uint64_t clockSyncNow(void);
+int32_t clockSyncSet(uint64_t time, bool measure);
+void clockSyncAdvance(uint64_t time);
+bool clockSyncSynced(void);
+bool clockSyncKnown(void);
+void clockSyncGetStats(TClockSyncStats* stats);
+
+#endif
@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 COMMAND SERVER
+//
+// Non-blocking Simple Protocol server for the commands of the host.
+//
+// - Message : API number, function number and parameters, response : error
+//   code and data (prs.h). Framing and CRC handled by the Simple Protocol
+//   library (PRS_COMM_MODE_BINARY | PRS_COMM_CRC_ON).
+// - SimpleProtoTestCommand called only when bytes are received, the commands
+//   are executed until CMDSERVER_BUDGET is elapsed, the next ones wait for
+//   the next loop
+// - A handler that can take long (flush) stops at cmdServerRemaining() == 0
+// - The system functions of the firmware are rejected (ERR_INVALID_FUNCTION)
+//   unless CMDSERVER_SYSTEMAPI : SearchTag or BLE calls from the host would
+//   change the state used by the main loop
+//
+// Memory : 32 bytes, + 41 KB of prs.o linked from libapp.a (SimpleProtoMessage
+// 17000 bytes, Array 24576 bytes) : included only when CMDSERVER is on
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "cmd_server.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+const TCmdServerCommand* cmdServerCommands = NULL;
+int cmdServerCount = 0;
+
+uint32_t cmdServerStartTicks = 0;           // System ticks of the start of the current poll
+
+TCmdServerStats cmdServerStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the command server
+ *
+ * @param commands : pointer to the table of the application commands
+ * @param count : number of commands in the table
+ *
+*/
+void cmdServerInit(const TCmdServerCommand* commands, int count)
+{
+    cmdServerCommands = commands;
+    cmdServerCount = count;
+    memset(&cmdServerStats, 0, sizeof(cmdServerStats));
+
+    SimpleProtoInit(CMDSERVER_CHANNEL, PRS_COMM_MODE_BINARY | PRS_COMM_CRC_ON);
+}
+
+/**
+ * Time left to the current poll
+ *
+ * @return milliseconds before the end of CMDSERVER_BUDGET, 0 if elapsed
+*/
+uint32_t cmdServerRemaining(void)
+{
+    uint32_t ticks = GetSysTicks() - cmdServerStartTicks;
+
+    return (ticks < CMDSERVER_BUDGET) ? CMDSERVER_BUDGET - ticks : 0;
+}
+
+/**
+ * Execute the command in SimpleProtoMessage, replaced by the response
+ *
+*/
+static void cmdServerExecute(void)
+{
+    if (SimpleProtoMessageLength < 2 || SimpleProtoMessage[0] != CMDSERVER_API) {
+        if (CMDSERVER_SYSTEMAPI) {
+            SimpleProtoExecuteCommand();
+        } else {
+            cmdServerStats.Rejected++;
+            SimpleProtoMessage[0] = ERR_INVALID_FUNCTION;
+            SimpleProtoMessageLength = 1;
+        }
+        return;
+    }
+
+    byte function = SimpleProtoMessage[1];
+    byte params[CMDSERVER_MAXPARAMS];
+    int length = SimpleProtoMessageLength - 2;
+    int responseLength = 0;
+    int error = ERR_UNKNOWN_FUNCTION;
+
+    if (length > (int)sizeof(params)) {
+        error = ERR_LENGTH;
+    } else {
+        // Parameters copied : the response is built in SimpleProtoMessage
+        memcpy(params, &SimpleProtoMessage[2], length);
+
+        for (int i = 0; i < cmdServerCount; i++) {
+            if (cmdServerCommands[i].Function == function) {
+                error = cmdServerCommands[i].Handler(params, length, &SimpleProtoMessage[1], &responseLength);
+                break;
+            }
+        }
+    }
+
+    if (error != ERR_NONE) {
+        cmdServerStats.Errors++;
+        responseLength = 0;
+    }
+    SimpleProtoMessage[0] = error;
+    SimpleProtoMessageLength = 1 + responseLength;
+}
+
+/**
+ * Serve the commands received, at most CMDSERVER_BUDGET milliseconds
+ *
+*/
+void cmdServerPoll(void)
+{
+    cmdServerStartTicks = GetSysTicks();
+
+    while (!TestEmpty(CMDSERVER_CHANNEL, DIR_IN) && cmdServerRemaining() > 0 && SimpleProtoTestCommand()) {
+        cmdServerExecute();
+        SimpleProtoSendResponse();
+        cmdServerStats.Commands++;
+    }
+
+    uint32_t ticks = GetSysTicks() - cmdServerStartTicks;
+
+    if (ticks > cmdServerStats.MaxTicks) {
+        cmdServerStats.MaxTicks = ticks;
+    }
+    if (ticks > CMDSERVER_BUDGET) {
+        cmdServerStats.OverBudget++;
+    }
+}
+
+/**
+ * Get the command server counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void cmdServerGetStats(TCmdServerStats* stats)
+{
+    *stats = cmdServerStats;
+}
@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 COMMAND SERVER
+//
+// Commands of the host with the Simple Protocol (prs.h), served by the main loop
+// - Binary mode with CRC
+// - Commands of the application API (CMDSERVER_API) dispatched to a table of handlers
+// - Never holds the main loop longer than CMDSERVER_BUDGET
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CMD_SERVER_H__
+#define __CMD_SERVER_H__
+
+#include "prs.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CMDSERVER_CHANNEL
+  #define CMDSERVER_CHANNEL         CHANNEL_COM2    // Maintenance port, not the channel of the card output
+#endif
+
+#ifndef CMDSERVER_BUDGET
+  #define CMDSERVER_BUDGET          5           // Longest time spent by cmdServerPoll in milliseconds
+#endif
+
+#ifndef CMDSERVER_API
+  #define CMDSERVER_API             0xf0        // API number of the application commands (not used by the system)
+#endif
+
+#ifndef CMDSERVER_SYSTEMAPI
+  #define CMDSERVER_SYSTEMAPI       0           // Execute the system functions (SearchTag, BLE...) : 0 = off, 1 = on
+#endif
+
+#define CMDSERVER_MAXPARAMS         64          // Longest parameters of an application command in bytes
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Handler of an application command
+// Returns an error code of prs.h (ERR_NONE if succeed) and the response data
+typedef int (*TCmdServerHandler)(const byte* params, int length, byte* response, int* responseLength);
+
+// Application command
+typedef struct
+{
+    byte Function;                  // Function number in CMDSERVER_API
+    TCmdServerHandler Handler;
+} TCmdServerCommand;
+
+// Counters reported by the command server
+typedef struct
+{
+    uint32_t Commands;          // Commands executed
+    uint32_t Errors;            // Commands answered with an error code
+    uint32_t Rejected;          // System commands rejected (CMDSERVER_SYSTEMAPI off)
+    uint32_t OverBudget;        // Polls longer than CMDSERVER_BUDGET
+    uint32_t MaxTicks;          // Longest poll in milliseconds
+} TCmdServerStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void cmdServerInit(const TCmdServerCommand* commands, int count);
+void cmdServerPoll(void);
+uint32_t cmdServerRemaining(void);
+void cmdServerGetStats(TCmdServerStats* stats);
+
+#endif
@@ -0,0 +1,399 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                           ED25519 BASE POINT COMB TABLE
+//
+// Comb table of the base point B, stored in flash (63 entries, 6048 bytes)
+// - Entry (i - 1) = sum of 2^(43 * b) * B for every bit b set in i
+// - Entries are (y + x, y - x, 2 * d * x * y), 32 bytes little endian each
+// - Generated with ed25519ComputeCombTable() on B, regenerate it if
+//   ED25519_COMB_TEETH or ED25519_COMB_SPACING is modified
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ED25519_BASE_TABLE_H__
+#define __ED25519_BASE_TABLE_H__
+
+#if ED25519_COMB_TEETH != 6 || ED25519_COMB_SPACING != 43
+  #error "ed25519_base_table.h must be regenerated for this comb size"
+#endif
+
+const TEd25519PackedPoint ed25519BaseTable[ED25519_COMB_ENTRIES] = {
+    {{0x85, 0x3b, 0x8c, 0xf5, 0xc6, 0x93, 0xbc, 0x2f, 0x19, 0x0e, 0x8c, 0xfb, 0xc6, 0x2d, 0x93, 0xcf,
+      0xc2, 0x42, 0x3d, 0x64, 0x98, 0x48, 0x0b, 0x27, 0x65, 0xba, 0xd4, 0x33, 0x3a, 0x9d, 0xcf, 0x07},
+     {0x3e, 0x91, 0x40, 0xd7, 0x05, 0x39, 0x10, 0x9d, 0xb3, 0xbe, 0x40, 0xd1, 0x05, 0x9f, 0x39, 0xfd,
+      0x09, 0x8a, 0x8f, 0x68, 0x34, 0x84, 0xc1, 0xa5, 0x67, 0x12, 0xf8, 0x98, 0x92, 0x2f, 0xfd, 0x44},
+     {0x68, 0xaa, 0x7a, 0x87, 0x05, 0x12, 0xc9, 0xab, 0x9e, 0xc4, 0xaa, 0xcc, 0x23, 0xe8, 0xd9, 0x26,
+      0x8c, 0x59, 0x43, 0xdd, 0xcb, 0x7d, 0x1b, 0x5a, 0xa8, 0x65, 0x0c, 0x9f, 0x68, 0x7b, 0x11, 0x6f}},
+    {{0x00, 0x45, 0xd9, 0x0d, 0x58, 0x03, 0xfc, 0x29, 0x93, 0xec, 0xbb, 0x6f, 0xa4, 0x7a, 0xd2, 0xec,
+      0xf8, 0xa7, 0xe2, 0xc2, 0x5f, 0x15, 0x0a, 0x13, 0xd5, 0xa1, 0x06, 0xb7, 0x1a, 0x15, 0x6b, 0x41},
+     {0x85, 0x8c, 0xb2, 0x17, 0xd6, 0x3b, 0x0a, 0xd3, 0xea, 0x3b, 0x77, 0x39, 0xb7, 0x77, 0xd3, 0xc5,
+      0xbf, 0x5c, 0x6a, 0x1e, 0x8c, 0xe7, 0xc6, 0xc6, 0xc4, 0xb7, 0x2a, 0x8b, 0xf7, 0xb8, 0x61, 0x0d},
+     {0xb0, 0x36, 0xc1, 0xe9, 0xef, 0xd7, 0xa8, 0x56, 0x20, 0x4b, 0xe4, 0x58, 0xcd, 0xe5, 0x07, 0xbd,
+      0xab, 0xe0, 0x57, 0x1b, 0xda, 0x2f, 0xe6, 0xaf, 0xd2, 0xe8, 0x77, 0x42, 0xf7, 0x2a, 0x1a, 0x19}},
+    {{0x3a, 0x44, 0x73, 0x59, 0x14, 0x89, 0x74, 0x56, 0xa1, 0xc2, 0x6a, 0x7a, 0xc3, 0x36, 0xa5, 0xf1,
+      0x4f, 0xee, 0x36, 0x0f, 0x97, 0xda, 0x5f, 0x13, 0x56, 0xf0, 0x5c, 0x6e, 0x3a, 0xfd, 0xcf, 0x65},
+     {0x04, 0xeb, 0x7b, 0xa5, 0xc0, 0x85, 0xe0, 0x69, 0xd4, 0x0a, 0x28, 0x91, 0x14, 0x1d, 0x6d, 0x37,
+      0x44, 0xe8, 0x00, 0x56, 0xbc, 0x31, 0xad, 0xe9, 0x90, 0x8f, 0xce, 0x5d, 0x47, 0x89, 0x3f, 0x4e},
+     {0x63, 0xab, 0x04, 0xab, 0xaa, 0xdf, 0x7e, 0x9c, 0xb3, 0x9a, 0xae, 0x15, 0x72, 0xdf, 0x11, 0xc0,
+      0xf7, 0x3e, 0x9b, 0x95, 0x3c, 0xef, 0x38, 0x73, 0xa8, 0x43, 0x2f, 0x9a, 0x68, 0x1c, 0xd7, 0x0f}},
+    {{0x5f, 0xa2, 0x87, 0xd0, 0xdd, 0x0f, 0x0f, 0xee, 0xee, 0x34, 0x3e, 0x5c, 0x55, 0x31, 0x75, 0x9c,
+      0xb5, 0x3a, 0xab, 0x8f, 0x2e, 0x57, 0x0c, 0x66, 0xb2, 0xd3, 0x4c, 0x54, 0x44, 0xfc, 0x54, 0x08},
+     {0xd2, 0xa0, 0x15, 0xc7, 0xe3, 0xa4, 0x16, 0x16, 0x4d, 0x1d, 0x34, 0xf8, 0xb0, 0x3c, 0x62, 0x53,
+      0xcb, 0x99, 0xe8, 0xc7, 0x29, 0x53, 0xef, 0x96, 0xa6, 0xba, 0x68, 0xa6, 0xbb, 0x8d, 0x4e, 0x3d},
+     {0x19, 0xad, 0xed, 0x55, 0xc5, 0xa0, 0xeb, 0x61, 0xe6, 0x3d, 0xa8, 0xf0, 0xfe, 0x33, 0xb5, 0x24,
+      0xf8, 0xa5, 0xba, 0x83, 0x28, 0x04, 0x77, 0x3b, 0x8d, 0x7e, 0xa4, 0x98, 0xb8, 0x82, 0x8f, 0x67}},
+    {{0x7c, 0xb0, 0x9e, 0xe6, 0xc5, 0xbf, 0xfa, 0x13, 0x8e, 0x0d, 0x22, 0xde, 0xc8, 0xd1, 0xce, 0x52,
+      0x02, 0xd5, 0x62, 0x31, 0x71, 0x0e, 0x8e, 0x9d, 0xb0, 0xd6, 0x00, 0xa5, 0x5a, 0x0e, 0xce, 0x72},
+     {0x1a, 0x8e, 0x5c, 0xdc, 0xa4, 0xb3, 0x6c, 0x51, 0x18, 0xa0, 0x09, 0x80, 0x9a, 0x46, 0x33, 0xd5,
+      0xe0, 0x3c, 0x4d, 0x3b, 0xfc, 0x49, 0xa2, 0x43, 0x29, 0xe1, 0x29, 0xa9, 0x93, 0xea, 0x7c, 0x35},
+     {0x08, 0x46, 0x6f, 0x68, 0x7f, 0x0b, 0x7c, 0x9e, 0xad, 0xba, 0x07, 0x61, 0x74, 0x83, 0x2f, 0xfc,
+      0x26, 0xd6, 0x09, 0xb9, 0x00, 0x34, 0x36, 0x4f, 0x01, 0xf3, 0x48, 0xdb, 0x43, 0xba, 0x04, 0x44}},
+    {{0x65, 0x77, 0xd4, 0x22, 0x6a, 0x81, 0x49, 0x52, 0xe1, 0x33, 0x5a, 0xec, 0x03, 0x3d, 0x09, 0x29,
+      0xfa, 0xb8, 0x78, 0x35, 0x7b, 0xbc, 0xae, 0xb4, 0x71, 0xed, 0x41, 0x0c, 0x6e, 0xf6, 0x88, 0x07},
+     {0x77, 0xc4, 0x73, 0xc5, 0xd6, 0xa7, 0x11, 0xaf, 0x1b, 0xc4, 0x1f, 0xf5, 0x5a, 0x8a, 0x68, 0x52,
+      0xbe, 0x8c, 0xa8, 0xc5, 0x56, 0xb5, 0x4a, 0x3d, 0x36, 0x6a, 0xfa, 0xb6, 0x0c, 0xd0, 0x76, 0x49},
+     {0x05, 0x78, 0x38, 0x87, 0xa0, 0x06, 0x87, 0xc9, 0x73, 0x27, 0x29, 0x8c, 0xd3, 0x74, 0x56, 0x43,
+      0xa6, 0x3c, 0xef, 0xa6, 0x59, 0xd6, 0x2f, 0x94, 0xab, 0xdb, 0x08, 0x31, 0x5e, 0x4d, 0x95, 0x63}},
+    {{0xc1, 0x0e, 0xf5, 0x3a, 0xfd, 0x07, 0x54, 0xb6, 0xd1, 0xea, 0x53, 0xbe, 0x9d, 0x6f, 0x36, 0xc3,
+      0x49, 0xdc, 0x9c, 0x38, 0x77, 0x31, 0x19, 0x33, 0xde, 0x10, 0x2c, 0x19, 0xe9, 0x0a, 0x19, 0x27},
+     {0xc5, 0xf8, 0x3f, 0x85, 0xcd, 0xb5, 0x07, 0x94, 0x38, 0x75, 0x8b, 0xe4, 0x1e, 0xdf, 0x9d, 0x12,
+      0x4c, 0xa1, 0x0a, 0x86, 0x8d, 0xbd, 0x08, 0x1d, 0x80, 0x02, 0xb2, 0x30, 0x82, 0xee, 0x2a, 0x2a},
+     {0x75, 0xcc, 0x6e, 0xb8, 0x42, 0xd5, 0xf4, 0xb2, 0x8b, 0x67, 0x83, 0xf9, 0x1d, 0x00, 0x4d, 0x38,
+      0x4b, 0x3b, 0xe7, 0xe4, 0x82, 0x59, 0x62, 0xd1, 0xf9, 0xaa, 0x72, 0x6b, 0xc0, 0x09, 0x11, 0x1b}},
+    {{0xce, 0x07, 0x63, 0xf8, 0xc6, 0xd8, 0x9a, 0x4b, 0x28, 0x0c, 0x5d, 0x43, 0x31, 0x35, 0x11, 0x21,
+      0x2c, 0x77, 0x7a, 0x65, 0xc5, 0x66, 0xa8, 0xd4, 0x52, 0x73, 0x24, 0x63, 0x7e, 0x42, 0xa6, 0x5d},
+     {0x9e, 0x46, 0x19, 0x94, 0x5e, 0x35, 0xbb, 0x51, 0x54, 0xc7, 0xdd, 0x23, 0x4c, 0xdc, 0xe6, 0x33,
+      0x62, 0x99, 0x7f, 0x44, 0xd6, 0xb6, 0xa5, 0x93, 0x63, 0xbd, 0x44, 0xfb, 0x6f, 0x7c, 0xce, 0x6c},
+     {0xca, 0x22, 0xac, 0xde, 0x88, 0xc6, 0x94, 0x1a, 0xf8, 0x1f, 0xae, 0xbb, 0xf7, 0x6e, 0x06, 0xb9,
+      0x0f, 0x58, 0x59, 0x8d, 0x38, 0x8c, 0xad, 0x88, 0xa8, 0x2c, 0x9f, 0xe7, 0xbf, 0x9a, 0xf2, 0x58}},
+    {{0x49, 0xb7, 0x9e, 0x39, 0x79, 0xc5, 0x5c, 0x0c, 0x46, 0xf3, 0x18, 0x44, 0xd7, 0x95, 0x57, 0x77,
+      0x3b, 0xba, 0xa5, 0xff, 0x8e, 0x01, 0xa6, 0xca, 0x02, 0x06, 0xe9, 0xa5, 0x0b, 0xd2, 0x52, 0x1d},
+     {0x13, 0xa1, 0x42, 0xda, 0x92, 0x8e, 0xb2, 0x85, 0xb4, 0x88, 0x6f, 0xe2, 0x3a, 0x17, 0xda, 0xc8,
+      0x4d, 0xd5, 0xed, 0xbc, 0xb0, 0xc6, 0xd7, 0x1f, 0x42, 0x61, 0x98, 0x0a, 0x43, 0x44, 0x79, 0x51},
+     {0xb1, 0x1d, 0x2c, 0x20, 0xeb, 0x16, 0x22, 0xcc, 0xac, 0x52, 0x62, 0x74, 0x6e, 0x9d, 0x68, 0x52,
+      0x61, 0x2c, 0x95, 0x28, 0x6f, 0x82, 0xbd, 0x06, 0x91, 0x34, 0x25, 0x94, 0x7f, 0xb4, 0xa7, 0x11}},
+    {{0x6a, 0x6d, 0x6d, 0xd1, 0xfa, 0xf5, 0x03, 0x30, 0xbd, 0x6d, 0xc2, 0xc8, 0xf5, 0x38, 0x80, 0x4f,
+      0xb2, 0xbe, 0xa1, 0x76, 0x50, 0x1a, 0x73, 0xf2, 0x78, 0x2b, 0x8e, 0x3a, 0x1e, 0x34, 0x47, 0x7b},
+     {0xc3, 0x2c, 0x36, 0xdc, 0xc5, 0x45, 0xbc, 0xef, 0x1b, 0x64, 0xd6, 0x65, 0x28, 0xe9, 0xda, 0x84,
+      0x13, 0xbe, 0x27, 0x8e, 0x3f, 0x98, 0x2a, 0x37, 0xee, 0x78, 0x97, 0xd6, 0xc0, 0x6f, 0xb4, 0x53},
+     {0x58, 0x5d, 0xa7, 0xa3, 0x68, 0xbb, 0x20, 0x30, 0x2e, 0x03, 0xe9, 0xb1, 0xd4, 0x90, 0x72, 0xe3,
+      0x71, 0xb2, 0x36, 0x3e, 0x73, 0xa0, 0x2e, 0x3d, 0xd1, 0x85, 0x33, 0x62, 0x4e, 0xa7, 0x7b, 0x31}},
+    {{0x98, 0xa2, 0x8f, 0x50, 0xbb, 0x80, 0x4d, 0x52, 0x5c, 0x0a, 0x4f, 0x6d, 0xa3, 0x6c, 0x17, 0x59,
+      0xfe, 0xb7, 0x0b, 0x41, 0xc7, 0x25, 0xc4, 0x9c, 0xfd, 0xfa, 0xbf, 0x5f, 0x82, 0x5d, 0x0d, 0x48},
+     {0x52, 0xe4, 0x14, 0xa9, 0x02, 0x90, 0x3e, 0x36, 0xc7, 0xa5, 0xa7, 0x9b, 0xa4, 0xf8, 0xae, 0x6e,
+      0xfe, 0x43, 0x6f, 0x36, 0x23, 0x37, 0x13, 0x2c, 0xf3, 0xae, 0xbf, 0xd1, 0x2c, 0x1f, 0xc2, 0x7e},
+     {0xfa, 0x6b, 0x13, 0x03, 0x84, 0x00, 0x1f, 0x00, 0x1e, 0xf4, 0xb2, 0x61, 0x7a, 0x2e, 0xa4, 0x21,
+      0x0a, 0xca, 0x11, 0x1b, 0xda, 0x34, 0x25, 0x58, 0x6c, 0x16, 0x97, 0xa6, 0x75, 0x04, 0x98, 0x79}},
+    {{0x10, 0xc1, 0xc3, 0x91, 0x48, 0x99, 0x50, 0xa3, 0x8a, 0xa3, 0x15, 0x97, 0x70, 0x50, 0xbd, 0x7c,
+      0x57, 0x6a, 0xb1, 0xc1, 0x4f, 0xcc, 0x78, 0x38, 0x3d, 0xff, 0x85, 0x6c, 0x48, 0xb3, 0xeb, 0x2d},
+     {0x1b, 0x9b, 0xf4, 0xa7, 0x3f, 0xe8, 0x13, 0x2c, 0x04, 0x00, 0xa3, 0x54, 0xe3, 0x86, 0x70, 0xf5,
+      0xa2, 0xa1, 0x70, 0xb2, 0xd0, 0xd5, 0xc3, 0x38, 0x8f, 0x3f, 0x50, 0x4c, 0x02, 0xe7, 0xe7, 0x12},
+     {0xfe, 0x02, 0xa0, 0xd4, 0x0a, 0x19, 0x13, 0xbf, 0x8f, 0xac, 0x9e, 0x56, 0x3f, 0x7c, 0x64, 0x46,
+      0x96, 0xa5, 0xb7, 0x1f, 0xa1, 0x5b, 0x25, 0x2a, 0xc2, 0x0b, 0xbc, 0x2c, 0xc1, 0xc7, 0xb5, 0x69}},
+    {{0x9d, 0x24, 0x5f, 0xf0, 0xf0, 0x15, 0xc9, 0xd0, 0x92, 0xc5, 0xbc, 0x8b, 0x05, 0x5e, 0x7d, 0xa9,
+      0x04, 0x5a, 0x0d, 0xde, 0x87, 0x6b, 0xa2, 0xfe, 0x1f, 0x9f, 0x4a, 0xe6, 0x75, 0x65, 0xa7, 0x24},
+     {0xb7, 0x1b, 0x46, 0x96, 0xe6, 0x77, 0x2d, 0xe0, 0xa4, 0xa9, 0xba, 0x25, 0x0b, 0xfa, 0x18, 0xf1,
+      0x75, 0x31, 0xdf, 0xf0, 0xf0, 0xd1, 0x87, 0xff, 0x78, 0x62, 0xd4, 0x4e, 0x7f, 0xa4, 0xd4, 0x5a},
+     {0xad, 0x95, 0xc7, 0x61, 0x59, 0xfe, 0xeb, 0x37, 0x43, 0xe2, 0x03, 0xda, 0xf6, 0xae, 0xb8, 0x8e,
+      0x39, 0x5e, 0x4a, 0xcf, 0x1b, 0x1a, 0xe3, 0x6d, 0xa6, 0xac, 0x39, 0x0c, 0x13, 0x07, 0x93, 0x6f}},
+    {{0x4d, 0x06, 0x09, 0xf2, 0xa5, 0x7c, 0x3d, 0xba, 0xc8, 0x31, 0xda, 0xd0, 0xd5, 0xc3, 0x58, 0xaa,
+      0xb7, 0xfe, 0x28, 0x48, 0x3e, 0x5c, 0x23, 0x3a, 0xf3, 0x41, 0xf8, 0x21, 0x6c, 0x47, 0xb0, 0x51},
+     {0x93, 0x8b, 0x51, 0xc3, 0xd2, 0x91, 0xd0, 0xbd, 0x32, 0xbd, 0xac, 0xd2, 0x77, 0xdc, 0x8c, 0x43,
+      0xf0, 0x5b, 0x95, 0x89, 0xdd, 0xfd, 0xc6, 0x91, 0x3f, 0xad, 0xba, 0x2d, 0x2f, 0x7d, 0x40, 0x26},
+     {0x8c, 0xa2, 0x39, 0x56, 0xc0, 0x62, 0xce, 0xf0, 0xc5, 0x94, 0xe2, 0x8e, 0x47, 0xd0, 0x66, 0x29,
+      0x50, 0xb6, 0x5a, 0x13, 0xb2, 0xa0, 0xcc, 0xb2, 0xc9, 0xe4, 0xba, 0x37, 0x73, 0xab, 0x97, 0x35}},
+    {{0xf2, 0x72, 0x7a, 0x55, 0xfa, 0x74, 0x43, 0xef, 0xa7, 0xba, 0x89, 0x48, 0x3a, 0xfb, 0x83, 0xe0,
+      0x49, 0x07, 0x13, 0x6e, 0xd5, 0xe7, 0x88, 0xe4, 0xef, 0x14, 0x99, 0x01, 0x94, 0xcb, 0xed, 0x27},
+     {0x0a, 0x6e, 0xca, 0xdc, 0x3d, 0x13, 0xba, 0x73, 0x38, 0x0b, 0x7d, 0xaf, 0xec, 0x01, 0x75, 0xd5,
+      0xcd, 0xfa, 0x1d, 0x0e, 0x3e, 0x34, 0x68, 0x83, 0x80, 0x4a, 0x14, 0x85, 0x42, 0xd4, 0x69, 0x78},
+     {0x52, 0x48, 0x6d, 0x4c, 0x11, 0xd2, 0xb5, 0xe9, 0xe1, 0x54, 0xfa, 0x10, 0xd2, 0x7c, 0x5b, 0x0e,
+      0x05, 0xdd, 0xfa, 0x59, 0xe0, 0xd3, 0x57, 0x3c, 0xa8, 0xce, 0x5b, 0x7e, 0xba, 0xaf, 0x49, 0x2d}},
+    {{0x47, 0x62, 0xa3, 0x93, 0xa2, 0xcb, 0x8e, 0x35, 0x65, 0xfd, 0x68, 0xb2, 0x62, 0x98, 0x8f, 0xaf,
+      0x89, 0x1c, 0xa0, 0x68, 0x99, 0x7e, 0x2f, 0x41, 0x24, 0x45, 0x75, 0xcd, 0x12, 0xf3, 0x86, 0x57},
+     {0x3e, 0x0d, 0xc2, 0x7e, 0x0c, 0xd5, 0xa2, 0xb5, 0x63, 0x72, 0xc9, 0xa0, 0x6e, 0xdd, 0x4b, 0xc6,
+      0x4d, 0x73, 0xff, 0xc1, 0x52, 0x90, 0xe8, 0x56, 0xba, 0xfa, 0x2f, 0x2b, 0xf7, 0xc6, 0x29, 0x49},
+     {0x2c, 0x03, 0x14, 0xca, 0xff, 0x88, 0x77, 0x33, 0xe3, 0x1e, 0x7f, 0x44, 0x28, 0x10, 0x92, 0xf3,
+      0xad, 0xcc, 0x1b, 0x23, 0x1f, 0x07, 0x14, 0x8b, 0x83, 0x47, 0x34, 0xf2, 0x4b, 0x7b, 0x81, 0x4c}},
+    {{0x4c, 0xda, 0x0d, 0x13, 0x66, 0xfd, 0x82, 0x84, 0x9f, 0x75, 0x5b, 0xa2, 0x17, 0xfe, 0x34, 0xbf,
+      0x1f, 0xcb, 0xba, 0x90, 0x55, 0x80, 0x83, 0xfd, 0x63, 0xb9, 0x18, 0xf8, 0x5b, 0x5d, 0x94, 0x1e},
+     {0xb9, 0xdb, 0x6c, 0x04, 0x88, 0x22, 0xd8, 0x79, 0x83, 0x2f, 0x8d, 0x65, 0x6b, 0xd2, 0xab, 0x1b,
+      0xdd, 0x65, 0xe5, 0x93, 0x63, 0xf8, 0xa2, 0xd8, 0x3c, 0xf1, 0x4b, 0xc5, 0x99, 0xd1, 0xf2, 0x12},
+     {0x05, 0x4c, 0xb8, 0x3b, 0xfe, 0xf5, 0x9f, 0x2e, 0xd1, 0xb2, 0xb8, 0xff, 0xfe, 0x6d, 0xd9, 0x37,
+      0xe0, 0xae, 0xb4, 0x5a, 0x51, 0x80, 0x7e, 0x9b, 0x1d, 0xd1, 0x8d, 0x8c, 0x56, 0xb1, 0x84, 0x35}},
+    {{0x46, 0x22, 0x0a, 0x95, 0x7d, 0x5e, 0x20, 0x09, 0x9a, 0xef, 0xa2, 0xb9, 0x3f, 0x4e, 0x5e, 0x0e,
+      0xfe, 0x8b, 0xda, 0x3e, 0x8a, 0xdd, 0xb6, 0xc3, 0x72, 0x25, 0xf1, 0xdc, 0xd7, 0x59, 0xa3, 0x7b},
+     {0x76, 0x73, 0x97, 0x50, 0x36, 0x2f, 0x71, 0x42, 0x56, 0x27, 0x37, 0x5d, 0x21, 0xdb, 0x3d, 0x1b,
+      0x13, 0x2d, 0x0a, 0x09, 0x77, 0xec, 0x01, 0x7e, 0x7d, 0xe6, 0x85, 0xc2, 0x0a, 0xa6, 0xd0, 0x07},
+     {0xfa, 0x2d, 0xfd, 0x78, 0x30, 0xc2, 0x5e, 0x2c, 0xd3, 0xa6, 0x55, 0xda, 0xcc, 0x46, 0x0f, 0x73,
+      0x9e, 0xcb, 0x78, 0x6c, 0xc3, 0x31, 0x33, 0xca, 0x96, 0xf1, 0x52, 0xc8, 0x91, 0xc0, 0x49, 0x4f}},
+    {{0xde, 0x3b, 0x58, 0xf9, 0xd1, 0x63, 0x11, 0x3a, 0x37, 0x03, 0xe8, 0x4a, 0x57, 0x0f, 0x2a, 0x3a,
+      0xbc, 0x79, 0x14, 0x3b, 0x1d, 0x4f, 0xf2, 0xb8, 0x5a, 0x98, 0x4f, 0xa1, 0x47, 0x1e, 0x56, 0x14},
+     {0x05, 0x07, 0x83, 0xf9, 0xbf, 0xa4, 0x59, 0xb6, 0x39, 0x21, 0x28, 0x9c, 0x8d, 0xef, 0xd9, 0x92,
+      0xcd, 0x77, 0xc9, 0x3d, 0x8d, 0x46, 0xd7, 0xf4, 0x55, 0x1a, 0xb5, 0x6e, 0xac, 0xd2, 0x23, 0x40},
+     {0x5f, 0x81, 0xf9, 0xd2, 0xe7, 0x91, 0xc9, 0xfb, 0x58, 0x04, 0x0f, 0xaf, 0xe6, 0xac, 0xc2, 0x26,
+      0xbc, 0xc6, 0xf4, 0xca, 0x95, 0x3c, 0x82, 0xa6, 0x20, 0xe3, 0xa2, 0xa9, 0x25, 0x5f, 0x7e, 0x03}},
+    {{0xb8, 0x6c, 0x57, 0x4e, 0xd3, 0xa5, 0x45, 0x87, 0xdf, 0x7a, 0xe5, 0x18, 0x92, 0xcf, 0xcf, 0x5a,
+      0xdc, 0xb2, 0xe2, 0xbe, 0x49, 0xa6, 0xfc, 0xdf, 0xab, 0xf8, 0xaf, 0x56, 0x1a, 0xc1, 0x02, 0x7b},
+     {0xfd, 0xe8, 0x3f, 0x26, 0xc1, 0x22, 0xd1, 0xdb, 0x0a, 0xfa, 0x10, 0x8c, 0x15, 0x8a, 0x34, 0x21,
+      0xa7, 0x13, 0x47, 0xbf, 0xd2, 0xf7, 0x96, 0xb8, 0x4c, 0xfb, 0x42, 0x66, 0xd1, 0x8a, 0x75, 0x2b},
+     {0xbe, 0x47, 0x64, 0xa1, 0x11, 0x9c, 0x5a, 0xd4, 0xd8, 0x54, 0x68, 0x17, 0x73, 0x45, 0x9a, 0xe1,
+      0x2e, 0xf4, 0x0c, 0x6b, 0xe1, 0x01, 0x4f, 0xdc, 0x90, 0x5d, 0xcb, 0x1c, 0x41, 0x54, 0xcd, 0x63}},
+    {{0x39, 0x71, 0x43, 0x34, 0xe3, 0x42, 0x45, 0xa1, 0xf2, 0x68, 0x71, 0xa7, 0xe8, 0x23, 0xfd, 0x9f,
+      0x86, 0x48, 0xff, 0xe5, 0x96, 0x74, 0xcf, 0x05, 0x49, 0xe2, 0xb3, 0x6c, 0x17, 0x77, 0x2f, 0x6d},
+     {0x73, 0x3f, 0xc1, 0xc7, 0x6a, 0x66, 0xa1, 0x20, 0xdd, 0x11, 0xfb, 0x7a, 0x6e, 0xa8, 0x51, 0xb8,
+      0x3f, 0x9d, 0xa2, 0x97, 0x84, 0xb5, 0xc7, 0x90, 0x7c, 0xab, 0x48, 0xd6, 0x84, 0xa3, 0xd5, 0x1a},
+     {0x63, 0x27, 0x3c, 0x49, 0x4b, 0xfc, 0x22, 0xf2, 0x0b, 0x50, 0xc2, 0x0f, 0xb4, 0x1f, 0x31, 0x0c,
+      0x2f, 0x53, 0xab, 0xaa, 0x75, 0x6f, 0xe0, 0x69, 0x39, 0x56, 0xe0, 0x3b, 0xb7, 0xa8, 0xbf, 0x45}},
+    {{0x17, 0x7f, 0xd1, 0x7f, 0x93, 0x43, 0x54, 0xeb, 0x9c, 0xc5, 0xda, 0xfc, 0x3d, 0x78, 0xf0, 0x8d,
+      0x5a, 0x9b, 0xd7, 0xd3, 0xed, 0x06, 0x1b, 0xdb, 0x2c, 0x72, 0x60, 0x7c, 0xf4, 0xc0, 0x75, 0x4b},
+     {0x7f, 0x16, 0x41, 0x6f, 0x95, 0x47, 0xcb, 0x43, 0xf1, 0x71, 0x3c, 0xcd, 0xfd, 0x6c, 0x67, 0xa7,
+      0x4d, 0xe1, 0xb2, 0x36, 0x84, 0xed, 0x41, 0x4f, 0x2c, 0x5b, 0xae, 0xa0, 0x6f, 0x3f, 0xef, 0x79},
+     {0x77, 0x69, 0xae, 0xb9, 0x58, 0x97, 0x7c, 0x4a, 0x4b, 0xcb, 0x92, 0xa5, 0xdf, 0x97, 0x93, 0x16,
+      0x01, 0x91, 0x99, 0xe0, 0x0b, 0x18, 0xb7, 0x3a, 0xe5, 0x21, 0x0c, 0x0f, 0xba, 0x07, 0xb1, 0x5b}},
+    {{0x23, 0x96, 0x5a, 0x08, 0xa9, 0xaa, 0xa1, 0xe6, 0xbf, 0x9c, 0xae, 0x62, 0x85, 0xe2, 0x3f, 0x73,
+      0xc9, 0xcd, 0xd8, 0xae, 0x96, 0x7a, 0x36, 0x81, 0x64, 0x87, 0x96, 0x23, 0x74, 0x28, 0x45, 0x00},
+     {0x35, 0x00, 0x19, 0xa1, 0x9b, 0xff, 0x5e, 0x56, 0xf1, 0xb8, 0x00, 0xad, 0x98, 0x55, 0x5b, 0xfa,
+      0x18, 0x40, 0xb0, 0xbd, 0x39, 0x33, 0x5b, 0xc1, 0x69, 0xf7, 0xb9, 0x66, 0x4c, 0xbc, 0xb6, 0x25},
+     {0x96, 0x99, 0xe5, 0x38, 0xf5, 0xfa, 0x9b, 0xc1, 0x46, 0x6a, 0x6e, 0x24, 0x45, 0x23, 0xb7, 0x40,
+      0xe4, 0x03, 0x0e, 0x59, 0x85, 0xef, 0x00, 0xaa, 0x27, 0xe1, 0x27, 0x10, 0x7b, 0xd6, 0x58, 0x1e}},
+    {{0xfc, 0xc2, 0x3b, 0x39, 0x1b, 0xf8, 0x99, 0x36, 0x21, 0xee, 0x07, 0xf4, 0x99, 0xcb, 0xdf, 0x24,
+      0xcd, 0x38, 0x4e, 0x1c, 0xe3, 0x85, 0x04, 0x0e, 0xa9, 0x1e, 0xd5, 0x89, 0x7e, 0x5a, 0x01, 0x02},
+     {0x6f, 0x4a, 0xa0, 0x26, 0xd3, 0xa9, 0x2b, 0x57, 0x6e, 0x26, 0x3e, 0x0f, 0xe7, 0xd2, 0x36, 0xba,
+      0x8a, 0x33, 0x83, 0xef, 0x22, 0x8b, 0xb7, 0xcd, 0xa0, 0x30, 0xe8, 0x03, 0xf0, 0x26, 0x8e, 0x42},
+     {0x60, 0x2b, 0x7d, 0xe2, 0x86, 0x81, 0x46, 0xec, 0x34, 0xa5, 0x30, 0x4e, 0xeb, 0x52, 0x0e, 0xc6,
+      0x9b, 0x2f, 0x42, 0xab, 0xf0, 0x4f, 0xb7, 0xb7, 0x88, 0x3c, 0x8a, 0x49, 0x2e, 0x68, 0x3c, 0x1c}},
+    {{0x46, 0x0e, 0xf4, 0x94, 0x7e, 0xd3, 0x4f, 0x35, 0x9f, 0x5f, 0x62, 0xb7, 0xb9, 0xe6, 0x42, 0x87,
+      0x6f, 0xca, 0x55, 0x48, 0x95, 0xa7, 0x10, 0x48, 0x2a, 0xe5, 0x61, 0x28, 0x84, 0x49, 0x83, 0x0e},
+     {0xfe, 0x76, 0xf9, 0x6f, 0x7b, 0x9a, 0x9b, 0xfc, 0x99, 0xb1, 0xf1, 0xa8, 0xa9, 0xe3, 0x89, 0x75,
+      0xe4, 0xf0, 0x33, 0x4c, 0xf4, 0x54, 0x38, 0x52, 0x8d, 0x94, 0xb6, 0xb5, 0xfd, 0x6e, 0xc5, 0x5e},
+     {0x5d, 0xc9, 0x33, 0x88, 0x54, 0x06, 0x10, 0xb2, 0x84, 0xee, 0x4d, 0x24, 0xdd, 0x09, 0xf8, 0x23,
+      0x0f, 0xf1, 0x5c, 0x7a, 0x57, 0x67, 0x54, 0x92, 0x33, 0x62, 0x01, 0x36, 0xbd, 0x75, 0x3f, 0x43}},
+    {{0x73, 0xa2, 0xb5, 0xe5, 0x0d, 0x2b, 0x70, 0xd4, 0x2e, 0xbc, 0xa9, 0xbc, 0x6d, 0x9f, 0xe0, 0xc5,
+      0xdb, 0x36, 0xfe, 0x4b, 0xac, 0xe7, 0xc5, 0xed, 0x69, 0xce, 0xa5, 0xa8, 0x67, 0x89, 0x1d, 0x02},
+     {0x2b, 0x80, 0x9a, 0x96, 0xb7, 0x57, 0xbf, 0xd2, 0x2f, 0xae, 0xf3, 0x00, 0xac, 0x83, 0x7f, 0x49,
+      0x35, 0xf3, 0xac, 0xc3, 0x5d, 0xac, 0xdb, 0x44, 0xe5, 0x3b, 0x56, 0x9d, 0xbc, 0xe3, 0x1a, 0x60},
+     {0x1a, 0x45, 0x03, 0x7f, 0x33, 0xeb, 0xf9, 0xdc, 0x84, 0x34, 0x52, 0xfd, 0x9b, 0xd0, 0x29, 0x2c,
+      0x56, 0xbc, 0x9c, 0xf3, 0x17, 0x81, 0xd2, 0x70, 0xb6, 0x74, 0x3f, 0x83, 0xa1, 0xae, 0xb3, 0x2e}},
+    {{0xa6, 0x7d, 0x0b, 0x74, 0xd7, 0x98, 0x81, 0x34, 0xe5, 0x45, 0x71, 0x79, 0xb3, 0x8d, 0x91, 0xce,
+      0x76, 0x6f, 0xa0, 0x61, 0x57, 0x09, 0xcb, 0xce, 0x91, 0xe2, 0xa3, 0x88, 0x26, 0x16, 0xf0, 0x53},
+     {0x46, 0x6f, 0xd6, 0xf7, 0x02, 0x48, 0x20, 0xac, 0x7f, 0x55, 0x3e, 0xee, 0x2f, 0x06, 0xbc, 0x7f,
+      0x67, 0xf8, 0x09, 0x5c, 0x8e, 0xc1, 0x66, 0x2a, 0xe2, 0xab, 0xed, 0x7f, 0x5d, 0x76, 0x98, 0x60},
+     {0x87, 0x48, 0x88, 0x21, 0xd5, 0x44, 0x99, 0x79, 0xf0, 0xeb, 0xd2, 0xfd, 0x74, 0x8c, 0x57, 0xe9,
+      0x20, 0x07, 0x58, 0xf6, 0xc1, 0x38, 0x3d, 0xad, 0x66, 0x58, 0xde, 0x82, 0xb0, 0xaa, 0x1b, 0x31}},
+    {{0xf1, 0x14, 0x84, 0xea, 0xac, 0x22, 0xc9, 0x71, 0x62, 0x7f, 0x83, 0x9f, 0xb1, 0xed, 0xd5, 0xf3,
+      0xfd, 0x0b, 0xd3, 0xa1, 0xf8, 0x3f, 0xeb, 0x21, 0x1c, 0x61, 0x4c, 0xee, 0xb5, 0xf6, 0x4f, 0x1d},
+     {0xd5, 0xfb, 0xc0, 0x4e, 0xb4, 0x19, 0x00, 0xa6, 0x61, 0x03, 0xc6, 0x0b, 0x5c, 0x66, 0xe1, 0x94,
+      0xad, 0x0c, 0x33, 0x29, 0x1f, 0x06, 0x02, 0xf2, 0x04, 0x14, 0xfb, 0x3e, 0x9a, 0xe0, 0x83, 0x6b},
+     {0x20, 0x14, 0x89, 0xbf, 0xe3, 0xc5, 0x3a, 0x45, 0xc2, 0x24, 0x2e, 0x85, 0x65, 0xdc, 0xcb, 0x91,
+      0x91, 0xdb, 0x38, 0x3b, 0x7e, 0xeb, 0x13, 0x49, 0x0b, 0x8e, 0x9d, 0xa6, 0xda, 0x14, 0x60, 0x55}},
+    {{0xb6, 0x34, 0x5a, 0xea, 0x6d, 0x88, 0xc7, 0xb1, 0x7d, 0x59, 0xa6, 0x5c, 0x37, 0x43, 0x2d, 0x18,
+      0xe9, 0x50, 0x4b, 0xde, 0xee, 0x23, 0x2f, 0x36, 0x97, 0xb6, 0x73, 0x5b, 0xf6, 0xe7, 0x8a, 0x2d},
+     {0xa6, 0xff, 0xd9, 0xa9, 0xdb, 0x4d, 0x24, 0x44, 0x5d, 0x58, 0x24, 0x8b, 0x4c, 0x2f, 0x54, 0xa0,
+      0x7c, 0xea, 0xdc, 0x70, 0x57, 0x21, 0x02, 0x3a, 0xc6, 0x09, 0xdb, 0xca, 0xc9, 0x31, 0xe2, 0x21},
+     {0xc2, 0x56, 0xa0, 0x31, 0x01, 0xca, 0x79, 0x06, 0xc5, 0x65, 0x56, 0x46, 0x67, 0x5d, 0xf5, 0xb8,
+      0xd6, 0x23, 0x47, 0xfe, 0x4a, 0x1c, 0x7d, 0x80, 0x6d, 0xb2, 0x13, 0xdd, 0x12, 0x14, 0xb1, 0x66}},
+    {{0x7e, 0xe4, 0x3e, 0xc6, 0xa6, 0x7b, 0xc8, 0x8e, 0x0b, 0x24, 0x85, 0x03, 0xa0, 0x01, 0x19, 0x58,
+      0x66, 0x67, 0xbc, 0x92, 0x3c, 0x57, 0x97, 0x06, 0xfa, 0x96, 0xf0, 0xa3, 0xef, 0x99, 0x5a, 0x19},
+     {0xbf, 0x96, 0x10, 0x74, 0xb5, 0x9a, 0x21, 0x8f, 0x4a, 0xbd, 0x62, 0x8e, 0x41, 0x0e, 0xb3, 0xa3,
+      0x78, 0x5e, 0xb7, 0x78, 0xa4, 0x7c, 0xe0, 0x00, 0x15, 0x29, 0x79, 0x52, 0x1c, 0x01, 0xb0, 0x72},
+     {0x12, 0x89, 0x9f, 0x57, 0x2a, 0xe5, 0x74, 0xaf, 0x7a, 0x0a, 0x1c, 0xb1, 0x1a, 0xd9, 0x22, 0x04,
+      0x37, 0x9f, 0xd1, 0x1f, 0xbd, 0xb9, 0xc7, 0x06, 0x8d, 0x12, 0x73, 0x57, 0x5c, 0x6b, 0x65, 0x2c}},
+    {{0xf5, 0xcc, 0xa8, 0x27, 0x7f, 0x1e, 0xa4, 0xa9, 0xa3, 0x18, 0x45, 0x81, 0x0b, 0x99, 0xc0, 0x42,
+      0x00, 0x50, 0x04, 0xf8, 0x3b, 0x7a, 0xef, 0x4f, 0xca, 0xb6, 0xb9, 0x99, 0xf2, 0x5a, 0xd6, 0x0b},
+     {0x80, 0x23, 0x9e, 0x45, 0x2d, 0x3b, 0xe5, 0x41, 0xe6, 0xf7, 0xf5, 0x15, 0xb2, 0x3e, 0x8e, 0xfb,
+      0xa1, 0xb0, 0xca, 0xfa, 0x0f, 0x04, 0xdc, 0xbc, 0xec, 0xe8, 0xa7, 0x0e, 0xa4, 0x8f, 0x6b, 0x0b},
+     {0x1a, 0xee, 0x7d, 0xe2, 0x0c, 0x13, 0xe5, 0x29, 0x26, 0xb1, 0x51, 0xfa, 0xdb, 0x20, 0x94, 0x6b,
+      0x40, 0x7d, 0x9b, 0xef, 0x2a, 0x17, 0xf7, 0x1a, 0x6f, 0x2d, 0xb7, 0x9d, 0x91, 0xdc, 0x38, 0x3f}},
+    {{0x61, 0x07, 0xb1, 0x5a, 0x47, 0xd8, 0x7e, 0xe5, 0x46, 0x37, 0xd1, 0x6f, 0x20, 0x5e, 0x43, 0x71,
+      0x32, 0x56, 0x02, 0xcd, 0x4e, 0x82, 0x2f, 0x34, 0x7b, 0x1e, 0x79, 0xa8, 0x1e, 0x28, 0x16, 0x4b},
+     {0xa1, 0x37, 0xde, 0x62, 0x90, 0xaa, 0xc5, 0x84, 0xe1, 0x96, 0x1d, 0x0d, 0x00, 0xa5, 0x1d, 0x42,
+      0xd9, 0x42, 0x92, 0x6a, 0x30, 0x86, 0x82, 0x78, 0xda, 0x10, 0x0d, 0x69, 0x4a, 0x46, 0x5e, 0x3c},
+     {0x81, 0x33, 0x81, 0x0b, 0xd5, 0x01, 0xc1, 0xd1, 0x28, 0x68, 0xee, 0x76, 0x11, 0x0f, 0xe6, 0xde,
+      0x09, 0x64, 0x3f, 0x38, 0x93, 0x88, 0xb6, 0x0c, 0x4a, 0x48, 0xff, 0xf6, 0x65, 0xc5, 0x83, 0x61}},
+    {{0xb2, 0xfb, 0xac, 0x30, 0xf0, 0xc9, 0xc7, 0x8e, 0x12, 0xc6, 0x7f, 0xc4, 0x33, 0xd8, 0x39, 0x29,
+      0x90, 0xd5, 0x68, 0x2b, 0x59, 0x14, 0x4d, 0xc9, 0x42, 0x21, 0x1d, 0xf1, 0x0b, 0xbf, 0x0b, 0x6e},
+     {0x37, 0x85, 0xf4, 0xd4, 0xaf, 0x35, 0x4c, 0x5d, 0x14, 0x84, 0xee, 0x4a, 0xf9, 0x40, 0x24, 0x51,
+      0x14, 0xf8, 0x85, 0xd0, 0x36, 0x7c, 0xed, 0xf0, 0x12, 0xea, 0x25, 0xf9, 0xb6, 0xdb, 0x47, 0x30},
+     {0xcc, 0xfd, 0x08, 0x03, 0x76, 0x55, 0xa9, 0x5a, 0x2b, 0xf2, 0x5a, 0x62, 0xef, 0x35, 0xdb, 0x81,
+      0x27, 0x05, 0x03, 0x2c, 0xed, 0x04, 0x4c, 0x91, 0xd2, 0xcb, 0x2a, 0xab, 0xf1, 0x20, 0xc0, 0x33}},
+    {{0xbf, 0xc4, 0x38, 0x53, 0xfb, 0x68, 0xa9, 0x77, 0xce, 0x55, 0xf9, 0x05, 0xcb, 0xeb, 0xfb, 0x8c,
+      0x46, 0xc2, 0x32, 0x7c, 0xf0, 0xdb, 0xd7, 0x2c, 0x62, 0x8e, 0xdd, 0x54, 0x75, 0xcf, 0x3f, 0x33},
+     {0x49, 0x50, 0x1f, 0x4e, 0x6e, 0x55, 0x55, 0xde, 0x8c, 0x4e, 0x77, 0x96, 0x38, 0x3b, 0xfe, 0xb6,
+      0x43, 0x3c, 0x86, 0x69, 0xc2, 0x72, 0x66, 0x1f, 0x6b, 0xf9, 0x87, 0xbc, 0x4f, 0x37, 0x3e, 0x3c},
+     {0xd2, 0x2f, 0x06, 0x6b, 0x08, 0x07, 0x69, 0x77, 0xc0, 0x94, 0xcc, 0xae, 0x43, 0x00, 0x59, 0x6e,
+      0xa3, 0x63, 0xa8, 0xdd, 0xfa, 0x24, 0x18, 0xd0, 0x35, 0xc7, 0x78, 0xf7, 0x0d, 0xd4, 0x5a, 0x1e}},
+    {{0x5b, 0xad, 0xc9, 0xd2, 0x4c, 0x1d, 0x2b, 0xf8, 0x58, 0x92, 0x5b, 0x94, 0x51, 0x1a, 0x45, 0x8d,
+      0x79, 0x69, 0xfa, 0xdd, 0x24, 0x81, 0x56, 0x57, 0x3f, 0xa8, 0x53, 0x47, 0x37, 0x6f, 0xd1, 0x56},
+     {0x92, 0xc5, 0xfd, 0x77, 0x81, 0x32, 0xf3, 0xba, 0x63, 0xd0, 0xf5, 0xad, 0x86, 0xd2, 0x97, 0x62,
+      0x77, 0x3f, 0x51, 0xe8, 0xc0, 0x53, 0x19, 0xa8, 0x71, 0x9d, 0x70, 0xac, 0xc2, 0x2d, 0x0b, 0x3a},
+     {0x9f, 0xdc, 0xc1, 0x4c, 0x78, 0x33, 0xe4, 0x5e, 0x7a, 0x17, 0x6b, 0xbf, 0x67, 0x96, 0xed, 0x9c,
+      0x38, 0x19, 0x5d, 0x65, 0x4c, 0x2a, 0x39, 0x9c, 0xa7, 0xc8, 0x17, 0x9f, 0x20, 0x3a, 0x28, 0x4e}},
+    {{0x9d, 0xe7, 0x1e, 0x4c, 0x7e, 0x3a, 0x66, 0x8d, 0x4c, 0x62, 0x3c, 0xf4, 0x24, 0x6b, 0x9a, 0xe4,
+      0xb6, 0x77, 0x29, 0x37, 0x04, 0x2f, 0x63, 0x53, 0xe7, 0x7a, 0xbf, 0x37, 0x5b, 0x44, 0xec, 0x52},
+     {0x8b, 0x75, 0x10, 0x21, 0x29, 0xff, 0x16, 0x2e, 0x09, 0x48, 0x2f, 0x2d, 0xe3, 0x7b, 0x54, 0x38,
+      0x43, 0xdb, 0x64, 0xc5, 0x1c, 0xbb, 0x19, 0x8b, 0xc4, 0x17, 0x43, 0xaf, 0x82, 0xad, 0xac, 0x56},
+     {0xda, 0x94, 0xac, 0xcc, 0xda, 0x49, 0xf1, 0x43, 0xbb, 0x34, 0xdf, 0x54, 0x46, 0x5b, 0x04, 0x17,
+      0xb4, 0x6d, 0xff, 0x0e, 0x12, 0x80, 0xd0, 0xd1, 0xa0, 0x8c, 0x2e, 0xdf, 0x16, 0x78, 0xb1, 0x15}},
+    {{0xa1, 0xe5, 0xb8, 0x50, 0xb4, 0xbf, 0x6d, 0xbe, 0x2f, 0xae, 0x6e, 0xe0, 0xef, 0xe3, 0x35, 0x57,
+      0x93, 0x52, 0x07, 0x45, 0xbb, 0x16, 0xbf, 0x0d, 0x97, 0xea, 0x0f, 0x01, 0xb9, 0x5c, 0xb2, 0x73},
+     {0x5c, 0x16, 0x2d, 0x31, 0xf4, 0x6f, 0xb0, 0x28, 0xd0, 0x80, 0xaf, 0x7d, 0xf5, 0x1f, 0xfd, 0x3b,
+      0x50, 0xc6, 0x3c, 0x28, 0xee, 0x8e, 0xd6, 0xfb, 0x38, 0x26, 0x46, 0x7c, 0x71, 0xbe, 0x4c, 0x14},
+     {0x19, 0xda, 0x23, 0xe8, 0xb5, 0xb6, 0xa9, 0x7c, 0x67, 0x94, 0xb8, 0x41, 0x37, 0x8e, 0xb3, 0xed,
+      0x8c, 0x12, 0x17, 0xbf, 0x90, 0x2b, 0x18, 0x86, 0x21, 0x86, 0xd4, 0x13, 0x17, 0x79, 0xce, 0x1d}},
+    {{0x4f, 0x62, 0x90, 0x50, 0x81, 0x70, 0x0a, 0x45, 0x49, 0x92, 0xde, 0x8c, 0xeb, 0xae, 0x86, 0xcc,
+      0xca, 0x70, 0x55, 0x64, 0xcb, 0x5c, 0x40, 0xa0, 0x06, 0xaf, 0xf9, 0x92, 0xc5, 0x0a, 0x3f, 0x67},
+     {0x2f, 0xf4, 0x7f, 0x6d, 0x47, 0xf5, 0x37, 0xc1, 0x7d, 0xc2, 0x96, 0xeb, 0x02, 0x76, 0x08, 0x25,
+      0x38, 0x1e, 0x45, 0x3c, 0x65, 0x6a, 0xc3, 0x24, 0x4d, 0x09, 0x41, 0xf2, 0x4e, 0x0f, 0xbb, 0x3a},
+     {0x07, 0x5c, 0xda, 0x13, 0x42, 0xf1, 0x89, 0xda, 0x4d, 0x04, 0x84, 0x14, 0xbd, 0x12, 0x72, 0x07,
+      0x43, 0xb0, 0x49, 0xf2, 0xd6, 0x6b, 0xcb, 0x00, 0x42, 0x33, 0xd4, 0xa5, 0xc1, 0xa8, 0x0d, 0x21}},
+    {{0x4c, 0xe4, 0xed, 0x77, 0xd2, 0xc8, 0x96, 0x1b, 0x8f, 0x42, 0xc7, 0x51, 0x6f, 0x5f, 0x36, 0xa6,
+      0xd9, 0x83, 0xa2, 0x20, 0x11, 0x23, 0x3f, 0xc3, 0xc3, 0x06, 0x8e, 0x18, 0xaf, 0xf6, 0x0b, 0x23},
+     {0x70, 0xb6, 0xc8, 0x4a, 0xd5, 0xb7, 0x33, 0x3b, 0x11, 0x99, 0xe3, 0x4e, 0x0a, 0x42, 0x91, 0x48,
+      0xee, 0x20, 0x68, 0x34, 0x4a, 0x29, 0xd0, 0x21, 0xc0, 0x7b, 0x1b, 0x26, 0xd5, 0x0c, 0xfa, 0x28},
+     {0x3d, 0x52, 0xea, 0x64, 0x62, 0x8b, 0xc5, 0xfc, 0x70, 0xc0, 0xc2, 0x6d, 0x0f, 0x42, 0xf1, 0x2c,
+      0x13, 0xb2, 0x8f, 0x21, 0x96, 0xed, 0x29, 0x14, 0xc5, 0x1d, 0xc4, 0x92, 0xab, 0xe8, 0x88, 0x48}},
+    {{0x0d, 0x91, 0xe5, 0xf5, 0x66, 0x38, 0x7e, 0x61, 0x71, 0x28, 0x4b, 0xab, 0xe6, 0xf4, 0x18, 0x3c,
+      0x78, 0xbb, 0x2b, 0x70, 0xfa, 0x4f, 0xa2, 0x82, 0x7d, 0x66, 0x0e, 0x6a, 0x42, 0x60, 0xb4, 0x33},
+     {0x3b, 0xc0, 0xa6, 0x13, 0x87, 0x56, 0xa2, 0x4d, 0xd4, 0x67, 0x7a, 0x1e, 0x2e, 0xce, 0xf5, 0x77,
+      0x1d, 0xf2, 0xf5, 0x15, 0x2c, 0xf7, 0xe9, 0x2b, 0xa3, 0xeb, 0x5b, 0x07, 0x6c, 0xc2, 0x24, 0x02},
+     {0xbc, 0x85, 0x60, 0x24, 0x6d, 0xe5, 0xbf, 0x60, 0x91, 0xb9, 0x6d, 0xc2, 0x62, 0x4c, 0xb9, 0xd9,
+      0x9a, 0x18, 0x1e, 0x0d, 0x6a, 0x91, 0xf2, 0x1b, 0xf8, 0xa3, 0xb6, 0xff, 0x80, 0x36, 0xd0, 0x50}},
+    {{0x56, 0xf5, 0x58, 0x88, 0xb2, 0xf5, 0x01, 0x0a, 0x31, 0x2f, 0x19, 0x9c, 0xa7, 0x5f, 0x2f, 0x85,
+      0x6d, 0x91, 0x7b, 0x07, 0x59, 0xde, 0xf7, 0x49, 0xc7, 0x6c, 0xfe, 0x0a, 0xf6, 0x6c, 0xd6, 0x65},
+     {0xa6, 0x74, 0xcb, 0xa4, 0x68, 0x93, 0xf3, 0x60, 0x00, 0xaa, 0x0c, 0x14, 0x8f, 0x5c, 0xb8, 0x39,
+      0x99, 0xcb, 0xae, 0x27, 0x6e, 0x2a, 0x07, 0xf0, 0xc7, 0xfb, 0xc5, 0x78, 0xc2, 0xee, 0x27, 0x56},
+     {0x87, 0x97, 0xc8, 0x61, 0x10, 0x60, 0x66, 0x51, 0x5c, 0x77, 0xf9, 0xaf, 0xbd, 0x84, 0x06, 0xbf,
+      0x97, 0x28, 0xb4, 0xe5, 0x71, 0xc4, 0xe4, 0x61, 0xc5, 0x7a, 0x7c, 0xb8, 0x70, 0xb8, 0xda, 0x2f}},
+    {{0x45, 0xc1, 0x17, 0x51, 0xf8, 0xed, 0x7e, 0xc7, 0xa9, 0x1a, 0x11, 0x6e, 0x2d, 0xef, 0x0b, 0xd5,
+      0x3f, 0x98, 0xb0, 0xa3, 0x9d, 0x65, 0xf1, 0xcd, 0x53, 0x4a, 0x8a, 0x18, 0x70, 0x0a, 0x7f, 0x23},
+     {0xdd, 0xef, 0xbe, 0x3a, 0x31, 0xe0, 0xbc, 0xbe, 0x6d, 0x5d, 0x79, 0x87, 0xd6, 0xbe, 0x68, 0xe3,
+      0x59, 0x76, 0x8c, 0x86, 0x0e, 0x7a, 0x92, 0x13, 0x14, 0x8f, 0x67, 0xb3, 0xcb, 0x1a, 0x76, 0x76},
+     {0x56, 0x7a, 0x1c, 0x9d, 0xca, 0x96, 0xf9, 0xf9, 0x03, 0x21, 0xd4, 0xe8, 0xb3, 0xd5, 0xe9, 0x52,
+      0xc8, 0x54, 0x1e, 0x1b, 0x13, 0xb6, 0xfd, 0x47, 0x7d, 0x02, 0x32, 0x33, 0x27, 0xe2, 0x1f, 0x19}},
+    {{0x77, 0x17, 0x5d, 0x62, 0x7a, 0xbc, 0x6b, 0x5d, 0x1b, 0xb0, 0xc5, 0x51, 0xf8, 0x42, 0xb6, 0x31,
+      0x7d, 0xef, 0x4c, 0x37, 0x18, 0xaf, 0xac, 0xb7, 0xcd, 0x65, 0x3d, 0xe7, 0xc8, 0x44, 0x81, 0x15},
+     {0x27, 0xce, 0xeb, 0xaa, 0xbc, 0x48, 0x10, 0xc0, 0x55, 0x22, 0x05, 0xfd, 0xc9, 0xa5, 0x77, 0xe7,
+      0x71, 0x5f, 0xe1, 0x70, 0x1c, 0x84, 0x4c, 0xeb, 0x2f, 0xb2, 0x67, 0x09, 0x43, 0xc1, 0x6b, 0x54},
+     {0xf0, 0xb7, 0x85, 0x50, 0x4c, 0x4d, 0xdd, 0xc5, 0x21, 0x6c, 0x27, 0x96, 0xd6, 0xb0, 0x56, 0xab,
+      0x3c, 0x2e, 0x1a, 0x55, 0x76, 0xef, 0x69, 0xf6, 0xea, 0x88, 0xa3, 0x12, 0xf3, 0x19, 0x1e, 0x39}},
+    {{0x51, 0x30, 0x54, 0x79, 0xd6, 0x48, 0xed, 0x78, 0x02, 0x58, 0x1f, 0x8d, 0x5e, 0x41, 0x81, 0x98,
+      0x4e, 0x5e, 0x7e, 0xef, 0xa8, 0x02, 0x1a, 0x1c, 0xf7, 0xd1, 0x92, 0x8a, 0xd2, 0xb6, 0x07, 0x17},
+     {0x00, 0xde, 0xcc, 0x34, 0x94, 0x23, 0xeb, 0x7f, 0xd1, 0x98, 0xc8, 0x08, 0x0c, 0x82, 0xb6, 0xe0,
+      0x3f, 0x68, 0xde, 0x84, 0xe5, 0x4f, 0x15, 0xc8, 0xe1, 0x8a, 0x99, 0x3b, 0xe7, 0xcb, 0xf3, 0x0b},
+     {0xc9, 0x3d, 0x96, 0xf5, 0xdd, 0x72, 0x59, 0xf2, 0xc1, 0x9c, 0xe3, 0xb8, 0xb3, 0x1b, 0x2f, 0x72,
+      0x71, 0xf9, 0x05, 0x51, 0xe6, 0xe4, 0x1d, 0xae, 0x07, 0xf0, 0x14, 0x65, 0xd0, 0xb0, 0x25, 0x1d}},
+    {{0xec, 0xab, 0x36, 0xe9, 0x4a, 0xcd, 0xe6, 0xea, 0xc8, 0x24, 0x8f, 0xa1, 0x56, 0x28, 0x93, 0xcc,
+      0x88, 0x59, 0x71, 0x12, 0x14, 0x63, 0x1d, 0x10, 0x5c, 0xfa, 0x1d, 0x06, 0x3c, 0xe6, 0x12, 0x35},
+     {0x49, 0x90, 0x5e, 0xd3, 0x63, 0x0b, 0x1a, 0x58, 0x27, 0xc8, 0x4d, 0xda, 0x58, 0xd0, 0x5c, 0x3a,
+      0xe9, 0xa8, 0x8d, 0xb3, 0xef, 0x47, 0xc3, 0xe7, 0xc2, 0x32, 0x61, 0xa2, 0xb4, 0x63, 0x4a, 0x3f},
+     {0x75, 0xbe, 0x10, 0x35, 0xa3, 0x17, 0x74, 0x92, 0x91, 0x4c, 0x3c, 0xf9, 0x78, 0xeb, 0x8d, 0x39,
+      0x3f, 0x4b, 0xaa, 0x12, 0x2e, 0x8e, 0xfe, 0x1b, 0x7c, 0x6c, 0x3d, 0x38, 0xee, 0x30, 0x18, 0x06}},
+    {{0xfd, 0x89, 0x21, 0x41, 0x73, 0xd7, 0xbb, 0xe2, 0x6f, 0x64, 0x2b, 0x81, 0xc5, 0x7f, 0x03, 0xac,
+      0x8e, 0x40, 0x7c, 0x7c, 0x15, 0x5f, 0x7f, 0xb7, 0xf9, 0x24, 0x7b, 0x53, 0xbe, 0x50, 0xcd, 0x30},
+     {0x9d, 0x58, 0x18, 0x89, 0xda, 0x18, 0x56, 0x4a, 0x2a, 0x7a, 0x3c, 0xf3, 0x8c, 0x6d, 0xc1, 0x62,
+      0x26, 0x80, 0x23, 0x21, 0x92, 0x3c, 0xc1, 0xb9, 0x3e, 0xd9, 0x6a, 0x06, 0x90, 0x4d, 0x26, 0x03},
+     {0xd2, 0x2b, 0xa0, 0xe4, 0x57, 0x50, 0xc3, 0x49, 0xea, 0x54, 0x7a, 0xe2, 0xa7, 0x75, 0x92, 0x9b,
+      0x76, 0x17, 0x9e, 0xb0, 0x53, 0x4e, 0x4c, 0x96, 0x12, 0x67, 0xc6, 0xf1, 0xa2, 0x74, 0xf1, 0x2e}},
+    {{0x16, 0x60, 0x64, 0xbc, 0xc6, 0x5b, 0x8e, 0x2a, 0x8e, 0x09, 0xe1, 0xd9, 0x95, 0x7f, 0x80, 0xb5,
+      0x24, 0xed, 0x5c, 0x24, 0x13, 0x6c, 0x48, 0xb7, 0xfd, 0x52, 0x3d, 0x48, 0x5d, 0x7a, 0x0f, 0x36},
+     {0xc7, 0x3d, 0x2b, 0x10, 0x70, 0x1d, 0xaf, 0x73, 0x39, 0x6c, 0xf3, 0x2b, 0x08, 0xae, 0xa8, 0x3f,
+      0xd0, 0xd8, 0x1a, 0xae, 0x99, 0xdf, 0x8d, 0x43, 0xbc, 0xb2, 0x11, 0x09, 0xaf, 0x9d, 0x42, 0x49},
+     {0x03, 0x33, 0x72, 0xb0, 0x63, 0xda, 0x79, 0x40, 0x65, 0x20, 0x1f, 0x2c, 0xaa, 0x23, 0x1c, 0x58,
+      0xc1, 0x11, 0xa8, 0x2b, 0x32, 0x96, 0xe8, 0xad, 0x6d, 0xa6, 0x9d, 0xf3, 0xc0, 0xed, 0xaa, 0x2a}},
+    {{0xe3, 0xcd, 0xbe, 0x37, 0x93, 0xdb, 0x27, 0xa7, 0x14, 0x82, 0xb9, 0x62, 0x87, 0x73, 0x62, 0xf5,
+      0x0b, 0xda, 0x07, 0x41, 0x89, 0x54, 0x03, 0x1c, 0x28, 0x62, 0x53, 0x2f, 0x40, 0x49, 0x7f, 0x1a},
+     {0xd7, 0xaa, 0xba, 0xbb, 0x51, 0x27, 0xbb, 0xf7, 0xa3, 0x30, 0x94, 0x52, 0x20, 0x37, 0x21, 0x90,
+      0x15, 0x75, 0x16, 0x54, 0xeb, 0x3f, 0xd7, 0x86, 0x3e, 0xfc, 0x3b, 0x18, 0x43, 0x0d, 0xfc, 0x64},
+     {0x91, 0xf0, 0x0c, 0xb3, 0xd0, 0xac, 0x6a, 0x64, 0x4c, 0x0f, 0xab, 0x96, 0x13, 0x31, 0x27, 0x08,
+      0x00, 0xb2, 0x42, 0xc1, 0x00, 0x4d, 0x59, 0x39, 0x96, 0x1a, 0xeb, 0xed, 0x14, 0xfa, 0xbf, 0x64}},
+    {{0x2b, 0x95, 0x17, 0x6f, 0xf5, 0x1b, 0xfd, 0x74, 0x43, 0xb5, 0xf2, 0x4c, 0xc5, 0x39, 0x48, 0xe3,
+      0x49, 0x12, 0x88, 0xf4, 0xbf, 0xf9, 0x57, 0x7e, 0x8a, 0x42, 0x43, 0x62, 0x4a, 0x07, 0xd2, 0x2c},
+     {0x07, 0x29, 0xf8, 0x82, 0x81, 0xb6, 0x75, 0x93, 0xda, 0x46, 0x55, 0xa0, 0xc6, 0x01, 0x7c, 0x20,
+      0x12, 0xae, 0x60, 0x42, 0x63, 0x8a, 0xa7, 0x92, 0xe7, 0x01, 0xa7, 0x24, 0xf0, 0x49, 0xc6, 0x1d},
+     {0xa9, 0x95, 0xfd, 0x75, 0xbf, 0x7b, 0x0d, 0xca, 0x5c, 0x07, 0xfc, 0xc6, 0x73, 0xcb, 0x82, 0x54,
+      0x99, 0xad, 0x5f, 0x55, 0xf6, 0x75, 0x62, 0x3c, 0xe0, 0xad, 0x8f, 0x50, 0x12, 0xf8, 0x18, 0x34}},
+    {{0x82, 0xb7, 0x72, 0x96, 0x48, 0x85, 0x2e, 0x8e, 0xfa, 0x2d, 0x97, 0x6a, 0x69, 0x2e, 0xec, 0x2c,
+      0xcb, 0x29, 0x95, 0xd2, 0x8a, 0xdd, 0xca, 0xc7, 0xed, 0x0b, 0xb3, 0x6a, 0x44, 0xb7, 0x43, 0x77},
+     {0x4c, 0xdc, 0x50, 0xec, 0x5e, 0x99, 0x57, 0x71, 0x8c, 0x3c, 0x26, 0x96, 0xcf, 0x88, 0x63, 0xa0,
+      0x06, 0xfb, 0x73, 0xcf, 0x35, 0x52, 0x93, 0xbc, 0xa5, 0x94, 0xb6, 0x07, 0x12, 0x3d, 0x38, 0x21},
+     {0x7e, 0x80, 0x00, 0x34, 0xf0, 0x25, 0xbb, 0xf5, 0x45, 0x04, 0x96, 0x23, 0x8c, 0x62, 0xdc, 0x6f,
+      0x47, 0xd1, 0x9a, 0xf8, 0x26, 0x82, 0x0c, 0xa4, 0x89, 0xfd, 0x2e, 0x5a, 0x27, 0xae, 0x16, 0x27}},
+    {{0xae, 0x70, 0x19, 0xf7, 0xbd, 0xad, 0xd1, 0x56, 0x8e, 0x57, 0xf9, 0xcf, 0xb8, 0xf0, 0xb2, 0x3e,
+      0xb2, 0x4b, 0x5d, 0x2d, 0xbe, 0x02, 0x11, 0x53, 0x8e, 0x99, 0x93, 0x1d, 0x96, 0xa0, 0x7e, 0x6c},
+     {0x25, 0x63, 0xa8, 0x6b, 0x5b, 0x6f, 0x34, 0x3a, 0x71, 0x2a, 0x21, 0xe1, 0x13, 0x77, 0x8e, 0xe4,
+      0x28, 0x9e, 0x21, 0x6b, 0xfa, 0x8c, 0xb1, 0xe2, 0x5b, 0x07, 0xd5, 0x27, 0x6a, 0x85, 0xff, 0x30},
+     {0x55, 0xe8, 0xb1, 0x8f, 0xed, 0x36, 0x4d, 0x2e, 0x6d, 0x90, 0x5f, 0xdb, 0x2d, 0x7e, 0x2a, 0x1d,
+      0x22, 0xf2, 0x37, 0x5f, 0x59, 0x76, 0xeb, 0x38, 0xb6, 0x9f, 0x68, 0x4d, 0x55, 0x6d, 0x49, 0x30}},
+    {{0xcf, 0x3b, 0x90, 0x33, 0xc3, 0x64, 0x88, 0xbb, 0x9f, 0xa3, 0x06, 0x94, 0xf6, 0xa8, 0x63, 0x07,
+      0x5f, 0x66, 0x76, 0x00, 0x5f, 0x0a, 0x05, 0x18, 0xec, 0xaa, 0x7e, 0x55, 0xa2, 0x7f, 0xc7, 0x42},
+     {0xc8, 0x9e, 0x0f, 0x04, 0x08, 0x20, 0x07, 0xc2, 0x68, 0xc9, 0xd7, 0xf7, 0x6f, 0x4a, 0x72, 0xbf,
+      0x06, 0xec, 0x30, 0x1d, 0x40, 0xd7, 0x8e, 0x7d, 0x2e, 0x88, 0xc1, 0x77, 0xca, 0xdc, 0x69, 0x4c},
+     {0xf4, 0x52, 0xa4, 0xf8, 0x00, 0xc4, 0xde, 0x1c, 0x23, 0x04, 0x5d, 0x5d, 0x1f, 0x95, 0x79, 0x1b,
+      0xa6, 0x12, 0xfe, 0x7f, 0xa1, 0xa9, 0x40, 0x72, 0xac, 0x31, 0x91, 0x11, 0xf4, 0xaf, 0x11, 0x23}},
+    {{0x86, 0xd0, 0x4d, 0x1e, 0x11, 0xbd, 0xef, 0xb0, 0xc6, 0xd2, 0xe4, 0x73, 0xeb, 0x86, 0xa4, 0x71,
+      0x04, 0xbd, 0x13, 0xf1, 0xf1, 0x6b, 0xbe, 0xa3, 0xaf, 0x9d, 0x52, 0x8e, 0x48, 0x93, 0x8f, 0x74},
+     {0xec, 0x5d, 0xe9, 0xd1, 0x45, 0x8d, 0x32, 0xc0, 0xfc, 0x05, 0x4f, 0x93, 0xe3, 0xd8, 0x25, 0xca,
+      0x8e, 0x60, 0xf2, 0xc3, 0xf2, 0x46, 0x72, 0x10, 0xd1, 0x94, 0x14, 0xeb, 0xb6, 0xde, 0x2c, 0x7a},
+     {0xc8, 0x7b, 0xd9, 0xe4, 0xfc, 0x86, 0x7e, 0x4a, 0xba, 0x14, 0x9b, 0xe3, 0x68, 0xc2, 0x03, 0x6a,
+      0x58, 0x12, 0x69, 0x65, 0xe9, 0x0c, 0x3c, 0x29, 0x91, 0xa3, 0x40, 0x98, 0xfc, 0x02, 0x6a, 0x5d}},
+    {{0x00, 0x35, 0x5f, 0xff, 0x4e, 0xa6, 0x44, 0xc7, 0xd9, 0xcf, 0x26, 0x5f, 0x42, 0x42, 0x4a, 0xfd,
+      0x61, 0x3d, 0xde, 0xb4, 0xf4, 0xdb, 0xa5, 0xd0, 0xd1, 0xaf, 0x40, 0xf9, 0x69, 0x8b, 0xc8, 0x1b},
+     {0xc0, 0x16, 0x8a, 0x24, 0xa8, 0xd5, 0x12, 0xcf, 0x1d, 0xd7, 0x58, 0xaa, 0xd7, 0xad, 0xb9, 0x52,
+      0x73, 0x38, 0x62, 0x03, 0x9c, 0xe0, 0x48, 0x0d, 0x71, 0x08, 0x3a, 0xd7, 0x09, 0xb9, 0x5f, 0x08},
+     {0x2d, 0x2a, 0xda, 0x4c, 0x1a, 0x63, 0xc2, 0x1e, 0xbd, 0x17, 0xfa, 0x9a, 0xa8, 0x0f, 0x65, 0x94,
+      0x68, 0xdb, 0x99, 0xfc, 0x2b, 0x64, 0xab, 0x5c, 0x5d, 0x56, 0xc3, 0x04, 0x1e, 0x4c, 0x8a, 0x4a}},
+    {{0xb1, 0x8e, 0x25, 0x35, 0x00, 0x4b, 0xe9, 0x29, 0xfa, 0x69, 0xb9, 0x39, 0x2f, 0xb1, 0xe6, 0x18,
+      0xe5, 0xbc, 0x1f, 0x11, 0x3e, 0xb6, 0xb6, 0x1e, 0x70, 0xc2, 0x5a, 0xc9, 0xec, 0x80, 0x90, 0x2a},
+     {0x32, 0xc3, 0x5e, 0x2f, 0x9e, 0x60, 0x45, 0xf2, 0x7b, 0x77, 0x3b, 0xa7, 0xb7, 0xac, 0xb0, 0xa0,
+      0x9b, 0x03, 0x4c, 0x6a, 0x5b, 0x8f, 0x04, 0x81, 0xc8, 0xfa, 0x2e, 0x57, 0xbb, 0xe2, 0x63, 0x06},
+     {0x95, 0x19, 0xdb, 0x59, 0xcb, 0xf0, 0x53, 0xef, 0xc5, 0x7e, 0x90, 0xc2, 0x27, 0xa9, 0x71, 0xf5,
+      0x6a, 0xf7, 0xb9, 0x94, 0xbc, 0x2f, 0x29, 0xa3, 0xaf, 0x2c, 0x49, 0xdc, 0x5b, 0xa6, 0xbd, 0x12}},
+    {{0x5d, 0x16, 0x77, 0xe2, 0x50, 0xe2, 0xe7, 0x76, 0xea, 0x43, 0x7f, 0x05, 0xca, 0x4e, 0xbf, 0xbb,
+      0x0c, 0x8d, 0xe9, 0xec, 0xb9, 0xea, 0x52, 0x9f, 0x61, 0xca, 0xa7, 0x58, 0x7d, 0xd7, 0xfc, 0x02},
+     {0x03, 0x4d, 0x13, 0xbf, 0xf0, 0xac, 0xab, 0xe9, 0x36, 0x26, 0x2c, 0xdb, 0xf1, 0x36, 0xbf, 0x5c,
+      0x1f, 0x32, 0xc4, 0xd1, 0xf9, 0x92, 0x3e, 0x1b, 0x18, 0xbb, 0xdc, 0x29, 0xd6, 0x8b, 0x01, 0x7f},
+     {0x44, 0x0c, 0x9b, 0x3f, 0xd7, 0x0b, 0xc2, 0xda, 0xd5, 0x67, 0xb0, 0x32, 0x43, 0xec, 0xbb, 0xfe,
+      0x17, 0x25, 0xed, 0xce, 0x3a, 0x18, 0x0f, 0x86, 0x9e, 0x44, 0xad, 0x74, 0x57, 0x63, 0x15, 0x1b}},
+    {{0x1d, 0xb8, 0xc5, 0x7c, 0xab, 0x98, 0xfd, 0xb5, 0x7a, 0x04, 0xc4, 0x0b, 0xad, 0xd7, 0xb4, 0x27,
+      0x41, 0x6d, 0x99, 0x6a, 0x38, 0xb0, 0xfc, 0x2a, 0x3d, 0x2e, 0x1d, 0x34, 0x76, 0x7d, 0xe1, 0x70},
+     {0x99, 0x2a, 0x21, 0x8b, 0xf7, 0x7a, 0x1c, 0x32, 0x8d, 0xb8, 0x71, 0x4e, 0x00, 0xd9, 0x0f, 0xcc,
+      0x55, 0xc2, 0x58, 0xce, 0xc3, 0xe8, 0xca, 0x1a, 0x23, 0xe5, 0x21, 0xb0, 0x54, 0x82, 0x0a, 0x6d},
+     {0xfc, 0xd3, 0x4c, 0xf4, 0x1a, 0x2d, 0xee, 0x4d, 0xa8, 0x95, 0xff, 0xdf, 0xa1, 0x0f, 0x93, 0x1b,
+      0xad, 0xa1, 0x2d, 0x51, 0x15, 0xba, 0x8c, 0x5f, 0xb0, 0x6b, 0xef, 0xf2, 0x27, 0x8a, 0x2a, 0x5f}},
+    {{0x59, 0xe7, 0xbd, 0x68, 0x56, 0x94, 0xe4, 0xa9, 0xba, 0x28, 0x8b, 0x70, 0x9a, 0xfa, 0xd4, 0x47,
+      0xea, 0x13, 0xba, 0x24, 0xe1, 0x68, 0xdf, 0xaf, 0xd3, 0xc4, 0x5a, 0x0d, 0xc1, 0x61, 0x5a, 0x2e},
+     {0x64, 0x02, 0x78, 0x7c, 0x26, 0xd1, 0xe4, 0x32, 0x44, 0x5c, 0xa8, 0xa5, 0xe3, 0xb5, 0x00, 0xef,
+      0xfb, 0x65, 0xff, 0x47, 0xb0, 0x63, 0xbb, 0x94, 0xaa, 0x88, 0x41, 0x1f, 0x96, 0xa7, 0x0b, 0x10},
+     {0x59, 0xe7, 0x3e, 0x04, 0xc1, 0x13, 0xb7, 0x75, 0x44, 0xe2, 0xc0, 0xf3, 0xce, 0xb2, 0x07, 0x28,
+      0x7e, 0xec, 0x71, 0x1e, 0x64, 0xbb, 0xe4, 0xf7, 0xf9, 0xd1, 0x2a, 0x1f, 0xad, 0xf7, 0x74, 0x2e}},
+    {{0xae, 0x6b, 0x7c, 0x98, 0x8c, 0xb4, 0x66, 0xc5, 0xd8, 0xa1, 0xa6, 0xe1, 0xa1, 0x71, 0xe5, 0xce,
+      0xef, 0x9a, 0x32, 0x1f, 0xf1, 0xca, 0xf3, 0x6e, 0x2d, 0xa1, 0x37, 0xff, 0x4b, 0x80, 0x51, 0x0c},
+     {0x41, 0xba, 0xda, 0x53, 0xc2, 0x91, 0xb3, 0xbd, 0x81, 0x27, 0x3f, 0x05, 0xfa, 0xab, 0x14, 0x37,
+      0xa8, 0x35, 0xec, 0x87, 0x44, 0x15, 0x15, 0x7b, 0x5a, 0x51, 0xe5, 0xd7, 0x17, 0x6c, 0x62, 0x2c},
+     {0x18, 0x82, 0xcc, 0xb5, 0x01, 0x1f, 0x29, 0x90, 0xeb, 0xc3, 0xa9, 0x4e, 0x45, 0x20, 0x9e, 0xbd,
+      0xf1, 0x30, 0x44, 0x85, 0x90, 0x0b, 0x40, 0xb5, 0x6b, 0x36, 0x0f, 0x71, 0xdb, 0xd3, 0x80, 0x7d}},
+    {{0x0b, 0xb7, 0x98, 0xbf, 0x6b, 0xcb, 0xe9, 0x73, 0xe7, 0x94, 0x53, 0xcb, 0x6b, 0x7e, 0x8c, 0x8e,
+      0xb1, 0x2c, 0xfe, 0x2d, 0x18, 0x4a, 0x13, 0xbb, 0xbb, 0x86, 0xbd, 0x4a, 0xf4, 0x29, 0x40, 0x4e},
+     {0x2b, 0xbd, 0x4c, 0xb6, 0xf5, 0xf8, 0x23, 0x94, 0x8f, 0x28, 0x3f, 0x66, 0x63, 0xe3, 0xc1, 0xdd,
+      0x26, 0xab, 0xe5, 0x7d, 0x3e, 0x14, 0xcf, 0xc8, 0x61, 0x56, 0xc9, 0xd1, 0x87, 0xe0, 0xed, 0x5e},
+     {0x31, 0x93, 0xbd, 0xb4, 0x5b, 0x48, 0xdb, 0x91, 0x3b, 0xfe, 0x8c, 0x40, 0xe7, 0x2b, 0xbe, 0x5a,
+      0xb7, 0x11, 0x15, 0x3e, 0xe0, 0xfa, 0x98, 0x82, 0x96, 0x5f, 0x15, 0xbf, 0x77, 0x53, 0x79, 0x1f}},
+    {{0xd8, 0x07, 0x5a, 0xa9, 0xdb, 0x65, 0x5a, 0x1e, 0xa4, 0xe6, 0x06, 0xb5, 0x69, 0xf1, 0x91, 0x00,
+      0xbe, 0x05, 0xf5, 0x1d, 0xdc, 0xc7, 0xd4, 0x1c, 0xd0, 0x4a, 0x57, 0x9c, 0xa7, 0x67, 0x40, 0x6b},
+     {0xad, 0x14, 0xc7, 0x5a, 0xcc, 0xf0, 0x33, 0x39, 0x6f, 0xfb, 0xfe, 0x63, 0xd6, 0x05, 0x48, 0x8f,
+      0xb1, 0x1f, 0x02, 0xa9, 0xdd, 0x5d, 0x24, 0xd1, 0xcf, 0xb4, 0x3b, 0x8f, 0xc5, 0x89, 0x1c, 0x26},
+     {0x88, 0x22, 0x82, 0x3f, 0x37, 0xb8, 0xda, 0x64, 0x41, 0x98, 0xeb, 0x76, 0x90, 0x25, 0xb2, 0x88,
+      0xba, 0x47, 0xc9, 0x93, 0xb5, 0xbf, 0x6b, 0xe8, 0x34, 0x76, 0xb8, 0x01, 0x19, 0x5c, 0x0b, 0x06}},
+    {{0xe7, 0x95, 0xe4, 0x06, 0x03, 0x12, 0xea, 0x92, 0x1c, 0xb7, 0x0e, 0x3b, 0xfb, 0x24, 0x6e, 0xe5,
+      0x39, 0x20, 0x6d, 0x39, 0x79, 0xf4, 0xd3, 0x92, 0xbb, 0x52, 0xb5, 0xeb, 0x54, 0x1d, 0x0d, 0x53},
+     {0x8f, 0x36, 0x35, 0x5d, 0x11, 0x0f, 0x31, 0xd1, 0x3b, 0x97, 0xf2, 0x33, 0xa3, 0xeb, 0x95, 0xb2,
+      0x52, 0xf7, 0x66, 0x4a, 0xa1, 0xbd, 0x34, 0xbd, 0x11, 0x4b, 0xe7, 0xa1, 0xf7, 0xae, 0x90, 0x53},
+     {0x43, 0xba, 0xe4, 0xd5, 0x18, 0x96, 0xd2, 0x03, 0x16, 0x61, 0xc0, 0x01, 0xcc, 0x27, 0xbb, 0x3d,
+      0x2f, 0xbf, 0x30, 0x9e, 0xe6, 0xe3, 0x87, 0xa7, 0xd5, 0x13, 0x85, 0x6c, 0x46, 0xad, 0xc0, 0x5c}},
+    {{0xbd, 0xc5, 0x0b, 0x08, 0x64, 0xd5, 0x87, 0x56, 0xa1, 0xf9, 0x67, 0xdb, 0xe7, 0x1d, 0x7d, 0x5a,
+      0xb8, 0x26, 0x13, 0x20, 0x14, 0xc5, 0x96, 0x17, 0xbe, 0x27, 0xce, 0xe6, 0xa0, 0x15, 0x6e, 0x7d},
+     {0x7b, 0xe8, 0x7e, 0x34, 0x8e, 0x82, 0xdc, 0xd4, 0x0f, 0x04, 0x58, 0x5f, 0xa2, 0x6f, 0x8c, 0x20,
+      0xf9, 0x83, 0x27, 0x65, 0x59, 0xd7, 0x3b, 0x96, 0x90, 0x5e, 0xac, 0xb3, 0xc3, 0x82, 0xb8, 0x4d},
+     {0xfe, 0xac, 0x57, 0x9c, 0xaf, 0xf4, 0xde, 0x2b, 0xfa, 0x74, 0x77, 0x73, 0x92, 0xbb, 0x5d, 0x92,
+      0x3f, 0x18, 0x53, 0x9c, 0xaa, 0x73, 0x2b, 0x79, 0x4f, 0x50, 0xbd, 0x8c, 0x0d, 0x11, 0xb6, 0x53}}
+};
+
+#endif
@@ -0,0 +1,745 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                           ED25519 SIGNATURE VERIFICATION
+//
+// Verify that R == [S]B - [k]A, with k = SHA-512(R || A || message) mod L
+//
+// - Both scalar multiplications share the same loop (Lim-Lee comb) :
+//   ED25519_COMB_SPACING point doublings and at most 2 additions per column
+// - The comb table of the base point B is precomputed in flash (ed25519_base_table.h)
+// - The comb table of -A is computed by ed25519Init with the same routine
+// - Only public data are processed, the verification is not constant time
+//
+// Field arithmetic derived from TweetNaCl (public domain)
+//
+// Memory : flash 6 KB (table of B), RAM 6 KB (table of -A)
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "ed25519_verify.h"
+#include "ed25519_base_table.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+static const TEd25519Field fieldZero = {0};
+static const TEd25519Field fieldOne = {1};
+
+// d = -121665 / 121666
+static const TEd25519Field fieldD = {0x78a3, 0x1359, 0x4dca, 0x75eb, 0xd8ab, 0x4141, 0x0a4d, 0x0070,
+                                     0xe898, 0x7779, 0x4079, 0x8cc7, 0xfe73, 0x2b6f, 0x6cee, 0x5203};
+
+// 2 * d
+static const TEd25519Field fieldD2 = {0xf159, 0x26b2, 0x9b94, 0xebd6, 0xb156, 0x8283, 0x149a, 0x00e0,
+                                      0xd130, 0xeef3, 0x80f2, 0x198e, 0xfce7, 0x56df, 0xd9dc, 0x2406};
+
+// sqrt(-1)
+static const TEd25519Field fieldSqrtM1 = {0xa0b0, 0x4a0e, 0x1b27, 0xc4ee, 0xe478, 0xad2f, 0x1806, 0x2f43,
+                                          0xd7a7, 0x3dfb, 0x0099, 0x2b4d, 0xdf0b, 0x4fc1, 0x2480, 0x2b83};
+
+// Group order L = 2^252 + 27742317777372353535851937790883648493 (little endian)
+static const byte groupOrder[32] = {0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7, 0xa2,
+                                    0xde, 0xf9, 0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10};
+
+// SHA-512 round constants
+static const uint64_t sha512K[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// SHA-512 context
+typedef struct
+{
+    uint64_t State[8];
+    byte Block[128];
+    int BlockLength;            // Bytes waiting in Block
+    uint32_t Length;            // Bytes hashed (messages are short, 32 bits are enough)
+} TSha512Context;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+byte ed25519PublicKey[ED25519_KEY_LENGTH];                          // Encoded public key (A)
+TEd25519PackedPoint ed25519KeyTable[ED25519_COMB_ENTRIES];          // Comb table of -A
+bool ed25519KeyValid = false;                                       // The public key has been decoded
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                     SHA-512
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define SHA512_ROTR(x, n)   (((x) >> (n)) | ((x) << (64 - (n))))
+
+/**
+ * Init a SHA-512 context
+ *
+ * @param context : pointer to the context
+ *
+*/
+static void sha512Init(TSha512Context* context)
+{
+    static const uint64_t initialState[8] = {
+        0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+        0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+    };
+
+    memcpy(context->State, initialState, sizeof(initialState));
+    context->BlockLength = 0;
+    context->Length = 0;
+}
+
+/**
+ * Process a full 128 bytes block
+ *
+ * The 80 words message schedule is computed in a 16 words ring to save stack
+ *
+ * @param context : pointer to the context
+ *
+*/
+static void sha512Block(TSha512Context* context)
+{
+    uint64_t w[16];
+    uint64_t s[8];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (int j = 0; j < 8; j++) {
+            w[i] = (w[i] << 8) | context->Block[i * 8 + j];
+        }
+    }
+    memcpy(s, context->State, sizeof(s));
+
+    for (int i = 0; i < 80; i++) {
+        if (i >= 16) {
+            uint64_t w15 = w[(i - 15) & 15];
+            uint64_t w2 = w[(i - 2) & 15];
+            w[i & 15] += (SHA512_ROTR(w15, 1) ^ SHA512_ROTR(w15, 8) ^ (w15 >> 7)) + w[(i - 7) & 15] +
+                         (SHA512_ROTR(w2, 19) ^ SHA512_ROTR(w2, 61) ^ (w2 >> 6));
+        }
+
+        uint64_t t1 = s[7] + (SHA512_ROTR(s[4], 14) ^ SHA512_ROTR(s[4], 18) ^ SHA512_ROTR(s[4], 41)) +
+                      ((s[4] & s[5]) ^ (~s[4] & s[6])) + sha512K[i] + w[i & 15];
+        uint64_t t2 = (SHA512_ROTR(s[0], 28) ^ SHA512_ROTR(s[0], 34) ^ SHA512_ROTR(s[0], 39)) +
+                      ((s[0] & s[1]) ^ (s[0] & s[2]) ^ (s[1] & s[2]));
+
+        memmove(&s[1], &s[0], 7 * sizeof(uint64_t));
+        s[4] += t1;
+        s[0] = t1 + t2;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        context->State[i] += s[i];
+    }
+}
+
+/**
+ * Hash data
+ *
+ * @param context : pointer to the context
+ * @param data : pointer to the data
+ * @param dataLength : length of the data in bytes
+ *
+*/
+static void sha512Update(TSha512Context* context, const byte* data, int dataLength)
+{
+    context->Length += dataLength;
+
+    while (dataLength > 0) {
+        int length = 128 - context->BlockLength;
+        if (length > dataLength) {
+            length = dataLength;
+        }
+
+        memcpy(&context->Block[context->BlockLength], data, length);
+        context->BlockLength += length;
+        data += length;
+        dataLength -= length;
+
+        if (context->BlockLength == 128) {
+            sha512Block(context);
+            context->BlockLength = 0;
+        }
+    }
+}
+
+/**
+ * Terminate the hash
+ *
+ * @param context : pointer to the context
+ * @param digest : pointer to the 64 bytes digest
+ *
+*/
+static void sha512Final(TSha512Context* context, byte* digest)
+{
+    uint64_t bitLength = (uint64_t) context->Length * 8;
+
+    context->Block[context->BlockLength++] = 0x80;
+
+    if (context->BlockLength > 112) {
+        memset(&context->Block[context->BlockLength], 0, 128 - context->BlockLength);
+        sha512Block(context);
+        context->BlockLength = 0;
+    }
+    memset(&context->Block[context->BlockLength], 0, 120 - context->BlockLength);
+
+    for (int i = 0; i < 8; i++) {
+        context->Block[120 + i] = (byte)(bitLength >> (56 - 8 * i));
+    }
+    sha512Block(context);
+
+    for (int i = 0; i < 64; i++) {
+        digest[i] = (byte)(context->State[i / 8] >> (56 - 8 * (i % 8)));
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                 FIELD ARITHMETIC
+//////////////////////////////////////////////////////////////////////////////////////
+
+static void fieldCopy(TEd25519Field out, const TEd25519Field a)
+{
+    memcpy(out, a, sizeof(TEd25519Field));
+}
+
+static void fieldCarry(TEd25519Field out)
+{
+    for (int i = 0; i < 16; i++) {
+        out[i] += (1LL << 16);
+        int64_t carry = out[i] >> 16;
+        out[(i + 1) * (i < 15)] += carry - 1 + 37 * (carry - 1) * (i == 15);
+        out[i] -= carry << 16;
+    }
+}
+
+static void fieldSelect(TEd25519Field p, TEd25519Field q, int b)
+{
+    int64_t mask = ~(b - 1);
+
+    for (int i = 0; i < 16; i++) {
+        int64_t t = mask & (p[i] ^ q[i]);
+        p[i] ^= t;
+        q[i] ^= t;
+    }
+}
+
+/**
+ * Encode a field element (canonical value, 32 bytes little endian)
+ *
+*/
+static void fieldPack(byte* out, const TEd25519Field a)
+{
+    TEd25519Field m;
+    TEd25519Field t;
+
+    fieldCopy(t, a);
+    fieldCarry(t);
+    fieldCarry(t);
+    fieldCarry(t);
+
+    for (int j = 0; j < 2; j++) {
+        m[0] = t[0] - 0xffed;
+        for (int i = 1; i < 15; i++) {
+            m[i] = t[i] - 0xffff - ((m[i - 1] >> 16) & 1);
+            m[i - 1] &= 0xffff;
+        }
+        m[15] = t[15] - 0x7fff - ((m[14] >> 16) & 1);
+        int b = (m[15] >> 16) & 1;
+        m[14] &= 0xffff;
+        fieldSelect(t, m, 1 - b);
+    }
+
+    for (int i = 0; i < 16; i++) {
+        out[2 * i] = t[i] & 0xff;
+        out[2 * i + 1] = t[i] >> 8;
+    }
+}
+
+static void fieldUnpack(TEd25519Field out, const byte* in)
+{
+    for (int i = 0; i < 16; i++) {
+        out[i] = in[2 * i] + ((int64_t) in[2 * i + 1] << 8);
+    }
+    out[15] &= 0x7fff;
+}
+
+static bool fieldEqual(const TEd25519Field a, const TEd25519Field b)
+{
+    byte packedA[32];
+    byte packedB[32];
+
+    fieldPack(packedA, a);
+    fieldPack(packedB, b);
+    return memcmp(packedA, packedB, sizeof(packedA)) == 0;
+}
+
+static int fieldParity(const TEd25519Field a)
+{
+    byte packed[32];
+
+    fieldPack(packed, a);
+    return packed[0] & 1;
+}
+
+static void fieldAdd(TEd25519Field out, const TEd25519Field a, const TEd25519Field b)
+{
+    for (int i = 0; i < 16; i++) {
+        out[i] = a[i] + b[i];
+    }
+}
+
+static void fieldSub(TEd25519Field out, const TEd25519Field a, const TEd25519Field b)
+{
+    for (int i = 0; i < 16; i++) {
+        out[i] = a[i] - b[i];
+    }
+}
+
+static void fieldMul(TEd25519Field out, const TEd25519Field a, const TEd25519Field b)
+{
+    int64_t t[31];
+
+    memset(t, 0, sizeof(t));
+    for (int i = 0; i < 16; i++) {
+        for (int j = 0; j < 16; j++) {
+            t[i + j] += a[i] * b[j];
+        }
+    }
+    // 2^256 = 38 modulo p
+    for (int i = 0; i < 15; i++) {
+        t[i] += 38 * t[i + 16];
+    }
+    memcpy(out, t, sizeof(TEd25519Field));
+    fieldCarry(out);
+    fieldCarry(out);
+}
+
+static void fieldSquare(TEd25519Field out, const TEd25519Field a)
+{
+    fieldMul(out, a, a);
+}
+
+// a^(p - 2)
+static void fieldInvert(TEd25519Field out, const TEd25519Field a)
+{
+    TEd25519Field c;
+
+    fieldCopy(c, a);
+    for (int i = 253; i >= 0; i--) {
+        fieldSquare(c, c);
+        if (i != 2 && i != 4) {
+            fieldMul(c, c, a);
+        }
+    }
+    fieldCopy(out, c);
+}
+
+// a^((p - 5) / 8)
+static void fieldPow2523(TEd25519Field out, const TEd25519Field a)
+{
+    TEd25519Field c;
+
+    fieldCopy(c, a);
+    for (int i = 250; i >= 0; i--) {
+        fieldSquare(c, c);
+        if (i != 1) {
+            fieldMul(c, c, a);
+        }
+    }
+    fieldCopy(out, c);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                 POINT ARITHMETIC
+//////////////////////////////////////////////////////////////////////////////////////
+
+static void pointSetNeutral(TEd25519Point* p)
+{
+    fieldCopy(p->X, fieldZero);
+    fieldCopy(p->Y, fieldOne);
+    fieldCopy(p->Z, fieldOne);
+    fieldCopy(p->T, fieldZero);
+}
+
+// p = p + q (extended coordinates)
+static void pointAdd(TEd25519Point* p, const TEd25519Point* q)
+{
+    TEd25519Field a, b, c, d, t, e, f, g, h;
+
+    fieldSub(a, p->Y, p->X);
+    fieldSub(t, q->Y, q->X);
+    fieldMul(a, a, t);
+    fieldAdd(b, p->X, p->Y);
+    fieldAdd(t, q->X, q->Y);
+    fieldMul(b, b, t);
+    fieldMul(c, p->T, q->T);
+    fieldMul(c, c, fieldD2);
+    fieldMul(d, p->Z, q->Z);
+    fieldAdd(d, d, d);
+    fieldSub(e, b, a);
+    fieldSub(f, d, c);
+    fieldAdd(g, d, c);
+    fieldAdd(h, b, a);
+
+    fieldMul(p->X, e, f);
+    fieldMul(p->Y, h, g);
+    fieldMul(p->Z, g, f);
+    fieldMul(p->T, e, h);
+}
+
+// p = p + q, q is a comb table entry (mixed addition, 7 multiplications)
+static void pointAddPacked(TEd25519Point* p, const TEd25519PackedPoint* q)
+{
+    TEd25519Field a, b, c, d, e, f, g, h;
+
+    fieldUnpack(e, q->YMinusX);
+    fieldSub(a, p->Y, p->X);
+    fieldMul(a, a, e);
+    fieldUnpack(e, q->YPlusX);
+    fieldAdd(b, p->Y, p->X);
+    fieldMul(b, b, e);
+    fieldUnpack(e, q->XY2D);
+    fieldMul(c, p->T, e);
+    fieldAdd(d, p->Z, p->Z);
+    fieldSub(e, b, a);
+    fieldSub(f, d, c);
+    fieldAdd(g, d, c);
+    fieldAdd(h, b, a);
+
+    fieldMul(p->X, e, f);
+    fieldMul(p->Y, h, g);
+    fieldMul(p->Z, g, f);
+    fieldMul(p->T, e, h);
+}
+
+// p = 2 * p (4 squares, 4 multiplications)
+static void pointDouble(TEd25519Point* p)
+{
+    TEd25519Field a, b, c, e, f, g, h;
+
+    fieldSquare(a, p->X);
+    fieldSquare(b, p->Y);
+    fieldSquare(c, p->Z);
+    fieldAdd(c, c, c);
+    fieldAdd(h, a, b);
+    fieldAdd(e, p->X, p->Y);
+    fieldSquare(e, e);
+    fieldSub(e, h, e);
+    fieldSub(g, a, b);
+    fieldAdd(f, c, g);
+
+    fieldMul(p->X, e, f);
+    fieldMul(p->Y, g, h);
+    fieldMul(p->Z, f, g);
+    fieldMul(p->T, e, h);
+}
+
+// Encode a point : y with the parity of x in bit 255
+static void pointEncode(byte* out, const TEd25519Point* p)
+{
+    TEd25519Field zInverse, x, y;
+
+    fieldInvert(zInverse, p->Z);
+    fieldMul(x, p->X, zInverse);
+    fieldMul(y, p->Y, zInverse);
+    fieldPack(out, y);
+    out[31] ^= fieldParity(x) << 7;
+}
+
+/**
+ * Decode a point
+ *
+ * @param point : pointer to the decoded point
+ * @param encoded : pointer to the 32 bytes encoded point
+ * @param negate : true to get the opposite of the point
+ *
+ * @return true if the encoding is a point of the curve, else false
+*/
+bool ed25519DecodePoint(TEd25519Point* point, const byte* encoded, bool negate)
+{
+    TEd25519Field t, check, num, den, den2, den4, den6;
+
+    fieldCopy(point->Z, fieldOne);
+    fieldUnpack(point->Y, encoded);
+
+    // x^2 = (y^2 - 1) / (d * y^2 + 1)
+    fieldSquare(num, point->Y);
+    fieldMul(den, num, fieldD);
+    fieldSub(num, num, point->Z);
+    fieldAdd(den, point->Z, den);
+
+    // x = num * den^3 * (num * den^7)^((p - 5) / 8)
+    fieldSquare(den2, den);
+    fieldSquare(den4, den2);
+    fieldMul(den6, den4, den2);
+    fieldMul(t, den6, num);
+    fieldMul(t, t, den);
+
+    fieldPow2523(t, t);
+    fieldMul(t, t, num);
+    fieldMul(t, t, den);
+    fieldMul(t, t, den);
+    fieldMul(point->X, t, den);
+
+    fieldSquare(check, point->X);
+    fieldMul(check, check, den);
+    if (!fieldEqual(check, num)) {
+        fieldMul(point->X, point->X, fieldSqrtM1);
+    }
+
+    fieldSquare(check, point->X);
+    fieldMul(check, check, den);
+    if (!fieldEqual(check, num)) {
+        return false;
+    }
+
+    // Choose the root with the requested parity
+    if ((fieldParity(point->X) == (encoded[31] >> 7)) == negate) {
+        fieldSub(point->X, fieldZero, point->X);
+    }
+
+    fieldMul(point->T, point->X, point->Y);
+    return true;
+}
+
+/**
+ * Compute the comb table of a point
+ *
+ * Entry (i - 1) is the sum of the points 2^(ED25519_COMB_SPACING * b) * point
+ * for every bit b set in i. The entries are converted to affine coordinates
+ * with a single inversion (Montgomery's trick), the products are kept packed
+ * to save RAM. Used at startup for the public key and to generate
+ * ed25519_base_table.h for the base point.
+ *
+ * @param point : pointer to the point
+ * @param table : pointer to the ED25519_COMB_ENTRIES entries to fill
+ *
+*/
+void ed25519ComputeCombTable(const TEd25519Point* point, TEd25519PackedPoint* table)
+{
+    static byte products[ED25519_COMB_ENTRIES][32];
+    TEd25519Point teeth[ED25519_COMB_TEETH];
+    TEd25519Point sum;
+    TEd25519Field product, inverse, zInverse, x, y, z;
+
+    // Points of the teeth : 2^(ED25519_COMB_SPACING * b) * point
+    teeth[0] = *point;
+    for (int b = 1; b < ED25519_COMB_TEETH; b++) {
+        teeth[b] = teeth[b - 1];
+        for (int i = 0; i < ED25519_COMB_SPACING; i++) {
+            pointDouble(&teeth[b]);
+        }
+    }
+
+    // Entries in projective coordinates (X, Y, Z stored in the 3 packed fields)
+    fieldCopy(product, fieldOne);
+    for (int i = 0; i < ED25519_COMB_ENTRIES; i++) {
+        pointSetNeutral(&sum);
+        for (int b = 0; b < ED25519_COMB_TEETH; b++) {
+            if ((i + 1) & (1 << b)) {
+                pointAdd(&sum, &teeth[b]);
+            }
+        }
+        fieldPack(table[i].YPlusX, sum.X);
+        fieldPack(table[i].YMinusX, sum.Y);
+        fieldPack(table[i].XY2D, sum.Z);
+
+        fieldMul(product, product, sum.Z);
+        fieldPack(products[i], product);
+    }
+
+    // Affine coordinates from the last entry to the first one
+    fieldInvert(inverse, product);
+    for (int i = ED25519_COMB_ENTRIES - 1; i >= 0; i--) {
+        if (i > 0) {
+            fieldUnpack(product, products[i - 1]);
+            fieldMul(zInverse, inverse, product);
+        } else {
+            fieldCopy(zInverse, inverse);
+        }
+        fieldUnpack(z, table[i].XY2D);
+        fieldMul(inverse, inverse, z);
+
+        fieldUnpack(x, table[i].YPlusX);
+        fieldUnpack(y, table[i].YMinusX);
+        fieldMul(x, x, zInverse);
+        fieldMul(y, y, zInverse);
+
+        fieldAdd(z, y, x);
+        fieldPack(table[i].YPlusX, z);
+        fieldSub(z, y, x);
+        fieldPack(table[i].YMinusX, z);
+        fieldMul(z, x, y);
+        fieldMul(z, z, fieldD2);
+        fieldPack(table[i].XY2D, z);
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                SCALAR ARITHMETIC
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reduce a 64 bytes number modulo L
+ *
+ * @param out : pointer to the 32 bytes result
+ * @param in : pointer to the 64 bytes number (little endian)
+ *
+*/
+static void scalarReduce(byte* out, const byte* in)
+{
+    int64_t x[64];
+    int64_t carry;
+    int i, j;
+
+    for (i = 0; i < 64; i++) {
+        x[i] = in[i];
+    }
+
+    for (i = 63; i >= 32; i--) {
+        carry = 0;
+        for (j = i - 32; j < i - 12; j++) {
+            x[j] += carry - 16 * x[i] * groupOrder[j - (i - 32)];
+            carry = (x[j] + 128) >> 8;
+            x[j] -= carry << 8;
+        }
+        x[j] += carry;
+        x[i] = 0;
+    }
+
+    carry = 0;
+    for (j = 0; j < 32; j++) {
+        x[j] += carry - (x[31] >> 4) * groupOrder[j];
+        carry = x[j] >> 8;
+        x[j] &= 255;
+    }
+    for (j = 0; j < 32; j++) {
+        x[j] -= carry * groupOrder[j];
+    }
+    for (i = 0; i < 32; i++) {
+        x[i + 1] += x[i] >> 8;
+        out[i] = x[i] & 255;
+    }
+}
+
+// S must be lower than L (no malleable signature)
+static bool scalarIsCanonical(const byte* scalar)
+{
+    for (int i = 31; i >= 0; i--) {
+        if (scalar[i] != groupOrder[i]) {
+            return scalar[i] < groupOrder[i];
+        }
+    }
+    return false;
+}
+
+// Index of the comb table for a column : one bit every ED25519_COMB_SPACING bits
+static int scalarCombIndex(const byte* scalar, int column)
+{
+    int index = 0;
+
+    for (int b = 0; b < ED25519_COMB_TEETH; b++) {
+        int bit = b * ED25519_COMB_SPACING + column;
+        if (bit < 256) {
+            index |= ((scalar[bit >> 3] >> (bit & 7)) & 1) << b;
+        }
+    }
+    return index;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the signature verification with the public key of the middleware
+ *
+ * Decode the key and compute its comb table (once, about 300 point operations)
+ *
+ * @param publicKey : pointer to the 32 bytes public key
+ *
+ * @return true if the key is valid, else false (every signature is then rejected)
+*/
+bool ed25519Init(const byte* publicKey)
+{
+    TEd25519Point negatedKey;
+
+    ed25519KeyValid = ed25519DecodePoint(&negatedKey, publicKey, true);
+
+    if (ed25519KeyValid) {
+        memcpy(ed25519PublicKey, publicKey, ED25519_KEY_LENGTH);
+        ed25519ComputeCombTable(&negatedKey, ed25519KeyTable);
+    }
+    return ed25519KeyValid;
+}
+
+/**
+ * Verify an Ed25519 signature
+ *
+ * @param signature : pointer to the 64 bytes signature (R || S)
+ * @param message : pointer to the signed message
+ * @param messageLength : length of the message in bytes
+ *
+ * @return true if the signature is valid, else false
+*/
+bool ed25519Verify(const byte* signature, const byte* message, int messageLength)
+{
+    TSha512Context context;
+    byte digest[64];
+    byte k[32];
+    byte encoded[32];
+    TEd25519Point point;
+
+    if (!ed25519KeyValid || !scalarIsCanonical(&signature[32])) {
+        return false;
+    }
+
+    // k = SHA-512(R || A || message) mod L
+    sha512Init(&context);
+    sha512Update(&context, signature, 32);
+    sha512Update(&context, ed25519PublicKey, ED25519_KEY_LENGTH);
+    sha512Update(&context, message, messageLength);
+    sha512Final(&context, digest);
+    scalarReduce(k, digest);
+
+    // [S]B + [k](-A), both combs share the doublings
+    pointSetNeutral(&point);
+    for (int column = ED25519_COMB_SPACING - 1; column >= 0; column--) {
+        pointDouble(&point);
+
+        int index = scalarCombIndex(&signature[32], column);
+        if (index != 0) {
+            pointAddPacked(&point, &ed25519BaseTable[index - 1]);
+        }
+
+        index = scalarCombIndex(k, column);
+        if (index != 0) {
+            pointAddPacked(&point, &ed25519KeyTable[index - 1]);
+        }
+        ED25519_YIELD();
+    }
+
+    pointEncode(encoded, &point);
+    return memcmp(encoded, signature, 32) == 0;
+}
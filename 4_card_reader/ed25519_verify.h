@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                           ED25519 SIGNATURE VERIFICATION
+//
+// Offline verification of the identification tokens signed by the middleware
+// - Ed25519 (RFC 8032), verification only, no secret on the reader
+// - SHA-512 included (Ed25519 hash)
+// - Fixed-base comb tables : base point B in flash, middleware public key in RAM
+//   (computed once at startup)
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ED25519_VERIFY_H__
+#define __ED25519_VERIFY_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define ED25519_KEY_LENGTH          32          // Public key length in bytes
+#define ED25519_SIGNATURE_LENGTH    64          // Signature length in bytes (R + S)
+
+#define ED25519_COMB_TEETH          6           // Bits of the scalar read per comb column
+#define ED25519_COMB_SPACING        43          // Comb columns = point doublings per verification (6 * 43 >= 253 bits)
+#define ED25519_COMB_ENTRIES        ((1 << ED25519_COMB_TEETH) - 1)     // Table entries (entry 0 is the neutral point, not stored)
+
+#ifndef ED25519_YIELD
+  #define ED25519_YIELD()                       // Called after each comb column of a verification (bus polls of the firmware)
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Field element modulo 2^255 - 19, 16 limbs of 16 bits (signed to delay the carries)
+typedef int64_t TEd25519Field[16];
+
+// Point in extended coordinates (x = X/Z, y = Y/Z, x * y = T/Z)
+typedef struct
+{
+    TEd25519Field X;
+    TEd25519Field Y;
+    TEd25519Field Z;
+    TEd25519Field T;
+} TEd25519Point;
+
+// Affine point prepared for the mixed addition, packed in 96 bytes (comb table entry)
+typedef struct
+{
+    byte YPlusX[32];            // y + x
+    byte YMinusX[32];           // y - x
+    byte XY2D[32];              // 2 * d * x * y
+} TEd25519PackedPoint;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+bool ed25519Init(const byte* publicKey);
+bool ed25519Verify(const byte* signature, const byte* message, int messageLength);
+bool ed25519DecodePoint(TEd25519Point* point, const byte* encoded, bool negate);
+void ed25519ComputeCombTable(const TEd25519Point* point, TEd25519PackedPoint* table);
+
+#endif
@@ -0,0 +1,628 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  HOST OUTPUT
+//
+// Ring buffers between the producers (main loop) and the host channels.
+//
+// - hostOutputWrite copies the message to the ring buffer of every channel of
+//   HOSTOUTPUT_CHANNELS and starts their bursts. A channel without free space
+//   applies HOSTOUTPUT_POLICY, the other channels still get the message :
+//   o DROP : the new message is dropped
+//   o DROPOLDEST : the oldest messages not started are removed (bytes after them
+//     moved back), the message partly given to the channel is kept whole
+//   o COALESCE : a line identical to one not started yet is not queued again
+//     (card left on the reader while the host lags), else as DROPOLDEST. Text
+//     lines only (hostOutputWriteLine) : the binary messages (ID frames) carry a
+//     sequence number, a timestamp and a duration, never identical, and a
+//     coalesced frame would be seen by the host as lost (sequence gap)
+//   o WAIT : the channel is drained until the message fits, HOSTOUTPUT_WAITTIMEOUT
+//     at most : a stalled host never freezes the identification
+// - The channels are drained with WriteBytes, as many bytes as their transmit
+//   buffer accepts. Called by the transmit interrupts (INTNO_USB_BYTES_TRANSMITTED,
+//   INTNO_COMx_BYTE_TRANSMITTED) and by the producers, the channels without
+//   interrupt are drained by the main loop (hostOutputDrain).
+// - Head written only by the producers, tail only by the drain of the channel. A
+//   drain interrupting another one returns at once : the bytes left are sent by
+//   the next transmit interrupt (bytes still in the channel buffer).
+// - The end of every message is kept with its queuing time, the drain measures
+//   the latency when the tail passes it
+// - Messages removed by the producer with the drain held (Draining set, as
+//   hostOutputDiscard) : the transmit interrupt does not move the tail meanwhile
+// - Pending bytes not taken by the channel for HOSTOUTPUT_STALLTIMEOUT : the
+//   channel is reported stalled until it takes bytes again
+//
+// Memory : HOSTOUTPUT_COUNT * (HOSTOUTPUT_SIZE + HOSTOUTPUT_MESSAGES * 8 + 104) bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "host_output.h"
+
+#if (HOSTOUTPUT_SIZE & (HOSTOUTPUT_SIZE - 1)) != 0 || HOSTOUTPUT_SIZE > 0x8000
+  #error "HOSTOUTPUT_SIZE must be a power of 2 (maximum 32768)"
+#endif
+
+#if (HOSTOUTPUT_MESSAGES & (HOSTOUTPUT_MESSAGES - 1)) != 0 || HOSTOUTPUT_MESSAGES > 128
+  #error "HOSTOUTPUT_MESSAGES must be a power of 2 (maximum 128)"
+#endif
+
+#if (HOSTOUTPUT_CHANNELS) & ~(HOSTOUTPUT_MASK(CHANNEL_USB) | HOSTOUTPUT_MASK(CHANNEL_COM1) | HOSTOUTPUT_MASK(CHANNEL_COM2))
+  #error "HOSTOUTPUT_CHANNELS : USB, COM1 and COM2 only (opened by the manifest of twn4.crt.c)"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+THostOutputChannel hostOutputChannels[HOSTOUTPUT_COUNT];
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Number of bytes in the ring buffer of a channel
+ *
+ * @param output : pointer to the channel
+ *
+ * @return number of bytes not sent yet
+*/
+static int hostOutputChannelPending(const THostOutputChannel* output)
+{
+    return (uint16_t)(output->Head - output->Tail);
+}
+
+/**
+ * Give the pending bytes of a channel to the channel
+ *
+ * Contiguous bursts limited to the free space of the channel transmit buffer
+ *
+ * @param output : pointer to the channel
+ *
+*/
+static void hostOutputDrainChannel(THostOutputChannel* output)
+{
+    if (output->Draining || output->Channel == CHANNEL_NONE) {
+        return;
+    }
+    output->Draining = true;
+
+    int pending;
+
+    while ((pending = hostOutputChannelPending(output)) > 0) {
+        int tail = output->Tail & (HOSTOUTPUT_SIZE - 1);
+        int length = MIN(pending, HOSTOUTPUT_SIZE - tail);
+        int space = GetBufferSize(output->Channel, DIR_OUT) - GetByteCount(output->Channel, DIR_OUT);
+
+        length = MIN(length, space);
+        if (length <= 0) {
+            output->Stats.ChannelFull++;
+            break;      // Channel buffer full : next transmit interrupt
+        }
+
+        int written = WriteBytes(output->Channel, &output->Buffer[tail], length);
+
+        if (written <= 0) {
+            break;
+        }
+        output->Tail += written;
+        output->Stats.Bytes += written;
+        output->Stats.Bursts++;
+        output->ProgressTicks = GetSysTicks();
+        output->Stats.Stalled = false;
+    }
+
+    // Messages given whole to the channel
+    uint32_t ticks = GetSysTicks();
+
+    while (output->MessageTail != output->MessageHead) {
+        const THostOutputMessage* message = &output->Messages[output->MessageTail & (HOSTOUTPUT_MESSAGES - 1)];
+
+        if ((int16_t)(output->Tail - message->End) < 0) {
+            break;
+        }
+
+        uint32_t latency = ticks - message->QueuedTicks;
+
+        output->Stats.Sent++;
+        output->Stats.LatencyTicks += latency;
+        if (latency > output->Stats.MaxLatencyTicks) {
+            output->Stats.MaxLatencyTicks = latency;
+        }
+        output->MessageTail++;
+    }
+
+    output->Draining = false;
+}
+
+/**
+ * Find the ring buffer of a channel
+ *
+ * @param channel : CHANNEL_xxx
+ *
+ * @return pointer to the channel, NULL if not in the fan-out
+*/
+static THostOutputChannel* hostOutputFind(int channel)
+{
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        if (hostOutputChannels[i].Channel == channel) {
+            return &hostOutputChannels[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * USB transmit interrupt
+ *
+*/
+static void hostOutputDrainUSB(void)
+{
+    hostOutputDrainChannel(hostOutputFind(CHANNEL_USB));
+}
+
+/**
+ * COM1 transmit interrupt
+ *
+*/
+static void hostOutputDrainCOM1(void)
+{
+    hostOutputDrainChannel(hostOutputFind(CHANNEL_COM1));
+}
+
+/**
+ * COM2 transmit interrupt
+ *
+*/
+static void hostOutputDrainCOM2(void)
+{
+    hostOutputDrainChannel(hostOutputFind(CHANNEL_COM2));
+}
+
+/**
+ * Open a channel of the fan-out
+ *
+ * Clear its ring buffer and install its transmit interrupt
+ *
+ * @param output : pointer to the ring buffer
+ * @param channel : CHANNEL_xxx
+ *
+*/
+static void hostOutputOpen(THostOutputChannel* output, int channel)
+{
+    memset(output, 0, sizeof(*output));
+    output->Channel = channel;
+    output->Stats.Channel = channel;
+
+    switch (channel) {
+        case CHANNEL_USB:
+            SetInterruptHandler(hostOutputDrainUSB, INTNO_USB_BYTES_TRANSMITTED);
+            break;
+        case CHANNEL_COM1:
+            SetInterruptHandler(hostOutputDrainCOM1, INTNO_COM1_BYTE_TRANSMITTED);
+            break;
+        case CHANNEL_COM2:
+            SetInterruptHandler(hostOutputDrainCOM2, INTNO_COM2_BYTE_TRANSMITTED);
+            break;
+        default:
+            break;      // No transmit interrupt : drained by the main loop
+    }
+}
+
+/**
+ * Init the host output
+ *
+ * Open the channels of HOSTOUTPUT_CHANNELS, or the host channel
+ *
+*/
+void hostOutputInit(void)
+{
+    if (HOSTOUTPUT_CHANNELS == HOSTOUTPUT_HOST) {
+        hostOutputOpen(&hostOutputChannels[0], GetHostChannel());
+        return;
+    }
+
+    const int channels[] = {CHANNEL_USB, CHANNEL_COM1, CHANNEL_COM2};
+    int count = 0;
+
+    for (int i = 0; i < (int)(sizeof(channels) / sizeof(channels[0])); i++) {
+        if (HOSTOUTPUT_CHANNELS & HOSTOUTPUT_MASK(channels[i])) {
+            hostOutputOpen(&hostOutputChannels[count++], channels[i]);
+        }
+    }
+}
+
+/**
+ * Give the pending bytes to all the channels
+ *
+ * Main loop : channels without transmit interrupt, bursts stopped by a full channel buffer,
+ * detection of the stalled hosts
+ *
+*/
+void hostOutputDrain(void)
+{
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        THostOutputChannel* output = &hostOutputChannels[i];
+
+        hostOutputDrainChannel(output);
+
+        if (hostOutputChannelPending(output) == 0) {
+            output->Stats.Stalled = false;      // Discarded
+        } else if (!output->Stats.Stalled && GetSysTicks() - output->ProgressTicks >= HOSTOUTPUT_STALLTIMEOUT) {
+            output->Stats.Stalled = true;
+            output->Stats.Stalls++;
+        }
+    }
+}
+
+/**
+ * Copy bytes to the ring buffer of a channel after the head (not published)
+ *
+ * @param output : pointer to the channel
+ * @param offset : position after the head
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ *
+*/
+static void hostOutputCopy(THostOutputChannel* output, int offset, const void* data, int length)
+{
+    if (length <= 0) {
+        return;
+    }
+
+    int head = (output->Head + offset) & (HOSTOUTPUT_SIZE - 1);
+    int first = MIN(length, HOSTOUTPUT_SIZE - head);
+
+    memcpy(&output->Buffer[head], data, first);
+    memcpy(output->Buffer, (const byte*)data + first, length - first);
+}
+
+/**
+ * Check if a message fits in a channel
+ *
+ * @param output : pointer to the channel
+ * @param length : length of the message in bytes
+ *
+ * @return true if the bytes and the message entry are free, else false
+*/
+static bool hostOutputFits(const THostOutputChannel* output, int length)
+{
+    return length <= HOSTOUTPUT_SIZE - hostOutputChannelPending(output) &&
+           (uint8_t)(output->MessageHead - output->MessageTail) < HOSTOUTPUT_MESSAGES;
+}
+
+/**
+ * Compare a message of the ring buffer with a message and its suffix
+ *
+ * @param output : pointer to the channel
+ * @param message : pointer to the message of the ring buffer
+ * @param data : pointer to the message
+ * @param length : length of the message in bytes
+ * @param suffix : pointer to the suffix
+ * @param suffixLength : length of the suffix in bytes
+ *
+ * @return true if identical, else false
+*/
+static bool hostOutputEquals(const THostOutputChannel* output, const THostOutputMessage* message, const void* data, int length,
+                             const void* suffix, int suffixLength)
+{
+    if ((uint16_t)(message->End - message->Start) != length + suffixLength) {
+        return false;
+    }
+
+    for (int i = 0; i < length + suffixLength; i++) {
+        byte value = (i < length) ? ((const byte*)data)[i] : ((const byte*)suffix)[i - length];
+
+        if (output->Buffer[(uint16_t)(message->Start + i) & (HOSTOUTPUT_SIZE - 1)] != value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Find a message identical to a new one and not started yet
+ *
+ * @param output : pointer to the channel
+ * @param data : pointer to the message
+ * @param length : length of the message in bytes
+ * @param suffix : pointer to the suffix
+ * @param suffixLength : length of the suffix in bytes
+ *
+ * @return true if found, else false
+*/
+static bool hostOutputWaiting(const THostOutputChannel* output, const void* data, int length, const void* suffix, int suffixLength)
+{
+    for (uint8_t index = output->MessageTail; index != output->MessageHead; index++) {
+        const THostOutputMessage* message = &output->Messages[index & (HOSTOUTPUT_MESSAGES - 1)];
+
+        if ((int16_t)(message->Start - output->Tail) >= 0 && hostOutputEquals(output, message, data, length, suffix, suffixLength)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Remove a message not started from the ring buffer
+ *
+ * The bytes and the entries of the messages after it are moved back. Called with
+ * the drain held.
+ *
+ * @param output : pointer to the channel
+ * @param index : free running index of the message
+ *
+*/
+static void hostOutputRemove(THostOutputChannel* output, uint8_t index)
+{
+    THostOutputMessage* removed = &output->Messages[index & (HOSTOUTPUT_MESSAGES - 1)];
+    uint16_t start = removed->Start;
+    uint16_t end = removed->End;
+    uint16_t length = end - start;
+    uint16_t moved = output->Head - end;
+
+    for (uint16_t i = 0; i < moved; i++) {
+        output->Buffer[(uint16_t)(start + i) & (HOSTOUTPUT_SIZE - 1)] = output->Buffer[(uint16_t)(end + i) & (HOSTOUTPUT_SIZE - 1)];
+    }
+
+    for (uint8_t i = index; (uint8_t)(i + 1) != output->MessageHead; i++) {
+        THostOutputMessage* message = &output->Messages[i & (HOSTOUTPUT_MESSAGES - 1)];
+        const THostOutputMessage* next = &output->Messages[(uint8_t)(i + 1) & (HOSTOUTPUT_MESSAGES - 1)];
+
+        message->Start = next->Start - length;
+        message->End = next->End - length;
+        message->QueuedTicks = next->QueuedTicks;
+    }
+
+    output->MessageHead--;
+    output->Head -= length;
+    output->Stats.Dropped++;
+    output->Stats.DroppedBytes += length;
+    output->Stats.Evicted++;
+}
+
+/**
+ * Remove the oldest messages not started until a new message fits
+ *
+ * The message partly given to the channel stays : the host never receives a
+ * truncated message
+ *
+ * @param output : pointer to the channel
+ * @param length : length of the new message in bytes
+ *
+*/
+static void hostOutputEvict(THostOutputChannel* output, int length)
+{
+    if (output->Draining) {
+        return;         // Drain in progress (producer called by an interrupt)
+    }
+    output->Draining = true;
+
+    uint8_t index = output->MessageTail;
+
+    while (!hostOutputFits(output, length) && index != output->MessageHead) {
+        const THostOutputMessage* message = &output->Messages[index & (HOSTOUTPUT_MESSAGES - 1)];
+
+        if ((int16_t)(message->Start - output->Tail) < 0) {
+            index++;    // Started (or sent, not counted yet)
+            continue;
+        }
+        hostOutputRemove(output, index);
+    }
+
+    output->Draining = false;
+}
+
+/**
+ * Drain a channel until a new message fits, HOSTOUTPUT_WAITTIMEOUT at most
+ *
+ * @param output : pointer to the channel
+ * @param length : length of the new message in bytes
+ *
+*/
+static void hostOutputWait(THostOutputChannel* output, int length)
+{
+    uint32_t start = GetSysTicks();
+
+    output->Stats.Waits++;
+    while (!hostOutputFits(output, length) && GetSysTicks() - start < HOSTOUTPUT_WAITTIMEOUT) {
+        hostOutputDrainChannel(output);
+    }
+
+    uint32_t blocked = GetSysTicks() - start;
+
+    output->Stats.BlockedTicks += blocked;
+    if (blocked > output->Stats.MaxBlockedTicks) {
+        output->Stats.MaxBlockedTicks = blocked;
+    }
+    if (!hostOutputFits(output, length)) {
+        output->Stats.WaitTimeouts++;
+    }
+}
+
+/**
+ * Queue a message and its suffix for a channel
+ *
+ * The message is queued whole or not at all, HOSTOUTPUT_POLICY applied when it does not fit
+ *
+ * @param output : pointer to the channel
+ * @param data : pointer to the message
+ * @param length : length of the message in bytes
+ * @param suffix : pointer to the suffix
+ * @param suffixLength : length of the suffix in bytes
+ * @param text : true for a text line (HOSTOUTPUT_POLICY_COALESCE), false for a binary message
+ * @param ticks : system ticks of the queuing
+ *
+ * @return true if queued (or coalesced), false if dropped (ring buffer full)
+*/
+static bool hostOutputQueueChannel(THostOutputChannel* output, const void* data, int length, const void* suffix,
+                                   int suffixLength, bool text, uint32_t ticks)
+{
+    int total = length + suffixLength;
+
+    if (HOSTOUTPUT_POLICY == HOSTOUTPUT_POLICY_COALESCE && text && hostOutputWaiting(output, data, length, suffix, suffixLength)) {
+        output->Stats.Coalesced++;
+        return true;
+    }
+
+    if (!hostOutputFits(output, total)) {
+        output->Stats.Full++;
+
+        if (total <= HOSTOUTPUT_SIZE) {
+            if (HOSTOUTPUT_POLICY == HOSTOUTPUT_POLICY_WAIT) {
+                hostOutputWait(output, total);
+            } else if (HOSTOUTPUT_POLICY == HOSTOUTPUT_POLICY_DROPOLDEST || HOSTOUTPUT_POLICY == HOSTOUTPUT_POLICY_COALESCE) {
+                hostOutputEvict(output, total);
+            }
+        }
+
+        if (!hostOutputFits(output, total)) {
+            output->Stats.Dropped++;
+            output->Stats.DroppedBytes += total;
+            return false;
+        }
+    }
+
+    if (hostOutputChannelPending(output) == 0) {
+        output->ProgressTicks = ticks;      // Stall measured from the first pending byte
+    }
+
+    hostOutputCopy(output, 0, data, length);
+    hostOutputCopy(output, length, suffix, suffixLength);
+
+    THostOutputMessage* message = &output->Messages[output->MessageHead & (HOSTOUTPUT_MESSAGES - 1)];
+
+    message->Start = output->Head;
+    message->End = output->Head + total;
+    message->QueuedTicks = ticks;
+    output->MessageHead++;
+    output->Head += total;          // Published after the copy : the drain never sends a partial message
+
+    output->Stats.Messages++;
+    if (hostOutputChannelPending(output) > output->Stats.HighWater) {
+        output->Stats.HighWater = hostOutputChannelPending(output);
+    }
+
+    hostOutputDrainChannel(output);
+    return true;
+}
+
+/**
+ * Queue a message and its suffix for all the channels
+ *
+ * @param data : pointer to the message
+ * @param length : length of the message in bytes
+ * @param suffix : pointer to the suffix
+ * @param suffixLength : length of the suffix in bytes
+ * @param text : true for a text line, false for a binary message
+ *
+ * @return true if queued for every channel, false if dropped by one of them
+*/
+static bool hostOutputQueue(const void* data, int length, const void* suffix, int suffixLength, bool text)
+{
+    uint32_t ticks = GetSysTicks();
+    bool queued = true;
+
+    if (length + suffixLength <= 0) {
+        return true;
+    }
+
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        if (hostOutputChannels[i].Channel != CHANNEL_NONE &&
+            !hostOutputQueueChannel(&hostOutputChannels[i], data, length, suffix, suffixLength, text, ticks)) {
+            queued = false;
+        }
+    }
+    return queued;
+}
+
+/**
+ * Discard the pending bytes of all the channels
+ *
+*/
+void hostOutputDiscard(void)
+{
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        THostOutputChannel* output = &hostOutputChannels[i];
+
+        output->Draining = true;        // The transmit interrupt does not move the tail meanwhile
+        output->Stats.DroppedBytes += hostOutputChannelPending(output);
+        output->Stats.Dropped += (uint8_t)(output->MessageHead - output->MessageTail);
+        output->Tail = output->Head;
+        output->MessageTail = output->MessageHead;
+        output->Draining = false;
+    }
+}
+
+/**
+ * Queue a binary message for the host (never coalesced)
+ *
+ * @param data : pointer to the message
+ * @param length : length of the message in bytes
+ *
+ * @return true if queued for every channel, false if dropped by one of them
+*/
+bool hostOutputWrite(const void* data, int length)
+{
+    return hostOutputQueue(data, length, NULL, 0, false);
+}
+
+/**
+ * Queue a line for the host : string followed by "\r"
+ *
+ * @param string : null-terminated string
+ *
+ * @return true if queued for every channel, false if dropped by one of them
+*/
+bool hostOutputWriteLine(const char* string)
+{
+    return hostOutputQueue(string, strlen(string), "\r", 1, true);
+}
+
+/**
+ * Count a message the producer could not build (ID too long for a frame) as
+ * dropped by every channel : the host never sees it
+ *
+ * @param length : length of the message in bytes
+ *
+*/
+void hostOutputDropped(int length)
+{
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        if (hostOutputChannels[i].Channel != CHANNEL_NONE) {
+            hostOutputChannels[i].Stats.Dropped++;
+            hostOutputChannels[i].Stats.DroppedBytes += length;
+        }
+    }
+}
+
+/**
+ * Number of bytes waiting for the channels
+ *
+ * @return number of bytes not sent yet, all the channels
+*/
+int hostOutputPending(void)
+{
+    int pending = 0;
+
+    for (int i = 0; i < HOSTOUTPUT_COUNT; i++) {
+        pending += hostOutputChannelPending(&hostOutputChannels[i]);
+    }
+    return pending;
+}
+
+/**
+ * Get the counters of a channel
+ *
+ * @param index : channel of the fan-out (0 to HOSTOUTPUT_COUNT - 1, in the order USB, COM1, COM2)
+ * @param stats : pointer to the counters to fill
+ *
+ * @return true if succeed, false if no such channel
+*/
+bool hostOutputGetStats(int index, THostOutputStats* stats)
+{
+    if (index < 0 || index >= HOSTOUTPUT_COUNT) {
+        return false;
+    }
+
+    *stats = hostOutputChannels[index].Stats;
+    stats->Pending = hostOutputChannelPending(&hostOutputChannels[index]);
+    return true;
+}
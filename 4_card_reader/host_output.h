@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  HOST OUTPUT
+//
+// Buffered output to the host channels (USB, COM1, COM2)
+// - Messages copied to a RAM ring buffer, the state machine never waits for the host
+// - One ring buffer per channel : a slow or disconnected channel never holds the others
+// - Ring buffers drained by WriteBytes bursts from the transmit interrupts
+// - Messages kept whole : policy when a channel lags (drop newest, drop oldest,
+//   coalesce duplicates or wait a bounded time), the producer is never frozen
+// - Queued, sent and dropped messages and delivery latency counted per channel
+// - Backpressure counted per channel : full buffers, time blocked, stalled host
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __HOST_OUTPUT_H__
+#define __HOST_OUTPUT_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define HOSTOUTPUT_POLICY_DROP      0           // New message that does not fit dropped (counted)
+#define HOSTOUTPUT_POLICY_WAIT      1           // Wait until the message fits, HOSTOUTPUT_WAITTIMEOUT at most, then dropped
+#define HOSTOUTPUT_POLICY_DROPOLDEST 2          // Oldest messages not started dropped until the new one fits
+#define HOSTOUTPUT_POLICY_COALESCE  3           // Line identical to one not started not queued again, else drop oldest (binary : as drop oldest)
+
+#ifndef HOSTOUTPUT_POLICY
+  #define HOSTOUTPUT_POLICY         HOSTOUTPUT_POLICY_DROP
+#endif
+
+#ifndef HOSTOUTPUT_WAITTIMEOUT
+  #define HOSTOUTPUT_WAITTIMEOUT    50UL        // Longest wait for free space in milliseconds (HOSTOUTPUT_POLICY_WAIT)
+#endif
+
+#ifndef HOSTOUTPUT_STALLTIMEOUT
+  #define HOSTOUTPUT_STALLTIMEOUT   1000UL      // Pending bytes not taken by the channel for this time : host stalled (milliseconds)
+#endif
+
+#define HOSTOUTPUT_MASK(channel)    (1 << (channel))    // Channel of the fan-out (CHANNEL_USB, CHANNEL_COM1 or CHANNEL_COM2)
+#define HOSTOUTPUT_HOST             0                   // Host channel only (GetHostChannel)
+
+#ifndef HOSTOUTPUT_CHANNELS
+  #define HOSTOUTPUT_CHANNELS       HOSTOUTPUT_HOST     // Channels receiving every message, ex. HOSTOUTPUT_MASK(CHANNEL_USB) | HOSTOUTPUT_MASK(CHANNEL_COM1)
+#endif
+
+#ifndef HOSTOUTPUT_SIZE
+  #define HOSTOUTPUT_SIZE           512         // Ring buffer size of a channel in bytes (power of 2)
+#endif
+
+#ifndef HOSTOUTPUT_MESSAGES
+  #define HOSTOUTPUT_MESSAGES       16          // Messages of a channel followed for the latency (power of 2)
+#endif
+
+#define HOSTOUTPUT_COUNT            ((HOSTOUTPUT_CHANNELS) == HOSTOUTPUT_HOST ? 1 : \
+                                     (((HOSTOUTPUT_CHANNELS) >> CHANNEL_USB) & 1) + \
+                                     (((HOSTOUTPUT_CHANNELS) >> CHANNEL_COM1) & 1) + \
+                                     (((HOSTOUTPUT_CHANNELS) >> CHANNEL_COM2) & 1))
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Counters reported by a channel of the host output
+typedef struct
+{
+    int Channel;                // CHANNEL_xxx
+    int Pending;                // Bytes in the ring buffer
+    int HighWater;              // Highest number of bytes in the ring buffer
+    uint32_t Messages;          // Messages queued
+    uint32_t Sent;              // Messages given whole to the channel
+    uint32_t Bytes;             // Bytes given to the channel
+    uint32_t Bursts;            // WriteBytes calls
+    uint32_t Dropped;           // Messages dropped (ring buffer full, or too long to be built by the producer)
+    uint32_t DroppedBytes;      // Bytes of the messages dropped
+    uint32_t Waits;             // Messages that waited for free space (HOSTOUTPUT_POLICY_WAIT)
+    uint32_t Full;              // Messages that found the ring buffer full (backpressure events)
+    uint32_t Evicted;           // Older messages dropped for a new one (also in Dropped)
+    uint32_t Coalesced;         // Messages identical to one waiting, not queued again
+    uint32_t WaitTimeouts;      // Messages dropped after waiting HOSTOUTPUT_WAITTIMEOUT
+    uint32_t BlockedTicks;      // Accumulated time the producer waited for free space in milliseconds
+    uint32_t MaxBlockedTicks;   // Longest wait in milliseconds
+    uint32_t ChannelFull;       // Bursts stopped by a full channel transmit buffer (host not reading)
+    uint32_t Stalls;            // Times the host stopped taking bytes for HOSTOUTPUT_STALLTIMEOUT
+    bool Stalled;               // Host stalled now
+    uint32_t LatencyTicks;      // Accumulated delay between the queuing and the last byte given to the channel in milliseconds
+    uint32_t MaxLatencyTicks;   // Longest delay in milliseconds
+} THostOutputStats;
+
+// Message followed for the latency
+typedef struct
+{
+    uint16_t Start;             // Head index of the first byte of the message
+    uint16_t End;               // Head index after the message
+    uint32_t QueuedTicks;       // System ticks of the queuing
+} THostOutputMessage;
+
+// Ring buffer of a channel
+typedef struct
+{
+    int Channel;                                // CHANNEL_xxx, CHANNEL_NONE = not opened
+    byte Buffer[HOSTOUTPUT_SIZE];
+    volatile uint16_t Head;                     // Free running index of the next byte written
+    volatile uint16_t Tail;                     // Free running index of the next byte sent
+    volatile bool Draining;                     // Drain in progress
+    THostOutputMessage Messages[HOSTOUTPUT_MESSAGES];
+    volatile uint8_t MessageHead;               // Free running index of the next message queued
+    volatile uint8_t MessageTail;               // Free running index of the oldest message not sent
+    uint32_t ProgressTicks;                     // System ticks of the last byte taken by the channel (or of the first pending byte)
+    THostOutputStats Stats;
+} THostOutputChannel;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void hostOutputInit(void);
+bool hostOutputWrite(const void* data, int length);
+bool hostOutputWriteLine(const char* string);
+void hostOutputDropped(int length);
+void hostOutputDrain(void);
+void hostOutputDiscard(void);
+int hostOutputPending(void);
+bool hostOutputGetStats(int index, THostOutputStats* stats);
+
+#endif
@@ -0,0 +1,103 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    ID FRAME
+//
+// Encode the binary frames of the identifications (format in id_frame.h).
+//
+// - The sequence number is given when the frame is encoded (output order) :
+//   a frame dropped by the host output leaves a gap seen by the host
+// - The duration is limited to 65535 milliseconds
+// - Decoded on the host by 6_print_release_station_pi/id_frame_parser
+//
+// Memory : 2 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "id_frame.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+uint16_t idFrameSequence = 0;       // Sequence number of the next frame
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the frame encoder
+ *
+ * Restart the sequence numbers (the host sees the reader restart)
+ *
+*/
+void idFrameInit(void)
+{
+    idFrameSequence = 0;
+}
+
+/**
+ * Compute the CRC of a frame
+ *
+ * CRC-16/CCITT, reverse polynom 0x8408 (as the Simple Protocol)
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ *
+ * @return CRC
+*/
+static uint16_t idFrameCRC(const byte* data, int length)
+{
+    uint16_t CRC = 0xffff;
+
+    for (int i = 0; i < length; i++) {
+        byte value = data[i] ^ (byte)CRC;
+
+        value ^= (byte)(value << 4);
+        CRC = (uint16_t)(((value << 8) | (CRC >> 8)) ^ (value >> 4) ^ (value << 3));
+    }
+    return CRC;
+}
+
+/**
+ * Encode the frame of an identification
+ *
+ * @param event : pointer to the identification
+ * @param ID : null-terminated ID (card number or user)
+ * @param frame : pointer to the frame
+ * @param maxLength : size of the frame buffer (IDFRAME_MAXLENGTH is enough)
+ *
+ * @return length of the frame, 0 if the ID is too long
+*/
+int idFrameEncode(const TIDFrameEvent* event, const char* ID, byte* frame, int maxLength)
+{
+    int IDLength = strlen(ID);
+    int length = 2 + IDFRAME_HEADERLENGTH + IDLength + 2;
+    uint16_t duration = (event->DurationTicks > 0xffff) ? 0xffff : event->DurationTicks;
+
+    if (IDLength > IDFRAME_MAXID || length > maxLength) {
+        return 0;
+    }
+
+    frame[0] = IDFRAME_SOF;
+    frame[1] = IDFRAME_HEADERLENGTH + IDLength;
+    frame[2] = IDFRAME_VERSION;
+    frame[3] = (byte)idFrameSequence;
+    frame[4] = (byte)(idFrameSequence >> 8);
+    frame[5] = event->Source;
+    frame[6] = event->Technology;
+    frame[7] = (byte)event->Timestamp;
+    frame[8] = (byte)(event->Timestamp >> 8);
+    frame[9] = (byte)(event->Timestamp >> 16);
+    frame[10] = (byte)(event->Timestamp >> 24);
+    frame[11] = (byte)duration;
+    frame[12] = (byte)(duration >> 8);
+    frame[13] = IDLength;
+    memcpy(&frame[14], ID, IDLength);
+
+    uint16_t CRC = idFrameCRC(&frame[1], 1 + IDFRAME_HEADERLENGTH + IDLength);
+
+    frame[length - 2] = (byte)CRC;
+    frame[length - 1] = (byte)(CRC >> 8);
+
+    idFrameSequence++;
+    return length;
+}
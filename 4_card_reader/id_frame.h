@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    ID FRAME
+//
+// Binary frame of an identification sent to the host (optional output format)
+// - Sequence number : the host detects the frames lost or repeated
+// - Source (card, BLE, NFC phone) and technology : card and user IDs not confused
+// - Reader timestamp, identification duration and CRC
+//
+// Frame (little endian) :
+//   SOF (0xa5) | Length | Version | Sequence (2) | Source | Technology |
+//   Timestamp (4) | Duration (2) | ID length | ID | CRC (2)
+//   Length : bytes from Version to the end of the ID
+//   CRC : CRC-16/CCITT (reverse polynom 0x8408, init 0xffff) from Length to the end of the ID
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ID_FRAME_H__
+#define __ID_FRAME_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define IDFRAME_SOF                 0xa5
+#define IDFRAME_VERSION             1
+
+#define IDFRAME_SOURCE_CARD         0           // Card ID (technology : tag type of SearchTag)
+#define IDFRAME_SOURCE_BLE          1           // User of a BLE session
+#define IDFRAME_SOURCE_NFC          2           // User of the token of a phone tapped on the reader
+#define IDFRAME_SOURCE_WIEGAND      3           // Card number of a Wiegand reader (technology : WIEGAND_FORMAT_xxx)
+
+#define IDFRAME_HEADERLENGTH        12          // Version to ID length
+#define IDFRAME_MAXID               128         // Longest ID in bytes
+#define IDFRAME_MAXLENGTH           (2 + IDFRAME_HEADERLENGTH + IDFRAME_MAXID + 2)
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Identification to frame
+typedef struct
+{
+    byte Source;                // IDFRAME_SOURCE_xxx
+    byte Technology;            // Tag type of the card, 0 for BLE
+    uint32_t Timestamp;         // Reader time of the identification (Unix seconds)
+    uint32_t DurationTicks;     // Detection to identification in milliseconds
+} TIDFrameEvent;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void idFrameInit(void);
+int idFrameEncode(const TIDFrameEvent* event, const char* ID, byte* frame, int maxLength);
+
+#endif
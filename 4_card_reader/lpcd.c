@@ -0,0 +1,441 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                      LPCD
+//
+// Sleep with the low power card detection of the PN5180 and tune its threshold
+// and sensing period for the installation (metal chassis, other readers nearby).
+//
+// - Boot : settings of the flash reused when valid, calibrated otherwise with
+//   short sleeps with an empty field, the threshold is moved by steps to
+//   the most sensitive value without false wake-up (plus one step of margin).
+//   Stopped if a card is found (the field is not empty, settings kept).
+// - Runtime : every wake-up is classified by the search that follows it
+//     - LPCD wake-up, card found : detection (latency = wake-up to card found)
+//     - LPCD wake-up, no card : false wake-up
+//     - Timeout wake-up (LPCD_SAFETYPOLL), card found : card missed by the LPCD
+//   At the end of each LPCD_WINDOW, too many misses lower the threshold, else too
+//   many false wake-ups raise it. The period is the longest one keeping the mean
+//   tap latency (half a period + wake-up to card found) under LPCD_LATENCY_MAX.
+// - A card arriving during the last period before the timeout is found by the
+//   safety poll without being missed by the LPCD : only misses beyond twice this
+//   chance (period / LPCD_SAFETYPOLL) count
+// - Sleep in slices of LPCD_SLICE (at least two sensing periods) : the host
+//   channels wake the reader up, the events without wake-up source (BLE) are
+//   checked between the slices by LPCD_WAKEUP
+// - The settings are written to the internal flash only when they differ from
+//   the saved ones, the runtime adjustments at most every LPCD_SAVEINTERVAL
+//
+// Memory : 104 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "lpcd.h"
+
+#if LPCD_THRESHOLD_MIN < 1 || LPCD_THRESHOLD_MAX > 0xff || LPCD_THRESHOLD_MIN > LPCD_THRESHOLD_MAX
+  #error "The LPCD threshold is one byte (1 to 255)"
+#endif
+
+#if LPCD_PERIOD_MIN < PN5180_LPCD_SENSING_PERIOD_MIN || LPCD_PERIOD_MAX > PN5180_LPCD_SENSING_PERIOD_MAX || LPCD_PERIOD_MIN > LPCD_PERIOD_MAX
+  #error "LPCD sensing period out of the PN5180 range"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+TLPCDSettings lpcdSettings;
+TLPCDSettings lpcdSaved;                    // Settings of the flash (Magic 0 if none)
+uint32_t lpcdSaveTicks = 0;                 // System ticks of the last write (or of the boot)
+
+TLPCDStats lpcdStats;
+
+int lpcdWakeSource = WAKEUP_SOURCE_NONE;    // Wake-up of the last sleep not yet classified by a search
+uint32_t lpcdWakeTicks = 0;                 // System ticks of the end of the last sleep
+
+// Current adjustment window
+uint32_t lpcdWindowTicks = 0;               // System ticks of the start of the window
+uint32_t lpcdWindowDetections = 0;
+uint32_t lpcdWindowFalseWakes = 0;
+uint32_t lpcdWindowMisses = 0;
+uint32_t lpcdWindowDetectTicks = 0;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Limit a value to a range
+ *
+ * @param value : value to limit
+ * @param min : lowest value
+ * @param max : highest value
+ *
+ * @return value limited to [min, max]
+*/
+static int lpcdClamp(int value, int min, int max)
+{
+    return (value < min) ? min : ((value > max) ? max : value);
+}
+
+/**
+ * Give the threshold and the sensing period to the PN5180
+ *
+ * @return true if succeed, else false
+*/
+static bool lpcdApply(void)
+{
+    const byte TLV[] = {
+        PN5180_LPCD_THRESHOLD, 1, (byte)lpcdSettings.Threshold,
+        PN5180_LPCD_SENSING_PERIOD, 2, (byte)(lpcdSettings.Period & 0xff), (byte)(lpcdSettings.Period >> 8),
+        TLV_END
+    };
+
+    return SetParameters(TLV, sizeof(TLV));
+}
+
+/**
+ * Mount the internal flash file system, formatted if it is not
+ *
+ * @return true if succeed, else false
+*/
+static bool lpcdMount(void)
+{
+    if (FSMount(SID_INTERNALFLASH, FS_MOUNT_READWRITE) || GetLastError() == ERR_STORAGEALREADYMOUNTED) {
+        return true;
+    }
+    return FSFormat(SID_INTERNALFLASH, FS_FORMATMAGICVALUE) && FSMount(SID_INTERNALFLASH, FS_MOUNT_READWRITE);
+}
+
+/**
+ * Read the settings of the internal flash
+ *
+ * @return true if valid settings are read, else false (settings unchanged)
+*/
+static bool lpcdLoad(void)
+{
+    TLPCDSettings settings;
+    int bytesRead = 0;
+
+    if (!lpcdMount() || !FSOpen(FILE_ENV0, SID_INTERNALFLASH, LPCD_FILEID, FS_READ)) {
+        return false;
+    }
+    bool read = FSReadBytes(FILE_ENV0, &settings, sizeof(settings), &bytesRead);
+    FSClose(FILE_ENV0);
+
+    if (!read || bytesRead != sizeof(settings) || settings.Magic != LPCD_MAGIC ||
+        settings.Threshold < LPCD_THRESHOLD_MIN || settings.Threshold > LPCD_THRESHOLD_MAX ||
+        settings.Period < LPCD_PERIOD_MIN || settings.Period > LPCD_PERIOD_MAX) {
+        return false;
+    }
+    lpcdSettings = settings;
+    lpcdSaved = settings;
+    return true;
+}
+
+/**
+ * Write the settings to the internal flash if they differ from the saved ones
+ *
+ * @return true if succeed or nothing to write, else false
+*/
+static bool lpcdSave(void)
+{
+    int bytesWritten = 0;
+
+    if (memcmp(&lpcdSettings, &lpcdSaved, sizeof(lpcdSettings)) == 0) {
+        return true;
+    }
+    if (!lpcdMount() || !FSOpen(FILE_ENV0, SID_INTERNALFLASH, LPCD_FILEID, FS_WRITE)) {
+        return false;
+    }
+    bool written = FSWriteBytes(FILE_ENV0, &lpcdSettings, sizeof(lpcdSettings), &bytesWritten);
+    FSClose(FILE_ENV0);
+
+    if (!written || bytesWritten != sizeof(lpcdSettings)) {
+        return false;
+    }
+    lpcdSaved = lpcdSettings;
+    lpcdSaveTicks = GetSysTicks();
+    lpcdStats.Saves++;
+    return true;
+}
+
+/**
+ * Change the settings, applied only if they differ (saved by the caller)
+ *
+ * @param threshold : new threshold (limited to the bounds)
+ * @param period : new sensing period in milliseconds (limited to the bounds)
+ *
+*/
+static void lpcdUpdate(int threshold, int period)
+{
+    threshold = lpcdClamp(threshold, LPCD_THRESHOLD_MIN, LPCD_THRESHOLD_MAX);
+    period = lpcdClamp(period, LPCD_PERIOD_MIN, LPCD_PERIOD_MAX);
+
+    if ((uint32_t)threshold == lpcdSettings.Threshold && (uint32_t)period == lpcdSettings.Period) {
+        return;
+    }
+    lpcdSettings.Threshold = threshold;
+    lpcdSettings.Period = period;
+    lpcdStats.Adjustments++;
+
+    lpcdApply();
+}
+
+/**
+ * Check that a threshold does not wake up the reader with an empty field
+ *
+ * @param threshold : threshold to check
+ *
+ * @return 1 if no false wake-up, 0 if woken up without card, -1 if a card is in the field
+*/
+static int lpcdQuiet(int threshold)
+{
+    int tagType;
+    int IDBitCount;
+    byte ID[32];
+
+    lpcdSettings.Threshold = threshold;
+    lpcdApply();
+
+    for (int i = 0; i < LPCD_BOOT_SLEEPS; i++) {
+        // Two sensing periods : an LPCD wake-up is due to the threshold, not to the timeout
+        if (Sleep(2 * lpcdSettings.Period, WAKEUP_BY_LPCD_MSK | WAKEUP_BY_TIMEOUT_MSK | SLEEPMODE_SLEEP) == WAKEUP_SOURCE_LPCD) {
+            return SearchTag(&tagType, &IDBitCount, ID, sizeof(ID)) ? -1 : 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * Calibrate the threshold with an empty field
+ *
+ * Start from the current threshold, go down while there is no false wake-up,
+ * up while there are, until the limit between both is found, then save the
+ * result for the next boots
+ *
+ * @return true if calibrated, false if a card is in the field (settings kept)
+*/
+static bool lpcdCalibrate(void)
+{
+    int initial = lpcdSettings.Threshold;
+    int threshold = initial;
+    int quietThreshold = -1;        // Lowest threshold without false wake-up
+    int noisyThreshold = -1;        // Highest threshold with false wake-ups
+
+    for (int step = 0; step < LPCD_BOOT_STEPS; step++) {
+        int quiet = lpcdQuiet(threshold);
+
+        if (quiet < 0) {
+            // Card in the field : no calibration
+            lpcdSettings.Threshold = initial;
+            lpcdApply();
+            return false;
+        }
+
+        if (quiet) {
+            quietThreshold = threshold;
+            if (noisyThreshold >= 0 || threshold <= LPCD_THRESHOLD_MIN) {
+                break;
+            }
+            threshold -= LPCD_THRESHOLD_STEP;
+        } else {
+            noisyThreshold = threshold;
+            if (quietThreshold >= 0 || threshold >= LPCD_THRESHOLD_MAX) {
+                break;
+            }
+            threshold += LPCD_THRESHOLD_STEP;
+        }
+        threshold = lpcdClamp(threshold, LPCD_THRESHOLD_MIN, LPCD_THRESHOLD_MAX);
+    }
+
+    if (quietThreshold < 0) {
+        threshold = LPCD_THRESHOLD_MAX;
+    } else if (noisyThreshold >= 0) {
+        threshold = quietThreshold + LPCD_THRESHOLD_STEP;     // Margin for the drift of the antenna
+    } else {
+        threshold = quietThreshold;
+    }
+
+    // Settings changed by lpcdQuiet : restored to compare them with the result
+    lpcdSettings.Threshold = initial;
+    lpcdUpdate(threshold, lpcdSettings.Period);
+    lpcdApply();        // Also when unchanged : the PN5180 keeps the last threshold checked
+    lpcdSave();
+    return true;
+}
+
+/**
+ * Init the low power card detection
+ *
+ * Read the settings of the internal flash (defaults if none) and give them to the PN5180.
+ * The calibration blocks the reader (up to LPCD_BOOT_STEPS x LPCD_BOOT_SLEEPS sleeps) :
+ * only done without valid settings in the flash, the runtime adjustment follows the
+ * installation afterwards
+ *
+ * @param calibrate : true to calibrate the threshold if the flash has no settings (field empty at boot)
+ *
+*/
+void lpcdInit(bool calibrate)
+{
+    memset(&lpcdStats, 0, sizeof(lpcdStats));
+    memset(&lpcdSaved, 0, sizeof(lpcdSaved));
+
+    lpcdSettings.Magic = LPCD_MAGIC;
+    lpcdSettings.Threshold = LPCD_THRESHOLD_DEFAULT;
+    lpcdSettings.Period = LPCD_PERIOD_DEFAULT;
+    bool loaded = lpcdLoad();
+    lpcdApply();
+
+    if (calibrate && !loaded) {
+        lpcdStats.Calibrated = lpcdCalibrate();
+    }
+    lpcdSaveTicks = GetSysTicks();
+
+    lpcdWakeSource = WAKEUP_SOURCE_NONE;
+    lpcdWindowTicks = GetSysTicks();
+    lpcdWindowDetections = 0;
+    lpcdWindowFalseWakes = 0;
+    lpcdWindowMisses = 0;
+    lpcdWindowDetectTicks = 0;
+}
+
+/**
+ * Wake-up mask of a host channel
+ *
+ * @param channel : CHANNEL_USB, CHANNEL_COM1 or CHANNEL_COM2 (other : none)
+ *
+ * @return WAKEUP_BY_xxx_MSK of the channel, 0 if none
+*/
+int lpcdChannelMask(int channel)
+{
+    switch (channel) {
+        case CHANNEL_USB:
+            return WAKEUP_BY_USB_MSK;
+        case CHANNEL_COM1:
+            return WAKEUP_BY_COM1_MSK;
+        case CHANNEL_COM2:
+            return WAKEUP_BY_COM2_MSK;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Sleep until a card is detected, a host channel receives data, LPCD_WAKEUP is
+ * true or LPCD_SAFETYPOLL is elapsed
+ *
+ * The system ticks keep running (SLEEPMODE_SLEEP), the next search classifies
+ * the wake-up (lpcdSearchResult) : only an LPCD wake-up or the whole LPCD_SAFETYPOLL
+ * elapsed, a host wake-up is not a false wake-up
+ *
+ * @param wakeMask : WAKEUP_BY_xxx_MSK of the host channels (lpcdChannelMask)
+ *
+*/
+void lpcdSleep(int wakeMask)
+{
+    uint32_t ticks = GetSysTicks();
+    uint32_t slice = MAX(LPCD_SLICE, 2UL * lpcdSettings.Period);     // A sensing in every slice
+    uint32_t slept = 0;
+
+    do {
+        lpcdWakeSource = Sleep(MIN(slice, LPCD_SAFETYPOLL - slept),
+                               wakeMask | WAKEUP_BY_LPCD_MSK | WAKEUP_BY_TIMEOUT_MSK | SLEEPMODE_SLEEP);
+        lpcdWakeTicks = GetSysTicks();
+        slept = lpcdWakeTicks - ticks;
+
+        if (lpcdWakeSource == WAKEUP_SOURCE_TIMEOUT && slept < LPCD_SAFETYPOLL && LPCD_WAKEUP()) {
+            lpcdWakeSource = WAKEUP_SOURCE_NONE;
+        }
+    } while (lpcdWakeSource == WAKEUP_SOURCE_TIMEOUT && slept < LPCD_SAFETYPOLL);
+
+    if (lpcdWakeSource != WAKEUP_SOURCE_LPCD && lpcdWakeSource != WAKEUP_SOURCE_TIMEOUT) {
+        lpcdStats.HostWakes++;
+    }
+    lpcdStats.Sleeps++;
+    lpcdStats.SleepTicks += slept;
+}
+
+/**
+ * Adjust the settings at the end of a window
+ *
+*/
+static void lpcdAdjust(void)
+{
+    int threshold = lpcdSettings.Threshold;
+    int period = lpcdSettings.Period;
+    uint32_t found = lpcdWindowDetections + lpcdWindowMisses;
+
+    // Misses expected by chance : card arrived during the last period of the sleep
+    if (lpcdWindowMisses * LPCD_SAFETYPOLL > 2 * found * lpcdSettings.Period) {
+        threshold -= LPCD_THRESHOLD_STEP;
+    } else if (lpcdWindowFalseWakes > LPCD_FALSEWAKE_MAX * (LPCD_WINDOW / 60000UL)) {
+        threshold += LPCD_THRESHOLD_STEP;
+    }
+
+    if (lpcdWindowDetections != 0) {
+        int detectTicks = lpcdWindowDetectTicks / lpcdWindowDetections;
+
+        period = 2 * (LPCD_LATENCY_MAX - detectTicks);
+    }
+
+    lpcdUpdate(threshold, period);
+}
+
+/**
+ * Classify the last wake-up with the result of the search that follows it
+ *
+ * @param found : true if the search found a card
+ * @param ticks : system ticks of the end of the search
+ *
+*/
+void lpcdSearchResult(bool found, uint32_t ticks)
+{
+    if (lpcdWakeSource == WAKEUP_SOURCE_LPCD) {
+        if (found) {
+            lpcdStats.Detections++;
+            lpcdStats.DetectTicks += ticks - lpcdWakeTicks;
+            lpcdWindowDetections++;
+            lpcdWindowDetectTicks += ticks - lpcdWakeTicks;
+        } else {
+            lpcdStats.FalseWakes++;
+            lpcdWindowFalseWakes++;
+        }
+    } else if (lpcdWakeSource == WAKEUP_SOURCE_TIMEOUT && found) {
+        lpcdStats.Misses++;
+        lpcdWindowMisses++;
+    }
+    lpcdWakeSource = WAKEUP_SOURCE_NONE;     // Following searches : card resting or reader busy
+
+    if ((uint32_t)(ticks - lpcdWindowTicks) >= LPCD_WINDOW) {
+        lpcdAdjust();
+        if ((uint32_t)(ticks - lpcdSaveTicks) >= LPCD_SAVEINTERVAL) {
+            lpcdSave();     // Last settings of an oscillating threshold written once per interval
+        }
+
+        lpcdWindowTicks = ticks;
+        lpcdWindowDetections = 0;
+        lpcdWindowFalseWakes = 0;
+        lpcdWindowMisses = 0;
+        lpcdWindowDetectTicks = 0;
+    }
+}
+
+/**
+ * Get the current settings
+ *
+ * @param settings : pointer to the settings to fill
+ *
+*/
+void lpcdGetSettings(TLPCDSettings* settings)
+{
+    *settings = lpcdSettings;
+}
+
+/**
+ * Get the LPCD counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void lpcdGetStats(TLPCDStats* stats)
+{
+    *stats = lpcdStats;
+}
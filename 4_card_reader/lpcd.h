@@ -0,0 +1,118 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                      LPCD
+//
+// Low power card detection : sleep until the PN5180 senses a change of the field
+// - Threshold and sensing period calibrated at boot and adjusted at runtime from
+//   the false wake-ups and the cards missed by the detection
+// - The settings are kept in the internal flash (file system), a valid copy
+//   skips the boot calibration
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __LPCD_H__
+#define __LPCD_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef LPCD_THRESHOLD_MIN
+  #define LPCD_THRESHOLD_MIN        5           // Most sensitive threshold allowed
+#endif
+
+#ifndef LPCD_THRESHOLD_MAX
+  #define LPCD_THRESHOLD_MAX        0xff        // Least sensitive threshold allowed
+#endif
+
+#ifndef LPCD_THRESHOLD_DEFAULT
+  #define LPCD_THRESHOLD_DEFAULT    16          // Threshold before calibration
+#endif
+
+#ifndef LPCD_THRESHOLD_STEP
+  #define LPCD_THRESHOLD_STEP       4           // Threshold change per adjustment
+#endif
+
+#ifndef LPCD_PERIOD_MIN
+  #define LPCD_PERIOD_MIN           50          // Shortest sensing period in milliseconds
+#endif
+
+#ifndef LPCD_PERIOD_MAX
+  #define LPCD_PERIOD_MAX           1000        // Longest sensing period in milliseconds (PN5180 : 2690)
+#endif
+
+#ifndef LPCD_PERIOD_DEFAULT
+  #define LPCD_PERIOD_DEFAULT       200         // Sensing period before calibration
+#endif
+
+#ifndef LPCD_LATENCY_MAX
+  #define LPCD_LATENCY_MAX          300         // Acceptable mean tap latency in milliseconds (half period + search)
+#endif
+
+#ifndef LPCD_SAFETYPOLL
+  #define LPCD_SAFETYPOLL           1000UL      // Longest sleep : search without detection (missed cards, BLE events)
+#endif
+
+#ifndef LPCD_SLICE
+  #define LPCD_SLICE                100UL       // Sleep slice between two checks of LPCD_WAKEUP (events without wake-up source)
+#endif
+
+#ifndef LPCD_WAKEUP
+  #define LPCD_WAKEUP()             false       // Checked between the slices : true ends the sleep (BLE connection)
+#endif
+
+#ifndef LPCD_WINDOW
+  #define LPCD_WINDOW               600000UL    // Runtime adjustment every 10 minutes
+#endif
+
+#ifndef LPCD_SAVEINTERVAL
+  #define LPCD_SAVEINTERVAL         21600000UL  // Runtime adjustments written to the flash at most every 6 hours
+#endif
+
+#ifndef LPCD_FALSEWAKE_MAX
+  #define LPCD_FALSEWAKE_MAX        2           // Accepted false wake-ups per minute
+#endif
+
+#define LPCD_BOOT_SLEEPS            10          // Sleeps per boot calibration step, all without wake-up
+#define LPCD_BOOT_STEPS             16          // Maximum number of boot calibration steps
+
+#define LPCD_FILEID                 0x4c504344  // "LPCD" : file of the settings in SID_INTERNALFLASH
+#define LPCD_MAGIC                  0x4c504331  // Version of the settings file
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Settings kept in the internal flash
+typedef struct
+{
+    uint32_t Magic;
+    uint32_t Threshold;
+    uint32_t Period;            // Sensing period in milliseconds
+} TLPCDSettings;
+
+// Counters reported by the low power card detection
+typedef struct
+{
+    uint32_t Sleeps;
+    uint32_t SleepTicks;        // Accumulated sleep in milliseconds
+    uint32_t Detections;        // Wake-ups by LPCD with a card found
+    uint32_t FalseWakes;        // Wake-ups by LPCD without card
+    uint32_t Misses;            // Cards found after a timeout wake-up (not detected)
+    uint32_t DetectTicks;       // Accumulated time from the wake-up to the card found in milliseconds
+    uint32_t Adjustments;       // Settings changed (boot and runtime)
+    uint32_t Saves;             // Settings written to the flash
+    uint32_t HostWakes;         // Wake-ups by a host channel or LPCD_WAKEUP
+    bool Calibrated;            // Boot calibration done (false : settings of the flash reused or card in the field)
+} TLPCDStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void lpcdInit(bool calibrate);
+int lpcdChannelMask(int channel);
+void lpcdSleep(int wakeMask);
+void lpcdSearchResult(bool found, uint32_t ticks);
+void lpcdGetSettings(TLPCDSettings* settings);
+void lpcdGetStats(TLPCDStats* stats);
+
+#endif
@@ -0,0 +1,227 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  NDEF STREAM
+//
+// Parse an NDEF message while it is received. The caller gives every chunk
+// from the RF layer (READ BINARY response, ...) and calls ndefStreamNext until
+// NDEFSTREAM_NEEDDATA, an event is returned as soon as it is known :
+//
+//   int position = 0;
+//   while ((event = ndefStreamNext(&stream, chunk, length, &position, &payload)) > 0) { ... }
+//
+// - The payload is never copied : every NDEFSTREAM_PAYLOAD points into the
+//   chunk, a record larger than a chunk gives several parts
+// - Only the header fields are kept (type and ID, truncated to the buffers),
+//   the RAM used does not depend on the size of the message
+// - Chunked record : the first part gives the type and ID, the next parts
+//   (TNF unchanged, no type, no ID) continue the payload, one RECORDEND at
+//   the last part
+//
+// Memory : sizeof(TNDEFStream) = 76 bytes, whatever the size of the message
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "ndef_stream.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Parser states
+#define NDEFSTREAM_ST_HEADER            0
+#define NDEFSTREAM_ST_TYPELENGTH        1
+#define NDEFSTREAM_ST_PAYLOADLENGTH     2
+#define NDEFSTREAM_ST_IDLENGTH          3
+#define NDEFSTREAM_ST_TYPE              4
+#define NDEFSTREAM_ST_ID                5
+#define NDEFSTREAM_ST_RECORD            6       // Header complete, RECORD to report
+#define NDEFSTREAM_ST_PAYLOAD           7
+#define NDEFSTREAM_ST_MESSAGEEND        8       // Last record complete, MESSAGEEND to report
+#define NDEFSTREAM_ST_DONE              9
+#define NDEFSTREAM_ST_ERROR             10
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the parser for a new message
+ *
+ * @param stream : pointer to the parser
+ *
+*/
+void ndefStreamInit(TNDEFStream* stream)
+{
+    memset(stream, 0, sizeof(TNDEFStream));
+    stream->State = NDEFSTREAM_ST_HEADER;
+}
+
+/**
+ * Check the header of a record part
+ *
+ * @param stream : pointer to the parser
+ * @param header : first byte of the record part
+ *
+ * @return true if the header is valid at this position of the message
+*/
+static bool ndefStreamCheckHeader(TNDEFStream* stream, byte header)
+{
+    bool unchanged = (header & NDEFSTREAM_TNF_MASK) == NDEFSTREAM_TNF_UNCHANGED;
+    bool chunkEnd = (header & NDEFSTREAM_FLAG_CF) && (header & NDEFSTREAM_FLAG_ME);     // ME only on the last part
+
+    if (stream->InChunk) {
+        // Next part of a chunked record : TNF unchanged, no ID, not a message begin
+        return unchanged && !(header & (NDEFSTREAM_FLAG_IL | NDEFSTREAM_FLAG_MB)) && !chunkEnd;
+    }
+
+    // First record : message begin, then never again
+    return !unchanged && ((stream->Records == 0) == ((header & NDEFSTREAM_FLAG_MB) != 0)) && !chunkEnd;
+}
+
+/**
+ * Parse the chunk up to the next event
+ *
+ * @param stream : pointer to the parser
+ * @param chunk : pointer to the received bytes
+ * @param length : number of received bytes
+ * @param position : pointer to the position in the chunk, advanced by the parser (0 for a new chunk)
+ * @param payload : pointer to the payload part, filled for NDEFSTREAM_PAYLOAD
+ *
+ * @return event NDEFSTREAM_xxx
+*/
+int ndefStreamNext(TNDEFStream* stream, const byte* chunk, int length, int* position, TNDEFStreamPayload* payload)
+{
+    while (true) {
+        // Transitions without input
+        switch (stream->State) {
+            case NDEFSTREAM_ST_TYPE:
+                if (stream->FieldBytes == 0) {
+                    stream->FieldBytes = stream->InChunk ? 0 : stream->IDLength;
+                    stream->State = NDEFSTREAM_ST_ID;
+                    continue;
+                }
+                break;
+
+            case NDEFSTREAM_ST_ID:
+                if (stream->FieldBytes == 0) {
+                    stream->State = stream->InChunk ? NDEFSTREAM_ST_PAYLOAD : NDEFSTREAM_ST_RECORD;
+                    continue;
+                }
+                break;
+
+            case NDEFSTREAM_ST_RECORD:
+                stream->PayloadLength = 0;
+                stream->State = NDEFSTREAM_ST_PAYLOAD;
+                return NDEFSTREAM_RECORD;
+
+            case NDEFSTREAM_ST_PAYLOAD:
+                if (stream->PayloadRemaining == 0) {
+                    stream->InChunk = (stream->Flags & NDEFSTREAM_FLAG_CF) != 0;
+                    if (stream->InChunk) {
+                        stream->State = NDEFSTREAM_ST_HEADER;
+                        continue;
+                    }
+                    stream->Records++;
+                    stream->State = (stream->Flags & NDEFSTREAM_FLAG_ME) ? NDEFSTREAM_ST_MESSAGEEND : NDEFSTREAM_ST_HEADER;
+                    return NDEFSTREAM_RECORDEND;
+                }
+                break;
+
+            case NDEFSTREAM_ST_MESSAGEEND:
+                stream->State = NDEFSTREAM_ST_DONE;
+                return NDEFSTREAM_MESSAGEEND;
+
+            case NDEFSTREAM_ST_DONE:
+                *position = length;         // Bytes after the message (padding) are ignored
+                return NDEFSTREAM_NEEDDATA;
+
+            case NDEFSTREAM_ST_ERROR:
+                return NDEFSTREAM_ERROR;
+
+            default:
+                break;
+        }
+
+        if (*position >= length) {
+            return NDEFSTREAM_NEEDDATA;
+        }
+
+        // Payload : view into the chunk
+        if (stream->State == NDEFSTREAM_ST_PAYLOAD) {
+            uint32_t available = (uint32_t)(length - *position);
+            int part = (int)((stream->PayloadRemaining < available) ? stream->PayloadRemaining : available);
+
+            payload->Data = &chunk[*position];
+            payload->Length = part;
+            payload->Offset = stream->PayloadLength;
+
+            *position += part;
+            stream->PayloadRemaining -= part;
+            stream->PayloadLength += part;
+            return NDEFSTREAM_PAYLOAD;
+        }
+
+        byte value = chunk[(*position)++];
+
+        switch (stream->State) {
+            case NDEFSTREAM_ST_HEADER:
+                if (!ndefStreamCheckHeader(stream, value)) {
+                    stream->State = NDEFSTREAM_ST_ERROR;
+                    break;
+                }
+                stream->Flags = value;
+                if (!stream->InChunk) {
+                    stream->TNF = value & NDEFSTREAM_TNF_MASK;
+                    stream->IDLength = 0;
+                }
+                stream->State = NDEFSTREAM_ST_TYPELENGTH;
+                break;
+
+            case NDEFSTREAM_ST_TYPELENGTH:
+                if (stream->InChunk && value != 0) {
+                    stream->State = NDEFSTREAM_ST_ERROR;
+                    break;
+                }
+                if (!stream->InChunk) {
+                    stream->TypeLength = value;
+                }
+                stream->FieldBytes = (stream->Flags & NDEFSTREAM_FLAG_SR) ? 1 : 4;
+                stream->PayloadRemaining = 0;
+                stream->State = NDEFSTREAM_ST_PAYLOADLENGTH;
+                break;
+
+            case NDEFSTREAM_ST_PAYLOADLENGTH:
+                stream->PayloadRemaining = (stream->PayloadRemaining << 8) | value;
+                if (--stream->FieldBytes == 0) {
+                    stream->FieldBytes = stream->InChunk ? 0 : stream->TypeLength;
+                    stream->State = (stream->Flags & NDEFSTREAM_FLAG_IL) ? NDEFSTREAM_ST_IDLENGTH : NDEFSTREAM_ST_TYPE;
+                }
+                break;
+
+            case NDEFSTREAM_ST_IDLENGTH:
+                stream->IDLength = value;
+                stream->FieldBytes = stream->TypeLength;
+                stream->State = NDEFSTREAM_ST_TYPE;
+                break;
+
+            case NDEFSTREAM_ST_TYPE:
+            {
+                int index = stream->TypeLength - stream->FieldBytes--;
+                if (index < NDEFSTREAM_TYPELENGTH) {
+                    stream->Type[index] = value;
+                }
+                break;
+            }
+
+            case NDEFSTREAM_ST_ID:
+            {
+                int index = stream->IDLength - stream->FieldBytes--;
+                if (index < NDEFSTREAM_IDLENGTH) {
+                    stream->ID[index] = value;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
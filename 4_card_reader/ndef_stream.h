@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  NDEF STREAM
+//
+// Incremental parser of NDEF messages
+// - Fed with the chunks received from the RF layer, no assembled message
+// - Yields the records : header (TNF, type, ID), then the payload as views
+//   into the received chunks (no copy)
+// - Chunked records (CF) are reported as one record
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __NDEF_STREAM_H__
+#define __NDEF_STREAM_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NDEFSTREAM_TYPELENGTH
+  #define NDEFSTREAM_TYPELENGTH     32          // Type bytes kept (longer types are truncated, TypeLength is the full length)
+#endif
+
+#ifndef NDEFSTREAM_IDLENGTH
+  #define NDEFSTREAM_IDLENGTH       16          // ID bytes kept (longer IDs are truncated, IDLength is the full length)
+#endif
+
+// Events returned by ndefStreamNext
+#define NDEFSTREAM_ERROR            -1          // Malformed message, the stream stays in error
+#define NDEFSTREAM_NEEDDATA         0           // Chunk consumed, feed the next one
+#define NDEFSTREAM_RECORD           1           // Record header received : TNF, Type, ID
+#define NDEFSTREAM_PAYLOAD          2           // Part of the payload : Data, Length, Offset
+#define NDEFSTREAM_RECORDEND        3           // Record complete : PayloadLength
+#define NDEFSTREAM_MESSAGEEND       4           // Last record of the message complete
+
+// Record header flags
+#define NDEFSTREAM_FLAG_MB          0x80        // Message begin
+#define NDEFSTREAM_FLAG_ME          0x40        // Message end
+#define NDEFSTREAM_FLAG_CF          0x20        // Chunk flag
+#define NDEFSTREAM_FLAG_SR          0x10        // Short record (1 byte payload length)
+#define NDEFSTREAM_FLAG_IL          0x08        // ID length present
+#define NDEFSTREAM_TNF_MASK         0x07
+#define NDEFSTREAM_TNF_UNCHANGED    0x06        // TNF of the chunks after the first one
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Parser state and current record
+typedef struct
+{
+    int State;
+    byte Flags;                 // Header of the current record part
+    bool InChunk;               // The previous record part had the CF flag
+    int FieldBytes;             // Bytes of the current field still to receive
+    uint32_t PayloadRemaining;  // Payload bytes of the current record part still to receive
+    uint32_t Records;           // Records completed in the message
+
+    byte TNF;
+    byte TypeLength;
+    byte Type[NDEFSTREAM_TYPELENGTH];
+    byte IDLength;
+    byte ID[NDEFSTREAM_IDLENGTH];
+    uint32_t PayloadLength;     // Payload bytes received for the record (all chunks)
+} TNDEFStream;
+
+// Part of the payload, pointing into the chunk given to ndefStreamNext
+typedef struct
+{
+    const byte* Data;
+    int Length;
+    uint32_t Offset;            // Offset of Data in the payload of the record
+} TNDEFStreamPayload;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void ndefStreamInit(TNDEFStream* stream);
+int ndefStreamNext(TNDEFStream* stream, const byte* chunk, int length, int* position, TNDEFStreamPayload* payload);
+
+#endif
@@ -0,0 +1,260 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  OSDP READER
+//
+// Report the identifications of the firmware to an OSDP controller.
+//
+// - osdpReaderReport queues the card and user strings (outputID), the search
+//   function of the OSDP application (pAppSearchTag) takes them one by one :
+//   the RF search, the card reads and the BLE state machine stay in the main
+//   loop, the OSDP application never waits for them
+// - osdpReaderService runs the background tasks (bus, secure channel, replies
+//   to the polls). The main loop calls it between its steps and the long
+//   operations between their own steps (APDU exchanges, DESFire commands,
+//   Ed25519 comb columns), the longest gap is measured against OSDPREADER_REPLYTIME.
+// - osdpReaderTasks runs the foreground tasks (card reports, LEDs, buzzer)
+//   once per loop
+// - Secure channel : the controller sets its SCBK once with the default key
+//   (installation mode), then only this key is accepted
+//
+// Memory : OSDPREADER_QUEUE * 72 bytes + 200 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "osdp_reader.h"
+
+#if (OSDPREADER_QUEUE & (OSDPREADER_QUEUE - 1)) != 0 || OSDPREADER_QUEUE > 128
+  #error "OSDPREADER_QUEUE must be a power of 2 (maximum 128)"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+const TOSDPLEDMapping osdpReaderLEDs[] = {
+    {OSDP_COLOR_OPTION_RED, REDLED},
+    {OSDP_COLOR_OPTION_GREEN, GREENLED},
+    {OSDP_COLOR_OPTION_BLUE, BLUELED},
+    {OSDP_COLOR_OPTION_BLACK, 0}
+};
+
+TOSDPConfig osdpReaderConfig;
+
+TOSDPReaderEntry osdpReaderQueue[OSDPREADER_QUEUE];
+uint8_t osdpReaderHead = 0;         // Free running index of the next entry written
+uint8_t osdpReaderTail = 0;         // Free running index of the next entry reported
+
+bool osdpReaderReady = false;       // OSDP application set up
+uint32_t osdpReaderServiceTicks = 0;    // System ticks of the last background tasks
+
+TOSDPReaderStats osdpReaderStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Search function of the OSDP application
+ *
+ * Take the oldest identification of the queue, no RF search (done by the main loop)
+ *
+ * @param card : pointer to the card data to fill
+ *
+ * @return true if an identification is reported, else false
+*/
+static bool osdpReaderSearchTag(TOSDPCardData* card)
+{
+    if (osdpReaderTail == osdpReaderHead) {
+        return false;
+    }
+
+    const TOSDPReaderEntry* entry = &osdpReaderQueue[osdpReaderTail & (OSDPREADER_QUEUE - 1)];
+    int length = strlen(entry->IDString);
+
+    memset(card, 0, sizeof(*card));
+    card->TagType = entry->TagType;
+    memcpy(card->ID, entry->IDString, length);
+    card->IDBitCnt = length * 8;
+    memcpy(card->RawBits, entry->IDString, length);
+    card->RawBitCnt = length * 8;
+    strcpy(card->FormattedString, entry->IDString);
+
+    osdpReaderTail++;
+    osdpReaderStats.Reported++;
+    return true;
+}
+
+/**
+ * Card data function of the OSDP application
+ *
+ * The card data is already filled by osdpReaderSearchTag
+ *
+ * @param card : pointer to the card data
+ *
+ * @return true
+*/
+static bool osdpReaderReadCardData(TOSDPCardData* card)
+{
+    (void)card;
+    return true;
+}
+
+/**
+ * Signal of the OSDP application
+ *
+ * The LEDs and the beeps of the firmware are kept, the controller drives them
+ * with its LED and buzzer commands
+ *
+*/
+static void osdpReaderSignal(void)
+{
+}
+
+/**
+ * Init the OSDP reader
+ *
+ * Set up the OSDP application (serial port, address, secure channel)
+ *
+ * @return true if succeed, else false
+*/
+bool osdpReaderInit(void)
+{
+    osdpReaderHead = 0;
+    osdpReaderTail = 0;
+    memset(osdpReaderQueue, 0, sizeof(osdpReaderQueue));
+    memset(&osdpReaderStats, 0, sizeof(osdpReaderStats));
+    memset(&osdpReaderConfig, 0, sizeof(osdpReaderConfig));
+
+    osdpReaderConfig.Address = OSDPREADER_ADDRESS;
+    osdpReaderConfig.Baudrate = OSDPREADER_BAUDRATE;
+    osdpReaderConfig.Bias = OSDP_BIAS_DIP;
+    osdpReaderConfig.ConnectionTimeout = OSDPREADER_CONNECTIONTIMEOUT;
+    osdpReaderConfig.KeyOption = OSDPREADER_KEYOPTION;
+    osdpReaderConfig.FMT = OSDPREADER_FORMATTED;
+    osdpReaderConfig.CardTimeout = 0;       // Repeated cards filtered by the firmware
+    osdpReaderConfig.TamperMode = TAMPER_MODE_OFF;
+    osdpReaderConfig.BuzzerFrequency = 2400;
+    osdpReaderConfig.BuzzerVolume = 50;
+
+    // SCBK_D : default key of the OSDP specification (0x30 to 0x3f), installation mode only
+    for (int i = 0; i < (int)sizeof(osdpReaderConfig.SCBK_D); i++) {
+        osdpReaderConfig.SCBK_D[i] = 0x30 + i;
+    }
+
+    osdpReaderConfig.Cap.Compliance_CardDataFormat = 1;     // Card data as bits (raw) or characters (formatted)
+    osdpReaderConfig.Cap.Num_CardDataFormat = 0;
+    osdpReaderConfig.Cap.Compliance_LEDControl = 1;
+    osdpReaderConfig.Cap.Num_LEDControl = sizeof(osdpReaderLEDs) / sizeof(osdpReaderLEDs[0]) - 1;
+    osdpReaderConfig.Cap.Compliance_AudibleOutput = 1;
+    osdpReaderConfig.Cap.Num_AudibleOutput = 1;
+    osdpReaderConfig.Cap.Compliance_CheckCharSupport = 1;   // CRC-16
+    osdpReaderConfig.Cap.Compliance_ComSecurity = 1;        // AES-128 secure channel
+    osdpReaderConfig.Cap.Num_ComSecurity = 1;
+    osdpReaderConfig.Cap.OSDP_Version = 2;
+
+    osdpReaderConfig.pLEDMapping = osdpReaderLEDs;
+    osdpReaderConfig.LEDMode = OSDP_LED_ADDRESS_MODE_COLOR;
+
+    osdpReaderConfig.pAppSearchTag = osdpReaderSearchTag;
+    osdpReaderConfig.pReadCardData = osdpReaderReadCardData;
+    osdpReaderConfig.pOnStartup = osdpReaderSignal;
+    osdpReaderConfig.pOnRestart = osdpReaderSignal;
+    osdpReaderConfig.pOnCardInvalid = osdpReaderSignal;
+    osdpReaderConfig.pOnCardValid = osdpReaderSignal;
+    osdpReaderConfig.pOnCardTimeout = osdpReaderSignal;
+    osdpReaderConfig.pOnOnline = osdpReaderSignal;
+    osdpReaderConfig.pOnOffline = osdpReaderSignal;
+    osdpReaderConfig.pOnTamperDetect = osdpReaderSignal;
+    osdpReaderConfig.pOnFirmwareUpdate = osdpReaderSignal;
+
+    osdpReaderReady = OSDPAppSetup(&osdpReaderConfig);
+    osdpReaderServiceTicks = GetSysTicks();
+    return osdpReaderReady;
+}
+
+/**
+ * Queue an identification for the next poll
+ *
+ * @param IDString : pointer to the card or user string
+ * @param event : pointer to the identification
+ *
+ * @return true if queued, false if dropped
+*/
+bool osdpReaderReport(const char* IDString, const TIDFrameEvent* event)
+{
+    if ((uint8_t)(osdpReaderHead - osdpReaderTail) >= OSDPREADER_QUEUE || strlen(IDString) > OSDPREADER_STRINGLENGTH) {
+        osdpReaderStats.Dropped++;
+        return false;
+    }
+
+    TOSDPReaderEntry* entry = &osdpReaderQueue[osdpReaderHead & (OSDPREADER_QUEUE - 1)];
+
+    switch (event->Source) {
+        case IDFRAME_SOURCE_CARD:
+        case IDFRAME_SOURCE_NFC:
+            entry->TagType = event->Technology;
+            break;
+        case IDFRAME_SOURCE_BLE:
+            entry->TagType = HFTAG_BLE;
+            break;
+        default:
+            entry->TagType = NOTAG;     // Wiegand reader : format, not a tag type
+            break;
+    }
+    strcpy(entry->IDString, IDString);
+
+    osdpReaderHead++;
+    osdpReaderStats.Queued++;
+    return true;
+}
+
+/**
+ * Run the background tasks of the OSDP application
+ *
+ * Bus, secure channel and replies to the polls. Called between the steps of the main loop.
+ *
+*/
+void osdpReaderService(void)
+{
+    if (!osdpReaderReady) {
+        return;
+    }
+
+    uint32_t ticks = GetSysTicks();
+    uint32_t gap = ticks - osdpReaderServiceTicks;
+
+    OSDPAppBackgroundTasks();
+
+    osdpReaderServiceTicks = ticks;
+    osdpReaderStats.Services++;
+    if (gap > osdpReaderStats.MaxGapTicks) {
+        osdpReaderStats.MaxGapTicks = gap;
+    }
+    if (gap > OSDPREADER_REPLYTIME) {
+        osdpReaderStats.LateServices++;
+    }
+}
+
+/**
+ * Run the foreground tasks of the OSDP application
+ *
+ * Card reports (osdpReaderSearchTag), LEDs and buzzer. Called once per loop.
+ *
+*/
+void osdpReaderTasks(void)
+{
+    if (!osdpReaderReady) {
+        return;
+    }
+
+    OSDPAppForegroundTasks();
+}
+
+/**
+ * Get the OSDP reader counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void osdpReaderGetStats(TOSDPReaderStats* stats)
+{
+    *stats = osdpReaderStats;
+}
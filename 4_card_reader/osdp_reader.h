@@ -0,0 +1,81 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  OSDP READER
+//
+// OSDP peripheral device (PD) built on the OSDP application of apptools.h
+// - Cards, BLE and NFC users reported as OSDP card reads (formatted or raw)
+// - Secure channel (SCBK set once by the controller in installation mode)
+// - Polls answered between the steps of the main loop and of the long operations, the gaps are measured
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __OSDP_READER_H__
+#define __OSDP_READER_H__
+
+#include "id_frame.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef OSDPREADER_ADDRESS
+  #define OSDPREADER_ADDRESS        OSDP_ADDRESS_DIP    // Address on the bus (0 to 126)
+#endif
+
+#ifndef OSDPREADER_BAUDRATE
+  #define OSDPREADER_BAUDRATE       OSDP_BAUDRATE_DIP   // 9600, 19200, 38400, 57600 or 115200
+#endif
+
+#ifndef OSDPREADER_KEYOPTION
+  #define OSDPREADER_KEYOPTION      Key_Option_Fixed_InstallationMode_Once
+#endif
+
+#ifndef OSDPREADER_FORMATTED
+  #define OSDPREADER_FORMATTED      true        // true = card string (osdp_FMT), false = characters of the string as bits (osdp_RAW)
+#endif
+
+#ifndef OSDPREADER_CONNECTIONTIMEOUT
+  #define OSDPREADER_CONNECTIONTIMEOUT  8000UL  // Offline after 8 seconds without a poll of the controller
+#endif
+
+#ifndef OSDPREADER_REPLYTIME
+  #define OSDPREADER_REPLYTIME      200         // Reply delay of the OSDP specification in milliseconds
+#endif
+
+#ifndef OSDPREADER_QUEUE
+  #define OSDPREADER_QUEUE          4           // Identifications waiting for a poll (power of 2)
+#endif
+
+#define OSDPREADER_STRINGLENGTH     64          // Maximum ID length W/O null-termination
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Identification waiting for a poll
+typedef struct
+{
+    int TagType;                // Tag type of the card, HFTAG_BLE for a BLE user
+    char IDString[OSDPREADER_STRINGLENGTH+1];
+} TOSDPReaderEntry;
+
+// Counters reported by the OSDP reader
+typedef struct
+{
+    uint32_t Queued;            // Identifications queued
+    uint32_t Reported;          // Identifications given to the OSDP application
+    uint32_t Dropped;           // Identifications lost (queue full, ID too long)
+    uint32_t Services;          // Calls of the background tasks
+    uint32_t MaxGapTicks;       // Longest time between two calls in milliseconds
+    uint32_t LateServices;      // Gaps longer than OSDPREADER_REPLYTIME (poll possibly answered late)
+} TOSDPReaderStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+bool osdpReaderInit(void);
+bool osdpReaderReport(const char* IDString, const TIDFrameEvent* event);
+void osdpReaderService(void);
+void osdpReaderTasks(void);
+void osdpReaderGetStats(TOSDPReaderStats* stats);
+
+#endif
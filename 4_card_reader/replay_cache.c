@@ -0,0 +1,266 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 REPLAY CACHE
+//
+// Remember the identification tokens accepted by the reader until they expire,
+// so that the same token can not be used a second time.
+//
+// - Slots are looked up with linear probing starting at (digest & mask)
+// - The expiration time of every token falls into a time bucket of width
+//   REPLAYCACHE_BUCKETWIDTH. When the reader time leaves a bucket, all the
+//   entries of this bucket are expired and removed in a single sweep.
+// - If the set is full, entries of the oldest bucket are evicted before expiration
+// - Removal uses backward shift deletion (no tombstones, probes stay short)
+//
+// Memory : REPLAYCACHE_SIZE * 12 bytes + REPLAYCACHE_BUCKETRING * 2 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "replay_cache.h"
+
+#define REPLAYCACHE_MASK            (REPLAYCACHE_SIZE - 1)
+
+#if (REPLAYCACHE_SIZE & REPLAYCACHE_MASK) != 0
+  #error "REPLAYCACHE_SIZE must be a power of two"
+#endif
+
+#define REPLAYCACHE_EVICTBATCH      (REPLAYCACHE_SIZE / 16)  // Entries freed by a forced eviction
+
+#if REPLAYCACHE_MAXLOAD >= REPLAYCACHE_SIZE
+  #error "REPLAYCACHE_MAXLOAD must be lower than REPLAYCACHE_SIZE"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+TReplayCacheEntry replayCacheTable[REPLAYCACHE_SIZE];          // Hash set slots
+uint16_t replayCacheBucketCount[REPLAYCACHE_BUCKETRING];        // Number of entries per time bucket
+
+uint32_t replayCacheCurrentBucket = 0;                          // Time bucket of the reader current time
+
+TReplayCacheStats replayCacheStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the replay cache
+ *
+ * Clear all slots and counters
+ *
+*/
+void replayCacheInit(void)
+{
+    memset(replayCacheTable, 0, sizeof(replayCacheTable));
+    memset(replayCacheBucketCount, 0, sizeof(replayCacheBucketCount));
+    memset(&replayCacheStats, 0, sizeof(replayCacheStats));
+
+    replayCacheCurrentBucket = 0;
+    replayCacheStats.Capacity = REPLAYCACHE_SIZE;
+}
+
+/**
+ * Compute the digest of a token
+ *
+ * 64 bits FNV-1a hash. Not a cryptographic hash, only used to identify a token
+ * that has already been authenticated by the state machine.
+ *
+ * @param token : pointer to the token
+ * @param tokenLength : length of the token in bytes
+ *
+ * @return digest of the token
+*/
+uint64_t replayCacheDigest(const byte* token, int tokenLength)
+{
+    uint64_t digest = 0xcbf29ce484222325ULL;       // FNV offset basis
+
+    for (int i = 0; i < tokenLength; i++) {
+        digest ^= token[i];
+        digest *= 0x00000100000001b3ULL;            // FNV prime
+    }
+    return digest;
+}
+
+/**
+ * Get the time bucket of an expiration time
+ *
+ * @param expirationTime : expiration time in Unix format
+ *
+ * @return bucket number
+*/
+static uint32_t replayCacheBucket(uint32_t expirationTime)
+{
+    return expirationTime / REPLAYCACHE_BUCKETWIDTH;
+}
+
+/**
+ * Remove the entry of a slot
+ *
+ * Backward shift deletion : the following entries of the same probe sequence
+ * are moved back so that no lookup is broken by the new free slot.
+ *
+ * @param slot : index of the slot to free
+ *
+*/
+static void replayCacheRemoveSlot(int slot)
+{
+    replayCacheBucketCount[replayCacheBucket(replayCacheTable[slot].ExpirationTime) % REPLAYCACHE_BUCKETRING]--;
+    replayCacheStats.Occupancy--;
+
+    int next = slot;
+
+    while (true) {
+        next = (next + 1) & REPLAYCACHE_MASK;
+
+        if (replayCacheTable[next].ExpirationTime == 0) {
+            break;
+        }
+
+        // The entry stays if its home slot is cyclically in ]slot, next]
+        int home = replayCacheTable[next].DigestLow & REPLAYCACHE_MASK;
+        bool stays = (slot <= next) ? (slot < home && home <= next) : (slot < home || home <= next);
+
+        if (!stays) {
+            replayCacheTable[slot] = replayCacheTable[next];
+            slot = next;
+        }
+    }
+
+    replayCacheTable[slot].ExpirationTime = 0;
+}
+
+/**
+ * Evict the entries of the buckets older than a bucket
+ *
+ * @param bucket : first bucket to keep
+ * @param maxRemoved : maximum number of entries to remove
+ *
+ * @return number of removed entries
+*/
+static int replayCacheEvictBefore(uint32_t bucket, int maxRemoved)
+{
+    int removed = 0;
+
+    for (int slot = 0; slot < REPLAYCACHE_SIZE && removed < maxRemoved; slot++) {
+        // A removal can move the next entry in this slot, check it again
+        while (removed < maxRemoved && replayCacheTable[slot].ExpirationTime != 0 &&
+               replayCacheBucket(replayCacheTable[slot].ExpirationTime) < bucket) {
+            replayCacheRemoveSlot(slot);
+            removed++;
+        }
+    }
+    return removed;
+}
+
+/**
+ * Advance the time buckets to the current time
+ *
+ * Called once per lookup, sweep the table only when a bucket has expired
+ *
+ * @param currentTime : reader current time in Unix format
+ *
+*/
+static void replayCacheAdvance(uint32_t currentTime)
+{
+    uint32_t bucket = replayCacheBucket(currentTime);
+
+    if (bucket > replayCacheCurrentBucket) {
+        replayCacheCurrentBucket = bucket;
+
+        if (replayCacheStats.Occupancy > 0) {
+            replayCacheStats.Evictions += replayCacheEvictBefore(bucket, REPLAYCACHE_SIZE);
+        }
+    }
+}
+
+/**
+ * Make room for a new entry
+ *
+ * Evict entries of the oldest non empty time buckets until the occupancy is
+ * REPLAYCACHE_EVICTBATCH entries below the maximum load, so that the sweep is
+ * not repeated on every insertion.
+ *
+*/
+static void replayCacheMakeRoom(void)
+{
+    uint32_t bucket = replayCacheCurrentBucket;
+
+    while (replayCacheStats.Occupancy > REPLAYCACHE_MAXLOAD - REPLAYCACHE_EVICTBATCH) {
+        if (replayCacheBucketCount[bucket % REPLAYCACHE_BUCKETRING] != 0) {
+            int toRemove = replayCacheStats.Occupancy - (REPLAYCACHE_MAXLOAD - REPLAYCACHE_EVICTBATCH);
+            replayCacheStats.ForcedEvictions += replayCacheEvictBefore(bucket + 1, toRemove);
+        }
+        bucket++;
+    }
+}
+
+/**
+ * Check a token and insert it in the replay cache
+ *
+ * The expiration time is limited to one validity window after the current time.
+ * A token with a later expiration (reader clock behind the issuer) is kept for
+ * the window only.
+ *
+ * @param digest : digest of the token (see replayCacheDigest)
+ * @param expirationTime : expiration time of the token in Unix format
+ * @param currentTime : reader current time in Unix format
+ *
+ * @return true if the token was not in the cache (first use), else false (replay)
+*/
+bool replayCacheCheckAndInsert(uint64_t digest, uint64_t expirationTime, uint64_t currentTime)
+{
+    uint32_t digestHigh = (uint32_t)(digest >> 32);
+    uint32_t digestLow = (uint32_t) digest;
+
+    replayCacheAdvance((uint32_t) currentTime);
+
+    // Keep the entry at least until the end of the current bucket and at most one window
+    if (expirationTime > currentTime + REPLAYCACHE_WINDOW) {
+        expirationTime = currentTime + REPLAYCACHE_WINDOW;
+    }
+    if (expirationTime < currentTime || expirationTime == 0) {
+        expirationTime = currentTime | 1;
+    }
+
+    // Lookup
+    int slot = digestLow & REPLAYCACHE_MASK;
+
+    while (replayCacheTable[slot].ExpirationTime != 0) {
+        if (replayCacheTable[slot].DigestLow == digestLow && replayCacheTable[slot].DigestHigh == digestHigh) {
+            replayCacheStats.Replays++;
+            return false;
+        }
+        slot = (slot + 1) & REPLAYCACHE_MASK;
+    }
+
+    // Insert, the free slot may have moved if entries have been evicted
+    if (replayCacheStats.Occupancy >= REPLAYCACHE_MAXLOAD) {
+        replayCacheMakeRoom();
+
+        slot = digestLow & REPLAYCACHE_MASK;
+        while (replayCacheTable[slot].ExpirationTime != 0) {
+            slot = (slot + 1) & REPLAYCACHE_MASK;
+        }
+    }
+
+    replayCacheTable[slot].DigestHigh = digestHigh;
+    replayCacheTable[slot].DigestLow = digestLow;
+    replayCacheTable[slot].ExpirationTime = (uint32_t) expirationTime;
+
+    replayCacheBucketCount[replayCacheBucket((uint32_t) expirationTime) % REPLAYCACHE_BUCKETRING]++;
+    replayCacheStats.Occupancy++;
+    replayCacheStats.Accepted++;
+
+    return true;
+}
+
+/**
+ * Get the replay cache counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void replayCacheGetStats(TReplayCacheStats* stats)
+{
+    *stats = replayCacheStats;
+}
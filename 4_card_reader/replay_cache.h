@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 REPLAY CACHE
+//
+// Fixed-size set of the identification tokens recently accepted by the reader
+// - Open addressing with linear probing, no heap, O(1) lookup
+// - Every entry holds a 64 bits digest of the token and its expiration time
+// - Entries are evicted by time buckets aligned to the token expiration window
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __REPLAY_CACHE_H__
+#define __REPLAY_CACHE_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef REPLAYCACHE_SIZE
+  #define REPLAYCACHE_SIZE          256         // Number of slots (power of two), 12 bytes each
+#endif
+
+#ifndef REPLAYCACHE_MAXLOAD
+  #define REPLAYCACHE_MAXLOAD       (REPLAYCACHE_SIZE * 3 / 4)  // Max used slots before forced eviction
+#endif
+
+#ifndef REPLAYCACHE_WINDOW
+  #define REPLAYCACHE_WINDOW        86400UL     // Token validity window in seconds (24h, see middleware)
+#endif
+
+#ifndef REPLAYCACHE_BUCKETS
+  #define REPLAYCACHE_BUCKETS       8           // Number of time buckets in the validity window
+#endif
+
+#define REPLAYCACHE_BUCKETWIDTH     (REPLAYCACHE_WINDOW / REPLAYCACHE_BUCKETS)  // Bucket width in seconds
+#define REPLAYCACHE_BUCKETRING      (REPLAYCACHE_BUCKETS + 2)                   // Buckets alive at the same time
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Slot of the hash set
+typedef struct
+{
+    uint32_t DigestHigh;        // High 32 bits of the token digest
+    uint32_t DigestLow;         // Low 32 bits of the token digest (also used as hash)
+    uint32_t ExpirationTime;    // Expiration time of the token in Unix format, 0 = free slot
+} TReplayCacheEntry;
+
+// Counters reported by the replay cache
+typedef struct
+{
+    int Capacity;               // Number of slots
+    int Occupancy;              // Number of used slots
+    uint32_t Accepted;          // Tokens accepted and stored
+    uint32_t Replays;           // Tokens rejected because already accepted
+    uint32_t Evictions;         // Entries removed because their time bucket expired
+    uint32_t ForcedEvictions;   // Entries removed before expiration because the set was full
+} TReplayCacheStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void replayCacheInit(void);
+uint64_t replayCacheDigest(const byte* token, int tokenLength);
+bool replayCacheCheckAndInsert(uint64_t digest, uint64_t expirationTime, uint64_t currentTime);
+void replayCacheGetStats(TReplayCacheStats* stats);
+
+#endif
@@ -0,0 +1,216 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  TAG SCHEDULE
+//
+// SearchTag probes every technology enabled by SetTagTypes, a site with LF and
+// HF badges pays for all of them on every poll. The schedule narrows the mask:
+//
+// - The TAGSCHEDULE_HOT technologies with the highest score are searched on
+//   every poll, every TAGSCHEDULE_COLDPOLL polls one cold technology is
+//   searched instead (round robin)
+// - A technology with a card in the field stays searched on every poll, a
+//   resting card does not time out between two cold searches
+// - Score = cards entering the field, halved every TAGSCHEDULE_PERIOD. The
+//   ranking is updated with the period, or at once when a cold technology
+//   detects a card
+// - Time-to-detect estimate : half of the interval since the previous search
+//   of the technology (arrival time unknown) + duration of the search
+//
+// Memory : TAGSCHEDULE_SIZE * 24 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "tag_schedule.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+TTagScheduleEntry tagSchedule[TAGSCHEDULE_SIZE];    // Sorted by rank
+
+TTagScheduleStats tagScheduleStats;
+
+unsigned int tagScheduleLFTagTypes;     // Mask of the current SetTagTypes
+unsigned int tagScheduleHFTagTypes;
+uint32_t tagScheduleProbed;             // Bit i : entry i searched by the current poll
+int tagScheduleCold = 0;                // Next cold technology (round robin)
+bool tagScheduleSortPending = false;
+uint32_t tagScheduleReorderTicks;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init the schedule
+ *
+ * One entry per technology of the masks, in configuration order (no traffic yet)
+ *
+ * @param LFTagTypes : configured LF technologies (mask of SetTagTypes)
+ * @param HFTagTypes : configured HF technologies (mask of SetTagTypes)
+ * @param ticks : current system ticks
+ *
+*/
+void tagScheduleInit(unsigned int LFTagTypes, unsigned int HFTagTypes, uint32_t ticks)
+{
+    memset(tagSchedule, 0, sizeof(tagSchedule));
+    memset(&tagScheduleStats, 0, sizeof(tagScheduleStats));
+
+    for (int bit = 0; bit < 64 && tagScheduleStats.Technologies < TAGSCHEDULE_SIZE; bit++) {
+        unsigned int mask = (bit < 32) ? HFTagTypes : LFTagTypes;
+
+        if (mask & (1U << (bit & 0x1F))) {
+            TTagScheduleEntry* entry = &tagSchedule[tagScheduleStats.Technologies++];
+
+            entry->TagType = ((bit < 32) ? HFTAG_MIFARE : LFTAG_EM4102) | (bit & 0x1F);
+            entry->ProbeTicks = ticks;
+        }
+    }
+
+    tagScheduleLFTagTypes = LFTagTypes;
+    tagScheduleHFTagTypes = HFTagTypes;
+    tagScheduleProbed = 0;
+    tagScheduleCold = 0;
+    tagScheduleSortPending = false;
+    tagScheduleReorderTicks = ticks;
+}
+
+/**
+ * Sort the technologies by score (insertion sort, equal scores keep their order)
+ *
+*/
+static void tagScheduleSort(void)
+{
+    for (int i = 1; i < tagScheduleStats.Technologies; i++) {
+        TTagScheduleEntry entry = tagSchedule[i];
+        int j = i;
+
+        while (j > 0 && tagSchedule[j - 1].Score < entry.Score) {
+            tagSchedule[j] = tagSchedule[j - 1];
+            j--;
+        }
+        tagSchedule[j] = entry;
+    }
+    tagScheduleStats.Reorders++;
+}
+
+/**
+ * Set the tag types of the next SearchTag
+ *
+ * @param ticks : current system ticks
+ *
+*/
+void tagScheduleNext(uint32_t ticks)
+{
+    int count = tagScheduleStats.Technologies;
+    int cold = count - TAGSCHEDULE_HOT;
+    unsigned int LFTagTypes = 0;
+    unsigned int HFTagTypes = 0;
+
+    if (count == 0) {
+        return;
+    }
+
+    if ((uint32_t)(ticks - tagScheduleReorderTicks) >= TAGSCHEDULE_PERIOD) {
+        tagScheduleSort();
+        for (int i = 0; i < count; i++) {
+            tagSchedule[i].Score >>= 1;
+        }
+        tagScheduleReorderTicks = ticks;
+        tagScheduleSortPending = false;
+    } else if (tagScheduleSortPending) {
+        tagScheduleSort();
+        tagScheduleSortPending = false;
+    }
+
+    tagScheduleStats.Polls++;
+    tagScheduleProbed = 0;
+
+    if (cold > 0 && tagScheduleStats.Polls % TAGSCHEDULE_COLDPOLL == 0) {
+        tagScheduleProbed |= 1UL << (TAGSCHEDULE_HOT + tagScheduleCold);
+        tagScheduleCold = (tagScheduleCold + 1) % cold;
+        tagScheduleStats.ColdPolls++;
+    } else {
+        for (int i = 0; i < count && i < TAGSCHEDULE_HOT; i++) {
+            tagScheduleProbed |= 1UL << i;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (tagSchedule[i].Found) {
+            tagScheduleProbed |= 1UL << i;      // Card in the field : searched on every poll
+        }
+        if (tagScheduleProbed & (1UL << i)) {
+            if (tagSchedule[i].TagType & HFTAG_MIFARE) {
+                HFTagTypes |= TAGMASK(tagSchedule[i].TagType);
+            } else {
+                LFTagTypes |= TAGMASK(tagSchedule[i].TagType);
+            }
+        }
+    }
+
+    if (LFTagTypes != tagScheduleLFTagTypes || HFTagTypes != tagScheduleHFTagTypes) {
+        SetTagTypes(LFTagTypes, HFTagTypes);
+        tagScheduleLFTagTypes = LFTagTypes;
+        tagScheduleHFTagTypes = HFTagTypes;
+        tagScheduleStats.MaskChanges++;
+    }
+}
+
+/**
+ * Record the result of the SearchTag
+ *
+ * @param TagType : tag type found, NOTAG if no card
+ * @param startTicks : system ticks before the SearchTag
+ * @param ticks : system ticks after the SearchTag
+ *
+*/
+void tagScheduleResult(int TagType, uint32_t startTicks, uint32_t ticks)
+{
+    for (int i = 0; i < tagScheduleStats.Technologies; i++) {
+        TTagScheduleEntry* entry = &tagSchedule[i];
+        bool found = (entry->TagType == TagType);
+
+        if (!(tagScheduleProbed & (1UL << i))) {
+            continue;
+        }
+
+        if (found && !entry->Found) {
+            entry->Detections++;
+            entry->Score++;
+            entry->DetectTicks += (startTicks - entry->ProbeTicks) / 2 + (ticks - startTicks);
+            if (i >= TAGSCHEDULE_HOT) {
+                tagScheduleSortPending = true;
+            }
+        }
+        entry->Found = found;
+        entry->ProbeTicks = startTicks;
+    }
+}
+
+/**
+ * Mean time-to-detect of the active technologies
+ *
+ * @return estimated mean time-to-detect in milliseconds, 0 if no card detected yet
+*/
+uint32_t tagScheduleMeanDetectTicks(void)
+{
+    uint32_t detections = 0;
+    uint32_t detectTicks = 0;
+
+    for (int i = 0; i < tagScheduleStats.Technologies; i++) {
+        detections += tagSchedule[i].Detections;
+        detectTicks += tagSchedule[i].DetectTicks;
+    }
+    return (detections == 0) ? 0 : detectTicks / detections;
+}
+
+/**
+ * Get the schedule counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void tagScheduleGetStats(TTagScheduleStats* stats)
+{
+    *stats = tagScheduleStats;
+    stats->MeanDetectTicks = tagScheduleMeanDetectTicks();
+}
@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  TAG SCHEDULE
+//
+// Choose the tag types searched by every SearchTag from the observed traffic
+// - The technologies seen the most are searched on every poll (hot)
+// - The other technologies are searched one at a time, every few polls (cold)
+// - The ranking is updated periodically with decaying scores
+// - The mean time-to-detect of the technologies is estimated
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TAG_SCHEDULE_H__
+#define __TAG_SCHEDULE_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TAGSCHEDULE_HOT
+  #define TAGSCHEDULE_HOT           2           // Technologies searched on every poll
+#endif
+
+#ifndef TAGSCHEDULE_COLDPOLL
+  #define TAGSCHEDULE_COLDPOLL      8           // Every 8th poll searches one cold technology instead of the hot ones
+#endif
+
+#ifndef TAGSCHEDULE_PERIOD
+  #define TAGSCHEDULE_PERIOD        60000UL     // Ranking updated and scores halved every minute
+#endif
+
+#define TAGSCHEDULE_SIZE            16          // Maximum number of configured technologies
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Configured technology
+typedef struct
+{
+    int TagType;                // LFTAG_xxx or HFTAG_xxx
+    uint32_t Score;             // Detections, halved every TAGSCHEDULE_PERIOD
+    bool Found;                 // The last search of the technology found a card
+    uint32_t ProbeTicks;        // System ticks of the last search of the technology
+    uint32_t Detections;        // Cards entering the field (found after a search without card)
+    uint32_t DetectTicks;       // Accumulated estimated time-to-detect in milliseconds
+} TTagScheduleEntry;
+
+// Counters reported by the schedule
+typedef struct
+{
+    int Technologies;           // Configured technologies
+    uint32_t Polls;             // Searches scheduled
+    uint32_t ColdPolls;         // Searches of a cold technology
+    uint32_t Reorders;          // Ranking updates
+    uint32_t MaskChanges;       // Calls of SetTagTypes
+    uint32_t MeanDetectTicks;   // Estimated mean time-to-detect in milliseconds (tagScheduleMeanDetectTicks)
+} TTagScheduleStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void tagScheduleInit(unsigned int LFTagTypes, unsigned int HFTagTypes, uint32_t ticks);
+void tagScheduleNext(uint32_t ticks);
+void tagScheduleResult(int TagType, uint32_t startTicks, uint32_t ticks);
+uint32_t tagScheduleMeanDetectTicks(void);
+void tagScheduleGetStats(TTagScheduleStats* stats);
+
+#endif
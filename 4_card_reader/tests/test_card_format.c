@@ -0,0 +1,213 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                               TEST CARD FORMAT
+//
+// The default format gives the string of the former ReadCardData (CopyBits +
+// ConvertBinaryToString, radix 16, 2 digits per byte), modelled below since
+// the system library is not built on the host.
+// Benchmark : formatting of a 7 bytes UID, model and cardFormat.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "twn4_host.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+
+#include "../card_format.c"
+
+#define RANDOM_IDS                  100000
+#define BENCHMARK_FORMATS           2000000
+
+/**
+ * Model of the former conversion : the bit range as a right aligned number,
+ * converted by repeated divisions
+ *
+ * @return length of the string
+*/
+static int referenceFormat(const byte* ID, int IDBitCnt, char* CardString, int MaxCardStringLen, int radix, int minDigits)
+{
+    byte number[32];
+    int numberLength = (IDBitCnt + 7) / 8;
+    char digits[300];
+    int length = 0;
+    bool nonZero = true;
+
+    memset(number, 0, sizeof(number));
+    for (int i = 0; i < IDBitCnt; i++) {
+        int position = numberLength * 8 - IDBitCnt + i;
+
+        if ((ID[i >> 3] >> (7 - (i & 7))) & 1) {
+            number[position >> 3] |= 0x80 >> (position & 7);
+        }
+    }
+
+    while (nonZero) {
+        int remainder = 0;
+
+        nonZero = false;
+        for (int i = 0; i < numberLength; i++) {
+            int value = remainder * 256 + number[i];
+
+            number[i] = value / radix;
+            remainder = value % radix;
+            nonZero |= number[i] != 0;
+        }
+        digits[length++] = cardFormatDigitsUpper[remainder];
+    }
+    while (length < minDigits) {
+        digits[length++] = '0';
+    }
+
+    length = MIN(length, MaxCardStringLen);
+    for (int i = 0; i < length; i++) {
+        CardString[i] = digits[length - 1 - i];
+    }
+    CardString[length] = 0;
+    return length;
+}
+
+/**
+ * Former string of the card ID (hexadecimal, 2 digits per byte)
+ *
+ * @return length of the string
+*/
+static int referenceCardString(const byte* ID, int IDBitCnt, char* CardString, int MaxCardStringLen)
+{
+    return referenceFormat(ID, IDBitCnt, CardString, MaxCardStringLen, 16, (IDBitCnt + 7) / 8 * 2);
+}
+
+// Width of the baseline kept : 2 hex digits per byte, also for a bit count not multiple of 8
+static void testDefaultWidth(void)
+{
+    const byte wiegand26[] = {0x03, 0xff, 0xff, 0xc0};
+    const byte UID[] = {0x04, 0x5a, 0x2b, 0x6c, 0x91, 0x3e, 0x80};
+    char cardString[129];
+
+    CHECK(cardFormat(cardFormatTable, wiegand26, 26, cardString, 128) == 8);
+    CHECK(strcmp(cardString, "000FFFFF") == 0);
+
+    CHECK(cardFormat(cardFormatTable, UID, 56, cardString, 128) == 14);
+    CHECK(strcmp(cardString, "045A2B6C913E80") == 0);
+}
+
+// Default format and decimal conversion compared with the model on random IDs
+static void testRandomIDs(void)
+{
+    const TCardFormatOp decimal[] = {CARDFORMAT_NUMBER(10, 0, 0, 0, 0, 0), CARDFORMAT_END};
+    int mismatches = 0;
+
+    srand(1);
+    for (int i = 0; i < RANDOM_IDS; i++) {
+        byte ID[32];
+        int IDBitCnt = 1 + rand() % 256;
+        char expected[300];
+        char cardString[300];
+
+        for (int j = 0; j < (int)sizeof(ID); j++) {
+            ID[j] = (byte)rand();
+        }
+
+        referenceCardString(ID, IDBitCnt, expected, 128);
+        cardFormat(cardFormatTable, ID, IDBitCnt, cardString, 128);
+        mismatches += strcmp(expected, cardString) != 0;
+
+        referenceFormat(ID, IDBitCnt, expected, 128, 10, 0);
+        cardFormat(decimal, ID, IDBitCnt, cardString, 128);
+        mismatches += strcmp(expected, cardString) != 0;
+    }
+    CHECK(mismatches == 0);
+}
+
+// Text, byte order, bit range, widths and truncation
+static void testOperations(void)
+{
+    const byte UID[] = {0x04, 0x5a, 0x2b, 0x6c, 0x91, 0x3e, 0x80};
+    const TCardFormatOp decimal[] = {CARDFORMAT_TEXT("ID:"), CARDFORMAT_NUMBER(10, 0, 0, 0, 0, 0), CARDFORMAT_TEXT(";"),
+                                     CARDFORMAT_END};
+    const TCardFormatOp reverse[] = {CARDFORMAT_NUMBER(16, CARDFORMAT_FLAG_REVERSE | CARDFORMAT_FLAG_LOWERCASE, 0, 32, 0, 0),
+                                     CARDFORMAT_END};
+    const TCardFormatOp fields[] = {CARDFORMAT_NUMBER(10, CARDFORMAT_FLAG_REVERSE, 0, 32, 10, 10), CARDFORMAT_TEXT("|"),
+                                    CARDFORMAT_NUMBER(10, 0, 0, 56, 6, 6), CARDFORMAT_TEXT("|"),
+                                    CARDFORMAT_NUMBER(16, 0, 4, 12, 0, 2), CARDFORMAT_TEXT("|"),
+                                    CARDFORMAT_NUMBER(8, 0, 0, 8, 0, 0), CARDFORMAT_TEXT("|"),
+                                    CARDFORMAT_NUMBER(16, CARDFORMAT_FLAG_BYTEWIDTH, 4, 12, 0, 0), CARDFORMAT_END};
+    char cardString[129];
+
+    cardFormat(decimal, UID, 56, cardString, 128);
+    CHECK(strcmp(cardString, "ID:1225042458394240;") == 0);
+
+    cardFormat(reverse, UID, 32, cardString, 128);
+    CHECK(strcmp(cardString, "6c2b5a04") == 0);
+
+    cardFormat(fields, UID, 56, cardString, 128);
+    CHECK(strcmp(cardString, "2151584108|394240|5A|004|045A") == 0);
+
+    // String too short : high-order digits dropped (least significant kept), never overflowed
+    memset(cardString, 'x', sizeof(cardString));
+    CHECK(cardFormat(decimal, UID, 56, cardString, 5) == 5);
+    CHECK(strcmp(cardString, "ID:40") == 0);
+
+    memset(cardString, 'x', sizeof(cardString));
+    CHECK(cardFormat(cardFormatTable, UID, 56, cardString, 4) == 4);
+    CHECK(strcmp(cardString, "3E80") == 0);
+}
+
+// MaxDigits and string too short drop the same high-order digits, padding first
+static void testHighOrderDropped(void)
+{
+    const byte UID[] = {0x04, 0x5a, 0x2b, 0x6c, 0x91, 0x3e, 0x80};
+    const TCardFormatOp decimal[] = {CARDFORMAT_NUMBER(10, 0, 0, 0, 0, 4), CARDFORMAT_END};
+    const TCardFormatOp padded[] = {CARDFORMAT_NUMBER(10, 0, 0, 0, 20, 0), CARDFORMAT_END};
+    const TCardFormatOp hex[] = {CARDFORMAT_NUMBER(16, 0, 0, 0, 16, 0), CARDFORMAT_END};
+    char cardString[129];
+
+    CHECK(cardFormat(decimal, UID, 56, cardString, 128) == 4);
+    CHECK(strcmp(cardString, "4240") == 0);
+
+    CHECK(cardFormat(padded, UID, 56, cardString, 128) == 20);
+    CHECK(strcmp(cardString, "00001225042458394240") == 0);
+    CHECK(cardFormat(padded, UID, 56, cardString, 18) == 18);
+    CHECK(strcmp(cardString, "001225042458394240") == 0);
+    CHECK(cardFormat(padded, UID, 56, cardString, 6) == 6);
+    CHECK(strcmp(cardString, "394240") == 0);
+
+    CHECK(cardFormat(hex, UID, 56, cardString, 128) == 16);
+    CHECK(strcmp(cardString, "00045A2B6C913E80") == 0);
+    CHECK(cardFormat(hex, UID, 56, cardString, 15) == 15);
+    CHECK(strcmp(cardString, "0045A2B6C913E80") == 0);
+    CHECK(cardFormat(hex, UID, 56, cardString, 5) == 5);
+    CHECK(strcmp(cardString, "13E80") == 0);
+}
+
+// Formatting of a 7 bytes UID : model of the former conversion and cardFormat
+static void benchmarkFormat(void)
+{
+    byte UID[] = {0x04, 0x5a, 0x2b, 0x6c, 0x91, 0x3e, 0x80};
+    char cardString[129];
+    volatile int sink = 0;
+
+    double startMicros = testMicros();
+    for (int i = 0; i < BENCHMARK_FORMATS; i++) {
+        UID[6] = (byte)i;
+        sink += referenceCardString(UID, 56, cardString, 128);
+    }
+    double referenceNanos = (testMicros() - startMicros) * 1000 / BENCHMARK_FORMATS;
+
+    startMicros = testMicros();
+    for (int i = 0; i < BENCHMARK_FORMATS; i++) {
+        UID[6] = (byte)i;
+        sink += cardFormat(cardFormatTable, UID, 56, cardString, 128);
+    }
+    double formatNanos = (testMicros() - startMicros) * 1000 / BENCHMARK_FORMATS;
+
+    printf("  former conversion (model) %.0f ns, cardFormat %.0f ns (host)\n", referenceNanos, formatNanos);
+}
+
+int main(void)
+{
+    testDefaultWidth();
+    testRandomIDs();
+    testOperations();
+    testHighOrderDropped();
+    benchmarkFormat();
+    return TEST_RESULT();
+}
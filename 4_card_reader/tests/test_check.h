@@ -0,0 +1,36 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  TEST CHECK
+//
+// Checks of the tests : a failed check is printed, the test returns the number
+// of failed checks
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TEST_CHECK_H__
+#define __TEST_CHECK_H__
+
+#include <stdio.h>
+#include <time.h>
+
+static int testFailures = 0;
+
+#define CHECK(condition)                                                            \
+    do {                                                                            \
+        if (!(condition)) {                                                         \
+            fprintf(stderr, "%s:%d : check failed : %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++;                                                         \
+        }                                                                           \
+    } while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : (fprintf(stderr, "%d check(s) failed\n", testFailures), 1))
+
+/**
+ * Processor time since the start of the test
+ *
+ * @return time in microseconds
+*/
+static inline double testMicros(void)
+{
+    return (double)clock() * 1e6 / CLOCKS_PER_SEC;
+}
+
+#endif
@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                            TEST ED25519 VERIFICATION
+//
+// RFC 8032 test vectors and OpenSSL signatures (3 bytes and 32 bytes messages),
+// each also tampered (R, S, message, S + L, other key) and rejected.
+// Benchmark : duration of a verification and of the key table on the host.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "twn4_host.h"
+#include "test_check.h"
+
+#include "../ed25519_verify.c"
+
+#define BENCHMARK_VERIFICATIONS     200
+
+// Valid signature (hex)
+typedef struct
+{
+    const char* PublicKey;
+    const char* Signature;
+    const char* Message;
+} TTestVector;
+
+static const TTestVector testVectors[] = {
+    // RFC 8032 7.1, tests 1 to 3
+    {"d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b",
+     ""},
+    {"3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+     "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00",
+     "72"},
+    {"fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+     "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a",
+     "af82"},
+    // OpenSSL
+    {"d2bf9b6b9b8676def75e625ced31dd5c36b21a20cb52cd5357a6c69cf169e48e",
+     "65abe91d178d1d2d2190cbdfdc03b17d158215e111279a342f9ed9df80a37589706431eccc5dee906a4d09e8c337f6e480ea5a93a550bd88f18a948919106401",
+     "9a5857"},
+    // OpenSSL, 32 bytes message as a signed token
+    {"3a2156b6de816c3dc198cf24989bacffdcd5f16b44c37b5ecb69cb2c346110be",
+     "fbccdddf271047cda4c2c7159f4067f6cf0f7ce580ec097356298bc3e593151b310815a0997094cdc0e08185dd50cecbfa1476c4d375fcb81d2d716ba43c4103",
+     "e2afa73b8637d9f51a3d59de624c1cff136f044b5689466de1dc4bf31eed61f7"}
+};
+
+#define TEST_VECTORS    (int)(sizeof(testVectors) / sizeof(testVectors[0]))
+
+/**
+ * Convert hexadecimal characters to bytes
+ *
+ * @param hex : hexadecimal characters
+ * @param bytes : pointer to the bytes
+ *
+ * @return number of bytes
+*/
+static int hexToBytes(const char* hex, byte* bytes)
+{
+    int length = 0;
+
+    for (; hex[0] != 0 && hex[1] != 0; hex += 2) {
+        unsigned int value;
+
+        sscanf(hex, "%2x", &value);
+        bytes[length++] = (byte)value;
+    }
+    return length;
+}
+
+/**
+ * Verify a signature with a public key
+ *
+ * @return true if the signature is valid, else false
+*/
+static bool verify(const byte* publicKey, const byte* signature, const byte* message, int messageLength)
+{
+    return ed25519Init(publicKey) && ed25519Verify(signature, message, messageLength);
+}
+
+/**
+ * Add the group order L to the scalar S of a signature (S + L must be rejected)
+ *
+ * @param signature : pointer to the signature to modify
+*/
+static void addGroupOrder(byte* signature)
+{
+    int carry = 0;
+
+    for (int i = 0; i < 32; i++) {
+        carry += signature[32 + i] + groupOrder[i];
+        signature[32 + i] = (byte)carry;
+        carry >>= 8;
+    }
+}
+
+// Valid signatures accepted, tampered ones rejected
+static void testVectorsAndTampering(void)
+{
+    for (int i = 0; i < TEST_VECTORS; i++) {
+        byte publicKey[32];
+        byte signature[64];
+        byte tampered[64];
+        byte message[32];
+        int messageLength;
+
+        hexToBytes(testVectors[i].PublicKey, publicKey);
+        hexToBytes(testVectors[i].Signature, signature);
+        messageLength = hexToBytes(testVectors[i].Message, message);
+
+        CHECK(verify(publicKey, signature, message, messageLength));
+
+        memcpy(tampered, signature, sizeof(tampered));
+        tampered[i * 5] ^= 0x01;
+        CHECK(!verify(publicKey, tampered, message, messageLength));
+
+        memcpy(tampered, signature, sizeof(tampered));
+        tampered[32 + i * 5] ^= 0x04;
+        CHECK(!verify(publicKey, tampered, message, messageLength));
+
+        memcpy(tampered, signature, sizeof(tampered));
+        addGroupOrder(tampered);
+        CHECK(!verify(publicKey, tampered, message, messageLength));
+
+        if (messageLength > 0) {
+            message[0] ^= 0x80;
+            CHECK(!verify(publicKey, signature, message, messageLength));
+            message[0] ^= 0x80;
+        }
+
+        // Signature of another key
+        byte otherKey[32];
+        hexToBytes(testVectors[(i + 1) % TEST_VECTORS].PublicKey, otherKey);
+        CHECK(!verify(otherKey, signature, message, messageLength));
+    }
+}
+
+// Duration of the key table and of a verification of a 32 bytes message
+static void benchmarkVerification(void)
+{
+    const TTestVector* vector = &testVectors[TEST_VECTORS - 1];
+    byte publicKey[32];
+    byte signature[64];
+    byte message[32];
+    int messageLength;
+    int valid = 0;
+
+    hexToBytes(vector->PublicKey, publicKey);
+    hexToBytes(vector->Signature, signature);
+    messageLength = hexToBytes(vector->Message, message);
+
+    double startMicros = testMicros();
+    for (int i = 0; i < BENCHMARK_VERIFICATIONS; i++) {
+        ed25519Init(publicKey);
+    }
+    double initMicros = (testMicros() - startMicros) / BENCHMARK_VERIFICATIONS;
+
+    startMicros = testMicros();
+    for (int i = 0; i < BENCHMARK_VERIFICATIONS; i++) {
+        valid += ed25519Verify(signature, message, messageLength);
+    }
+    double verifyMicros = (testMicros() - startMicros) / BENCHMARK_VERIFICATIONS;
+
+    CHECK(valid == BENCHMARK_VERIFICATIONS);
+    printf("  key table %.0f us, verification %.0f us (host)\n", initMicros, verifyMicros);
+}
+
+int main(void)
+{
+    testVectorsAndTampering();
+    benchmarkVerification();
+    return TEST_RESULT();
+}
@@ -0,0 +1,225 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                               TEST NDEF STREAM
+//
+// A message with short, empty, long and chunked records gives the same events
+// and payload whatever the size of the chunks fed to the parser (1 to 299
+// bytes), malformed messages are rejected.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "twn4_host.h"
+#include "test_check.h"
+
+#include <stdlib.h>
+
+#include "../ndef_stream.c"
+
+#define MAX_CHUNKSIZE               299
+#define MAX_MESSAGE                 2000
+#define MAX_EVENTS                  1000
+
+#define RECORD_LONG                 0x100       // Header flag of the test : 4 bytes payload length (SR not set)
+
+static byte message[MAX_MESSAGE];
+static int messageLength;
+
+// Events of a parse
+typedef struct
+{
+    char Log[MAX_EVENTS];       // RECORD, RECORDEND and MESSAGEEND in order
+    byte Payload[MAX_MESSAGE];  // Payload of the last record
+    int PayloadLength;
+    bool OffsetError;           // A payload part not following the previous one
+    bool Error;                 // NDEFSTREAM_ERROR returned
+} TParseResult;
+
+/**
+ * Append a record to the message
+ *
+ * @param flags : MB, ME, CF, TNF and RECORD_LONG (SR set for a short payload otherwise)
+ * @param type : type of the record, NULL for none
+ * @param ID : ID of the record, NULL for none
+ * @param payload : pointer to the payload
+ * @param payloadLength : length of the payload
+*/
+static void addRecord(int flags, const char* type, const char* ID, const byte* payload, int payloadLength)
+{
+    bool shortRecord = payloadLength < 256 && !(flags & RECORD_LONG);
+    int typeLength = (type != NULL) ? (int)strlen(type) : 0;
+    int IDLength = (ID != NULL) ? (int)strlen(ID) : 0;
+
+    message[messageLength++] = (byte)(flags | (shortRecord ? NDEFSTREAM_FLAG_SR : 0) | (ID != NULL ? NDEFSTREAM_FLAG_IL : 0));
+    message[messageLength++] = (byte)typeLength;
+    if (shortRecord) {
+        message[messageLength++] = (byte)payloadLength;
+    } else {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            message[messageLength++] = (byte)(payloadLength >> shift);
+        }
+    }
+    if (ID != NULL) {
+        message[messageLength++] = (byte)IDLength;
+    }
+    memcpy(&message[messageLength], type, typeLength);
+    messageLength += typeLength;
+    memcpy(&message[messageLength], ID, IDLength);
+    messageLength += IDLength;
+    memcpy(&message[messageLength], payload, payloadLength);
+    messageLength += payloadLength;
+}
+
+/**
+ * Parse the message fed by chunks
+ *
+ * @param chunkSize : bytes per chunk
+ * @param result : pointer to the events
+*/
+static void parseMessage(int chunkSize, TParseResult* result)
+{
+    TNDEFStream stream;
+    TNDEFStreamPayload payload;
+
+    memset(result, 0, sizeof(TParseResult));
+    ndefStreamInit(&stream);
+
+    for (int offset = 0; offset < messageLength && !result->Error; offset += chunkSize) {
+        int length = MIN(chunkSize, messageLength - offset);
+        int position = 0;
+        int event;
+        char text[120];
+
+        while ((event = ndefStreamNext(&stream, &message[offset], length, &position, &payload)) != NDEFSTREAM_NEEDDATA) {
+            text[0] = 0;
+            switch (event) {
+                case NDEFSTREAM_RECORD:
+                    snprintf(text, sizeof(text), "R%d:%.*s:%.*s ", stream.TNF, stream.TypeLength, (const char*)stream.Type,
+                             stream.IDLength, (const char*)stream.ID);
+                    result->PayloadLength = 0;
+                    break;
+                case NDEFSTREAM_PAYLOAD:
+                    result->OffsetError |= payload.Offset != (uint32_t)result->PayloadLength;
+                    memcpy(&result->Payload[result->PayloadLength], payload.Data, payload.Length);
+                    result->PayloadLength += payload.Length;
+                    break;
+                case NDEFSTREAM_RECORDEND:
+                    snprintf(text, sizeof(text), "E%u ", (unsigned int)stream.PayloadLength);
+                    break;
+                case NDEFSTREAM_MESSAGEEND:
+                    snprintf(text, sizeof(text), "ME");
+                    break;
+                default:
+                    result->Error = true;
+                    break;
+            }
+            strncat(result->Log, text, sizeof(result->Log) - strlen(result->Log) - 1);
+            if (result->Error) {
+                break;
+            }
+        }
+    }
+}
+
+// Same events and payload for every chunk size
+static void testChunkSizes(void)
+{
+    byte payload[1500];
+    TParseResult reference;
+    TParseResult result;
+    int failedSizes = 0;
+
+    for (int i = 0; i < (int)sizeof(payload); i++) {
+        payload[i] = (byte)rand();
+    }
+
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | 0x04, "netprinting.ch:token", "t1", payload, 192);
+    addRecord(0x01, "T", NULL, payload, 0);
+    addRecord(NDEFSTREAM_FLAG_CF | 0x02 | RECORD_LONG, "text/plain", NULL, &payload[10], 100);
+    addRecord(NDEFSTREAM_FLAG_CF | NDEFSTREAM_TNF_UNCHANGED | RECORD_LONG, NULL, NULL, &payload[110], 300);
+    addRecord(NDEFSTREAM_TNF_UNCHANGED, NULL, NULL, &payload[410], 50);
+    addRecord(NDEFSTREAM_FLAG_ME | 0x04, "netprinting.ch:token", NULL, payload, 1000);
+
+    parseMessage(messageLength, &reference);
+    CHECK(!reference.Error && !reference.OffsetError);
+    CHECK(strcmp(reference.Log, "R4:netprinting.ch:token:t1 E192 R1:T: E0 R2:text/plain: E450 R4:netprinting.ch:token: E1000 ME") == 0);
+    CHECK(reference.PayloadLength == 1000 && memcmp(reference.Payload, payload, 1000) == 0);
+
+    for (int chunkSize = 1; chunkSize <= MAX_CHUNKSIZE; chunkSize++) {
+        parseMessage(chunkSize, &result);
+        failedSizes += result.Error || result.OffsetError || strcmp(result.Log, reference.Log) != 0 ||
+                       result.PayloadLength != reference.PayloadLength ||
+                       memcmp(result.Payload, reference.Payload, reference.PayloadLength) != 0;
+    }
+    CHECK(failedSizes == 0);
+
+    // Payload of the chunked record : the 3 parts in order
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | 0x02, "text/plain", NULL, &payload[10], 100);
+    addRecord(NDEFSTREAM_FLAG_CF | NDEFSTREAM_TNF_UNCHANGED, NULL, NULL, &payload[110], 200);
+    addRecord(NDEFSTREAM_FLAG_ME | NDEFSTREAM_TNF_UNCHANGED, NULL, NULL, &payload[310], 150);
+    for (int chunkSize = 1; chunkSize <= MAX_CHUNKSIZE; chunkSize += 7) {
+        parseMessage(chunkSize, &result);
+        CHECK(strcmp(result.Log, "R2:text/plain: E450 ME") == 0);
+        CHECK(result.PayloadLength == 450 && memcmp(result.Payload, &payload[10], 450) == 0);
+    }
+}
+
+// Malformed messages
+static void testErrors(void)
+{
+    const byte payload[3] = {1, 2, 3};
+    TParseResult result;
+
+    // First record without MB
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_ME | 0x04, "x", NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    // MB on the second record
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | 0x04, "x", NULL, payload, 3);
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_ME | 0x04, "y", NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    // CF and ME on the first part
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | NDEFSTREAM_FLAG_ME | 0x04, "x", NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    // CF and ME on a middle part
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | 0x04, "x", NULL, payload, 3);
+    addRecord(NDEFSTREAM_FLAG_CF | NDEFSTREAM_FLAG_ME | NDEFSTREAM_TNF_UNCHANGED, NULL, NULL, payload, 3);
+    addRecord(NDEFSTREAM_TNF_UNCHANGED, NULL, NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    // Next part without TNF unchanged, with a type, with an ID
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | 0x04, "x", NULL, payload, 3);
+    addRecord(NDEFSTREAM_FLAG_ME | 0x04, "y", NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | 0x04, "x", NULL, payload, 3);
+    addRecord(NDEFSTREAM_FLAG_ME | NDEFSTREAM_TNF_UNCHANGED, "y", NULL, payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+
+    messageLength = 0;
+    addRecord(NDEFSTREAM_FLAG_MB | NDEFSTREAM_FLAG_CF | 0x04, "x", NULL, payload, 3);
+    addRecord(NDEFSTREAM_FLAG_ME | NDEFSTREAM_TNF_UNCHANGED, NULL, "i", payload, 3);
+    parseMessage(messageLength, &result);
+    CHECK(result.Error);
+}
+
+int main(void)
+{
+    srand(1);
+    testChunkSizes();
+    testErrors();
+    return TEST_RESULT();
+}
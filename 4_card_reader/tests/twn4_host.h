@@ -0,0 +1,20 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                   TWN4 HOST
+//
+// Definitions of the TWN4 system (twn4.sys.h) used by the modules, to build
+// the modules on the host for the tests
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TWN4_HOST_H__
+#define __TWN4_HOST_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef unsigned char byte;
+
+#define MAX(a,b)            ((a) > (b) ? (a) : (b))
+#define MIN(a,b)            ((a) < (b) ? (a) : (b))
+
+#endif
@@ -0,0 +1,325 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    WIEGAND
+//
+// Send the identifications to a Wiegand input (Data0 / Data1 lines).
+//
+// - wiegandBuild places the facility code and the card number in the bit
+//   ranges of the format (MSB first) and computes the parity bits, wiegandDecode
+//   checks them in a received frame (wiegand_input.c)
+// - wiegandSend queues the frame, the system tick interrupt (wiegandTick) sends one bit
+//   every WIEGAND_INTERVAL milliseconds with SendWiegand (one pulse of
+//   WIEGAND_PULSE microseconds, the only time spent in the interrupt)
+// - WIEGAND_FRAMEGAP of silence after each frame : the receivers delimit the
+//   frames by a timeout, two queued frames sent closer would be read as one
+// - Lines idle high, pulses low (outputs set before the first SendWiegand)
+// - Queue written by the main loop (head), read by the interrupt (tail)
+//
+// Memory : WIEGAND_QUEUE * 16 + 44 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "wiegand.h"
+
+#if (WIEGAND_QUEUE & (WIEGAND_QUEUE - 1)) != 0
+  #error "WIEGAND_QUEUE must be a power of 2"
+#endif
+
+#if WIEGAND_FRAMEGAP < 20
+  #error "WIEGAND_FRAMEGAP must be 20 milliseconds at least (frame timeout of the receivers)"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+const TWiegandFormat wiegandFormats[] = {
+    WIEGAND_FORMAT_ENTRY(26, 1, 8, 9, 16, 1, 12, 13, 12),       // WIEGAND_FORMAT_26
+    WIEGAND_FORMAT_ENTRY(34, 1, 16, 17, 16, 1, 16, 17, 16),     // WIEGAND_FORMAT_34
+    WIEGAND_FORMAT_ENTRY(37, 1, 16, 17, 19, 1, 18, 18, 18),     // WIEGAND_FORMAT_37
+    WIEGAND_FORMAT_ENTRY(37, 0, 0, 1, 35, 1, 18, 18, 18),       // WIEGAND_FORMAT_37NOFAC
+};
+
+TWiegandFrame wiegandQueue[WIEGAND_QUEUE];
+volatile uint8_t wiegandHead = 0;           // Free running index of the next frame queued
+volatile uint8_t wiegandTail = 0;           // Free running index of the frame sent
+
+int wiegandData0 = 0;
+int wiegandData1 = 0;
+
+int wiegandBit = 0;                         // Next bit of the frame sent
+int wiegandWait = 0;                        // Ticks before the next bit
+uint32_t wiegandStartTicks = 0;             // System ticks of the first bit of the frame
+
+TWiegandStats wiegandStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Send the next bit of the queued frames
+ *
+ * Called by the system tick interrupt (1 millisecond)
+ *
+*/
+void wiegandTick(void)
+{
+    if (wiegandWait > 0) {
+        wiegandWait--;      // Also with an empty queue : the gap after a frame runs out meanwhile
+        return;
+    }
+    if (wiegandHead == wiegandTail) {
+        return;
+    }
+
+    TWiegandFrame* frame = &wiegandQueue[wiegandTail & (WIEGAND_QUEUE - 1)];
+    uint32_t ticks = GetSysTicks();
+
+    if (wiegandBit == 0) {
+        wiegandStartTicks = ticks;
+        if (ticks - frame->QueuedTicks > wiegandStats.MaxWaitTicks) {
+            wiegandStats.MaxWaitTicks = ticks - frame->QueuedTicks;
+        }
+    }
+
+    byte bit = (frame->Bits[wiegandBit / 8] << (wiegandBit % 8)) & 0x80;
+
+    SendWiegand(wiegandData0, wiegandData1, WIEGAND_PULSE, 0, &bit, 1);
+    wiegandBit++;
+    wiegandWait = WIEGAND_INTERVAL - 1;
+
+    if (wiegandBit >= frame->BitCount) {
+        uint32_t transmitTicks = ticks - wiegandStartTicks;
+
+        wiegandStats.Frames++;
+        wiegandStats.TransmitTicks += transmitTicks;
+        if (transmitTicks > wiegandStats.MaxTransmitTicks) {
+            wiegandStats.MaxTransmitTicks = transmitTicks;
+        }
+
+        wiegandBit = 0;
+        wiegandWait = WIEGAND_FRAMEGAP - 1;
+        wiegandTail++;
+    }
+}
+
+/**
+ * Init the Wiegand output
+ *
+ * @param GPIOData0 : GPIO of the zeros (GPIO0 to GPIO7)
+ * @param GPIOData1 : GPIO of the ones (GPIO0 to GPIO7)
+ *
+*/
+void wiegandInit(int GPIOData0, int GPIOData1)
+{
+    wiegandData0 = GPIOData0;
+    wiegandData1 = GPIOData1;
+    wiegandHead = 0;
+    wiegandTail = 0;
+    wiegandBit = 0;
+    wiegandWait = 0;
+    memset(&wiegandStats, 0, sizeof(wiegandStats));
+
+    GPIOConfigureOutputs(GPIOData0 | GPIOData1, GPIO_PUPD_NOPULL, GPIO_OTYPE_PUSHPULL);
+    GPIOSetBits(GPIOData0 | GPIOData1);
+}
+
+/**
+ * Write a value in a bit range of a frame
+ *
+ * @param bits : pointer to the frame
+ * @param start : first bit (MSB of the value)
+ * @param count : number of bits
+ * @param value : value
+ *
+*/
+static void wiegandPut(byte* bits, int start, int count, uint64_t value)
+{
+    for (int i = 0; i < count; i++) {
+        int bit = start + count - 1 - i;
+
+        if ((value >> i) & 1) {
+            bits[bit / 8] |= 0x80 >> (bit % 8);
+        }
+    }
+}
+
+/**
+ * Count the ones of a bit range of a frame
+ *
+ * @param bits : pointer to the frame
+ * @param start : first bit
+ * @param count : number of bits
+ *
+ * @return parity of the range : 1 if odd number of ones
+*/
+static int wiegandParity(const byte* bits, int start, int count)
+{
+    int parity = 0;
+
+    for (int bit = start; bit < start + count; bit++) {
+        parity ^= (bits[bit / 8] >> (7 - bit % 8)) & 1;
+    }
+    return parity;
+}
+
+/**
+ * Build a frame
+ *
+ * A value larger than its range is refused (counted as unmapped) : its least
+ * significant bits would be the card number of another person. The facility code
+ * is ignored by the formats without facility.
+ *
+ * @param format : pointer to the format
+ * @param facility : facility code
+ * @param card : card number
+ * @param bits : pointer to the frame (WIEGAND_MAXBITS / 8 bytes)
+ *
+ * @return number of bits of the frame, 0 if a value is out of range
+*/
+int wiegandBuild(const TWiegandFormat* format, uint32_t facility, uint64_t card, byte* bits)
+{
+    memset(bits, 0, WIEGAND_MAXBITS / 8);
+
+    if ((format->FacilityBits > 0 && format->FacilityBits < 32 && (facility >> format->FacilityBits) != 0) ||
+        (format->CardBits < 64 && (card >> format->CardBits) != 0)) {
+        wiegandStats.Unmapped++;
+        return 0;
+    }
+
+    wiegandPut(bits, format->FacilityStart, format->FacilityBits, facility);
+    wiegandPut(bits, format->CardStart, format->CardBits, card);
+
+    // Even parity : total of ones of the range and the parity bit even
+    if (wiegandParity(bits, format->EvenStart, format->EvenBits)) {
+        bits[0] |= 0x80;
+    }
+    // Odd parity : total of ones of the range and the parity bit odd
+    if (!wiegandParity(bits, format->OddStart, format->OddBits)) {
+        wiegandPut(bits, format->BitCount - 1, 1, 1);
+    }
+    return format->BitCount;
+}
+
+/**
+ * Read a bit range of a frame
+ *
+ * @param bits : pointer to the frame
+ * @param start : first bit (MSB of the value)
+ * @param count : number of bits
+ *
+ * @return value
+*/
+static uint64_t wiegandGet(const byte* bits, int start, int count)
+{
+    uint64_t value = 0;
+
+    for (int bit = start; bit < start + count; bit++) {
+        value = (value << 1) | ((bits[bit / 8] >> (7 - bit % 8)) & 1);
+    }
+    return value;
+}
+
+/**
+ * Decode a received frame
+ *
+ * @param format : pointer to the format
+ * @param bits : pointer to the frame (first bit = MSB of bits[0])
+ * @param bitCount : number of bits received
+ * @param facility : pointer to the facility code
+ * @param card : pointer to the card number
+ *
+ * @return true if the length and the parity bits match the format, else false
+*/
+bool wiegandDecode(const TWiegandFormat* format, const byte* bits, int bitCount, uint32_t* facility, uint64_t* card)
+{
+    if (bitCount != format->BitCount ||
+        wiegandParity(bits, format->EvenStart, format->EvenBits) != (int)wiegandGet(bits, 0, 1) ||
+        wiegandParity(bits, format->OddStart, format->OddBits) == (int)wiegandGet(bits, bitCount - 1, 1)) {
+        return false;
+    }
+
+    *facility = wiegandGet(bits, format->FacilityStart, format->FacilityBits);
+    *card = wiegandGet(bits, format->CardStart, format->CardBits);
+    return true;
+}
+
+/**
+ * Queue an identification
+ *
+ * @param facility : facility code
+ * @param card : card number
+ *
+ * @return true if queued, false if dropped (queue full) or out of the range of the format
+*/
+bool wiegandSend(uint32_t facility, uint64_t card)
+{
+    if ((uint8_t)(wiegandHead - wiegandTail) >= WIEGAND_QUEUE) {
+        wiegandStats.Dropped++;
+        return false;
+    }
+
+    TWiegandFrame* frame = &wiegandQueue[wiegandHead & (WIEGAND_QUEUE - 1)];
+
+    frame->BitCount = wiegandBuild(&wiegandFormats[WIEGAND_FORMAT], facility, card, frame->Bits);
+    if (frame->BitCount == 0) {
+        return false;
+    }
+    frame->QueuedTicks = GetSysTicks();
+    wiegandHead++;              // Published after the frame : the interrupt sends it from the next tick
+    return true;
+}
+
+/**
+ * Queue an identification given as a string
+ *
+ * The string is the card number in the radix (card string or user ID)
+ *
+ * @param IDString : null-terminated ID
+ * @param radix : radix of the ID (2 to 36)
+ * @param facility : facility code
+ *
+ * @return true if queued, false if not a number, out of range or dropped
+*/
+bool wiegandSendString(const char* IDString, int radix, uint32_t facility)
+{
+    uint64_t card = 0;
+
+    if (*IDString == 0) {
+        wiegandStats.Unmapped++;
+        return false;
+    }
+
+    for (const char* c = IDString; *c != 0; c++) {
+        int digit = (*c >= '0' && *c <= '9') ? *c - '0' :
+                    (*c >= 'a' && *c <= 'z') ? *c - 'a' + 10 :
+                    (*c >= 'A' && *c <= 'Z') ? *c - 'A' + 10 : radix;
+
+        if (digit >= radix || card > (UINT64_MAX - digit) / radix) {
+            wiegandStats.Unmapped++;     // Not a number or larger than 64 bits
+            return false;
+        }
+        card = card * radix + digit;
+    }
+    return wiegandSend(facility, card);
+}
+
+/**
+ * Check if a frame is being sent
+ *
+ * @return true if frames are queued, else false
+*/
+bool wiegandBusy(void)
+{
+    return wiegandHead != wiegandTail;
+}
+
+/**
+ * Get the Wiegand counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void wiegandGetStats(TWiegandStats* stats)
+{
+    *stats = wiegandStats;
+}
@@ -0,0 +1,104 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    WIEGAND
+//
+// Wiegand output of the identifications (door controllers, access panels)
+// - Frame built from a format table : facility code, card number, parity bits
+// - Bits sent one per WIEGAND_INTERVAL by the system tick interrupt, the main
+//   loop (BLE) is never held by the pulse train
+// - Frames queued back to back separated by WIEGAND_FRAMEGAP : never merged by
+//   the receiver
+// - Transmit time and frames dropped or not mapped are counted, an ID out of
+//   the range of the format is never sent truncated
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __WIEGAND_H__
+#define __WIEGAND_H__
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Formats of wiegandFormats
+#define WIEGAND_FORMAT_26           0       // H10301 : 8 bits facility, 16 bits card
+#define WIEGAND_FORMAT_34           1       // H10306 : 16 bits facility, 16 bits card
+#define WIEGAND_FORMAT_37           2       // H10304 : 16 bits facility, 19 bits card
+#define WIEGAND_FORMAT_37NOFAC      3       // H10302 : 35 bits card, no facility
+
+#ifndef WIEGAND_FORMAT
+  #define WIEGAND_FORMAT            WIEGAND_FORMAT_26
+#endif
+
+#ifndef WIEGAND_PULSE
+  #define WIEGAND_PULSE             100     // Pulse width in microseconds
+#endif
+
+#ifndef WIEGAND_INTERVAL
+  #define WIEGAND_INTERVAL          2       // Time between the pulses in milliseconds (system ticks)
+#endif
+
+#ifndef WIEGAND_FRAMEGAP
+  #define WIEGAND_FRAMEGAP          25      // Silence after a frame in milliseconds : longer than the frame timeout of the receivers (WIEGANDINPUT_GAP)
+#endif
+
+#ifndef WIEGAND_QUEUE
+  #define WIEGAND_QUEUE             4       // Frames waiting for the transmission (power of 2)
+#endif
+
+#define WIEGAND_MAXBITS             64      // Longest frame
+
+// Entry of the format table : total bits, facility and card bit ranges, parity ranges
+// The even parity is the first bit, the odd parity the last one (bit 0 = first bit sent)
+#define WIEGAND_FORMAT_ENTRY(bits, facilityStart, facilityBits, cardStart, cardBits, evenStart, evenBits, oddStart, oddBits) \
+                                    {bits, facilityStart, facilityBits, cardStart, cardBits, evenStart, evenBits, oddStart, oddBits}
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Wiegand format
+typedef struct
+{
+    byte BitCount;
+    byte FacilityStart;
+    byte FacilityBits;          // 0 = no facility code
+    byte CardStart;
+    byte CardBits;
+    byte EvenStart;             // Bits covered by the even parity (first bit)
+    byte EvenBits;
+    byte OddStart;              // Bits covered by the odd parity (last bit)
+    byte OddBits;
+} TWiegandFormat;
+
+// Frame waiting for the transmission
+typedef struct
+{
+    byte Bits[WIEGAND_MAXBITS / 8];     // First bit sent = MSB of Bits[0]
+    int BitCount;
+    uint32_t QueuedTicks;
+} TWiegandFrame;
+
+// Counters reported by the Wiegand output
+typedef struct
+{
+    uint32_t Frames;            // Frames sent
+    uint32_t Dropped;           // Frames dropped (queue full)
+    uint32_t Unmapped;          // IDs not sent : not a number, card number or facility code too large for the format
+    uint32_t TransmitTicks;     // Accumulated time from the first to the last pulse in milliseconds
+    uint32_t MaxTransmitTicks;  // Longest transmission in milliseconds
+    uint32_t MaxWaitTicks;      // Longest wait in the queue in milliseconds
+} TWiegandStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void wiegandInit(int GPIOData0, int GPIOData1);
+int wiegandBuild(const TWiegandFormat* format, uint32_t facility, uint64_t card, byte* bits);
+bool wiegandDecode(const TWiegandFormat* format, const byte* bits, int bitCount, uint32_t* facility, uint64_t* card);
+bool wiegandSend(uint32_t facility, uint64_t card);
+bool wiegandSendString(const char* IDString, int radix, uint32_t facility);
+bool wiegandBusy(void);
+void wiegandTick(void);
+void wiegandGetStats(TWiegandStats* stats);
+
+#endif
@@ -0,0 +1,310 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 WIEGAND INPUT
+//
+// Decode the frames of a Wiegand reader wired to the TWN4.
+//
+// - Data0 / Data1 interrupts : bit added at the head of the ring, gap timer
+//   restarted (the first bit of a frame also keeps its system ticks)
+// - System tick interrupt (wiegandInputTick) : end of frame added when the gap
+//   timer expires, the system ticks of its first bit in the frame ring (one
+//   entry per end of frame, the latency stays right when frames queue up)
+// - Main loop (wiegandInputRead) : ring read from the tail, the bits of a frame
+//   gathered up to the end of frame, then checked with the accepted formats
+// - Head written only by the interrupts, tail only by the main loop. A full
+//   ring drops the bits, the frame ends with an overrun marker instead (the
+//   last entry is kept for it, the next frame never merges with a truncated one).
+//   A full frame ring also ends the frame with an overrun marker
+// - The facility code and the card number (frame without its parity bits) are
+//   returned as an ID (MSB first), converted by the card format as the IDs of
+//   SearchTag : the same card number of two facilities gives two IDs
+//
+// Memory : WIEGANDINPUT_RING + 4 * WIEGANDINPUT_FRAMES + 50 bytes
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "wiegand_input.h"
+
+#if (WIEGANDINPUT_RING & (WIEGANDINPUT_RING - 1)) != 0 || WIEGANDINPUT_RING > 256
+  #error "WIEGANDINPUT_RING must be a power of 2 (maximum 256)"
+#endif
+
+#if (WIEGANDINPUT_FRAMES & (WIEGANDINPUT_FRAMES - 1)) != 0 || WIEGANDINPUT_FRAMES > 128
+  #error "WIEGANDINPUT_FRAMES must be a power of 2 (maximum 128)"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE VARIABLES
+//////////////////////////////////////////////////////////////////////////////////////
+
+byte wiegandInputRing[WIEGANDINPUT_RING];
+volatile uint8_t wiegandInputHead = 0;      // Free running index of the next entry written (interrupts)
+volatile uint8_t wiegandInputTail = 0;      // Free running index of the next entry read (main loop)
+volatile bool wiegandInputDropping = false; // Bits of the current frame dropped (ring full)
+volatile uint32_t wiegandInputLost = 0;     // Frames dropped entirely by the interrupts
+
+volatile int wiegandInputGap = 0;           // Ticks before the end of the frame, 0 = idle
+volatile uint32_t wiegandInputStartTicks = 0;   // System ticks of the first bit of the frame in progress
+
+uint32_t wiegandInputStarts[WIEGANDINPUT_FRAMES];   // System ticks of the first bit of the frames ended (END entries)
+volatile uint8_t wiegandInputStartHead = 0;         // Free running index, written by the interrupts
+volatile uint8_t wiegandInputStartTail = 0;         // Free running index, written by the main loop
+
+byte wiegandInputFrame[WIEGAND_MAXBITS / 8];    // Frame gathered by the main loop
+int wiegandInputBitCount = 0;
+
+TWiegandInputStats wiegandInputStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Add an entry to the ring
+ *
+ * Interrupt context
+ *
+ * @param value : bit value, WIEGANDINPUT_END or WIEGANDINPUT_OVERRUN
+ * @param free : entries that must stay free after this one
+ *
+ * @return true if added, false if the ring is full
+*/
+static bool wiegandInputPush(byte value, int free)
+{
+    if ((uint16_t)(uint8_t)(wiegandInputHead - wiegandInputTail) + free >= WIEGANDINPUT_RING - 1) {
+        return false;
+    }
+    wiegandInputRing[wiegandInputHead & (WIEGANDINPUT_RING - 1)] = value;
+    wiegandInputHead++;
+    return true;
+}
+
+/**
+ * Pulse on a data line
+ *
+ * Interrupt context
+ *
+ * @param value : 0 (Data0) or 1 (Data1)
+ *
+*/
+static void wiegandInputBit(byte value)
+{
+    if (wiegandInputGap == 0) {
+        wiegandInputStartTicks = GetSysTicks();
+    }
+    if (!wiegandInputPush(value, 1)) {
+        wiegandInputDropping = true;
+    }
+    wiegandInputGap = WIEGANDINPUT_GAP;
+}
+
+/**
+ * Data0 interrupt
+ *
+*/
+static void wiegandInputData0(void)
+{
+    wiegandInputBit(0);
+}
+
+/**
+ * Data1 interrupt
+ *
+*/
+static void wiegandInputData1(void)
+{
+    wiegandInputBit(1);
+}
+
+/**
+ * End of frame detection
+ *
+ * Called by the system tick interrupt (1 millisecond)
+ *
+*/
+void wiegandInputTick(void)
+{
+    if (wiegandInputGap > 0 && --wiegandInputGap == 0) {
+        bool startFull = (uint8_t)(wiegandInputStartHead - wiegandInputStartTail) >= WIEGANDINPUT_FRAMES;
+
+        if (wiegandInputDropping || startFull) {
+            if (!wiegandInputPush(WIEGANDINPUT_OVERRUN, 0)) {
+                wiegandInputLost++;     // No bit of the frame in the ring
+            }
+        } else if (wiegandInputPush(WIEGANDINPUT_END, 0)) {
+            wiegandInputStarts[wiegandInputStartHead & (WIEGANDINPUT_FRAMES - 1)] = wiegandInputStartTicks;
+            wiegandInputStartHead++;
+        } else {
+            wiegandInputLost++;
+        }
+        wiegandInputDropping = false;
+    }
+}
+
+/**
+ * Interrupt number of a GPIO
+ *
+ * @param GPIO : GPIO0 to GPIO7
+ *
+ * @return INTNO_GPIOx_TRIGGERED
+*/
+static int wiegandInputInterrupt(int GPIO)
+{
+    int index = 0;
+
+    while (GPIO > 1) {
+        GPIO >>= 1;
+        index++;
+    }
+    return INTNO_GPIO0_TRIGGERED + index;
+}
+
+/**
+ * Init the Wiegand input
+ *
+ * @param GPIOData0 : GPIO of the zeros (GPIO0 to GPIO7)
+ * @param GPIOData1 : GPIO of the ones (GPIO0 to GPIO7)
+ *
+*/
+void wiegandInputInit(int GPIOData0, int GPIOData1)
+{
+    wiegandInputHead = 0;
+    wiegandInputTail = 0;
+    wiegandInputDropping = false;
+    wiegandInputLost = 0;
+    wiegandInputGap = 0;
+    wiegandInputStartHead = 0;
+    wiegandInputStartTail = 0;
+    wiegandInputBitCount = 0;
+    memset(&wiegandInputStats, 0, sizeof(wiegandInputStats));
+
+    GPIOConfigureInputs(GPIOData0 | GPIOData1, WIEGANDINPUT_PULL);
+    GPIOConfigureInterrupt(GPIOData0 | GPIOData1, true, WIEGANDINPUT_EDGE);
+    SetInterruptHandler(wiegandInputData0, wiegandInputInterrupt(GPIOData0));
+    SetInterruptHandler(wiegandInputData1, wiegandInputInterrupt(GPIOData1));
+}
+
+/**
+ * Check a complete frame
+ *
+ * @param ID : pointer to the facility code and card number (WIEGAND_MAXBITS / 8 bytes)
+ * @param IDBitCnt : pointer to the bit count of the ID (facility and card bits)
+ * @param format : pointer to the format found (WIEGAND_FORMAT_xxx)
+ *
+ * @return true if the frame matches an accepted format, else false
+*/
+static bool wiegandInputDecode(byte* ID, int* IDBitCnt, int* format)
+{
+    bool knownLength = false;
+
+    for (int i = 0; i < (int)(sizeof(wiegandFormats) / sizeof(wiegandFormats[0])); i++) {
+        const TWiegandFormat* entry = &wiegandFormats[i];
+        uint32_t facility;
+        uint64_t card;
+
+        if ((WIEGANDINPUT_FORMATS & WIEGANDINPUT_MASK(i)) == 0 || entry->BitCount != wiegandInputBitCount) {
+            continue;
+        }
+        knownLength = true;
+
+        if (wiegandDecode(entry, wiegandInputFrame, wiegandInputBitCount, &facility, &card)) {
+            // Facility code then card number, MSB first, left aligned
+            int bitCount = entry->FacilityBits + entry->CardBits;
+            uint64_t value = ((uint64_t)facility << entry->CardBits) | card;
+
+            memset(ID, 0, WIEGAND_MAXBITS / 8);
+            for (int bit = 0; bit < bitCount; bit++) {
+                if ((value >> (bitCount - 1 - bit)) & 1) {
+                    ID[bit / 8] |= 0x80 >> (bit % 8);
+                }
+            }
+            *IDBitCnt = bitCount;
+            *format = i;
+            return true;
+        }
+    }
+
+    if (knownLength) {
+        wiegandInputStats.ParityErrors++;
+    } else {
+        wiegandInputStats.UnknownFormats++;
+    }
+    return false;
+}
+
+/**
+ * Read the next frame received
+ *
+ * @param ID : pointer to the facility code and card number (WIEGAND_MAXBITS / 8 bytes)
+ * @param IDBitCnt : pointer to the bit count of the ID
+ * @param format : pointer to the format of the frame (WIEGAND_FORMAT_xxx)
+ * @param startTicks : pointer to the system ticks of the first bit
+ *
+ * @return true if a frame is decoded, else false
+*/
+bool wiegandInputRead(byte* ID, int* IDBitCnt, int* format, uint32_t* startTicks)
+{
+    while (wiegandInputTail != wiegandInputHead) {
+        byte value = wiegandInputRing[wiegandInputTail & (WIEGANDINPUT_RING - 1)];
+
+        wiegandInputTail++;
+
+        if (value != WIEGANDINPUT_END && value != WIEGANDINPUT_OVERRUN) {
+            if (wiegandInputBitCount == 0) {
+                memset(wiegandInputFrame, 0, sizeof(wiegandInputFrame));
+            }
+            if (wiegandInputBitCount < WIEGAND_MAXBITS) {
+                wiegandInputFrame[wiegandInputBitCount / 8] |= value << (7 - wiegandInputBitCount % 8);
+            }
+            wiegandInputBitCount++;     // Longer frames : unknown length
+            continue;
+        }
+
+        // End of frame
+        bool decoded = false;
+        uint32_t frameStart = 0;
+
+        if (value == WIEGANDINPUT_OVERRUN) {
+            wiegandInputStats.Overruns++;
+        } else {
+            frameStart = wiegandInputStarts[wiegandInputStartTail & (WIEGANDINPUT_FRAMES - 1)];
+            wiegandInputStartTail++;
+            if (wiegandInputBitCount > 0) {
+                decoded = wiegandInputDecode(ID, IDBitCnt, format);
+            }
+        }
+        wiegandInputBitCount = 0;
+
+        if (decoded) {
+            uint32_t frameTicks = GetSysTicks() - frameStart;
+
+            *startTicks = frameStart;
+            wiegandInputStats.Frames++;
+            if (frameTicks > wiegandInputStats.MaxFrameTicks) {
+                wiegandInputStats.MaxFrameTicks = frameTicks;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Check if a frame is being received
+ *
+ * @return true if bits are waiting or a frame is in progress, else false
+*/
+bool wiegandInputBusy(void)
+{
+    return wiegandInputGap != 0 || wiegandInputTail != wiegandInputHead;
+}
+
+/**
+ * Get the Wiegand input counters
+ *
+ * @param stats : pointer to the counters to fill
+ *
+*/
+void wiegandInputGetStats(TWiegandInputStats* stats)
+{
+    *stats = wiegandInputStats;
+    stats->Overruns += wiegandInputLost;
+}
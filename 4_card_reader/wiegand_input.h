@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 WIEGAND INPUT
+//
+// Wiegand receiver : a legacy reader connected to two GPIOs of the TWN4
+// - Pulses captured by the GPIO interrupts in a lock-free bit ring
+// - End of frame found by the system tick interrupt (no pulse for WIEGANDINPUT_GAP)
+// - Length and parity checked with the formats of wiegand.h
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __WIEGAND_INPUT_H__
+#define __WIEGAND_INPUT_H__
+
+#include "wiegand.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+#define WIEGANDINPUT_MASK(format)   (1 << (format))
+
+#ifndef WIEGANDINPUT_FORMATS
+  #define WIEGANDINPUT_FORMATS      (WIEGANDINPUT_MASK(WIEGAND_FORMAT_26) | WIEGANDINPUT_MASK(WIEGAND_FORMAT_34) | \
+                                     WIEGANDINPUT_MASK(WIEGAND_FORMAT_37))      // Formats accepted (wiegandFormats)
+#endif
+
+#ifndef WIEGANDINPUT_GAP
+  #define WIEGANDINPUT_GAP          10          // End of frame after 10 milliseconds without pulse
+#endif
+
+#ifndef WIEGANDINPUT_RING
+  #define WIEGANDINPUT_RING         256         // Bits and ends of frame waiting for the main loop (power of 2, maximum 256)
+#endif
+
+#ifndef WIEGANDINPUT_EDGE
+  #define WIEGANDINPUT_EDGE         TRIGGER_FALLING     // Lines idle high, pulses low
+#endif
+
+#ifndef WIEGANDINPUT_PULL
+  #define WIEGANDINPUT_PULL         GPIO_PUPD_PULLUP
+#endif
+
+#ifndef WIEGANDINPUT_FRAMES
+  #define WIEGANDINPUT_FRAMES       8           // Frames ended waiting for the main loop (power of 2, maximum 128)
+#endif
+
+#define WIEGANDINPUT_END            2           // Ring entry : end of frame (else bit value)
+#define WIEGANDINPUT_OVERRUN        3           // Ring entry : end of a frame with bits dropped
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Counters reported by the Wiegand input
+typedef struct
+{
+    uint32_t Frames;            // Frames decoded
+    uint32_t ParityErrors;      // Frames of a known length with wrong parity bits
+    uint32_t UnknownFormats;    // Frames of a length not accepted (noise, other formats)
+    uint32_t Overruns;          // Frames lost because the bit or frame ring was full
+    uint32_t MaxFrameTicks;     // Longest time from the first bit to the decoding in milliseconds
+} TWiegandInputStats;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void wiegandInputInit(int GPIOData0, int GPIOData1);
+void wiegandInputTick(void);
+bool wiegandInputRead(byte* ID, int* IDBitCnt, int* format, uint32_t* startTicks);
+bool wiegandInputBusy(void);
+void wiegandInputGetStats(TWiegandInputStats* stats);
+
+#endif
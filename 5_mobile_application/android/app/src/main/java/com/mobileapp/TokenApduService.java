@@ -0,0 +1,188 @@
+package com.mobileapp;
+
+import android.nfc.cardemulation.HostApduService;
+import android.os.Bundle;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.LinkedList;
+import java.util.List;
+
+/**
+ * Deliver the signed identification tokens by NFC (host card emulation).
+ *
+ * The reader selects the application AID F0505543494431, the response is a one-time challenge of the
+ * middleware (16 bytes) followed by 90 00. The reader authenticates with the challenge encrypted by its
+ * key (80 10 00 00 10 + 16 bytes), the response is the next token (the same 192 hex characters as the
+ * BLE write) only if it matches the expected response given by the middleware. The reader confirms the
+ * result (80 12 P1 00), the token is removed only then : a torn transaction keeps it for the next tap.
+ * Each challenge is disclosed once, a reader without the key never receives a token.
+ */
+public class TokenApduService extends HostApduService {
+
+  private static final byte[] SELECT_APDU = {
+      0x00, (byte) 0xa4, 0x04, 0x00, 0x07, (byte) 0xf0, 0x50, 0x55, 0x43, 0x49, 0x44, 0x31};
+  private static final byte[] AUTHENTICATE_APDU = {(byte) 0x80, 0x10, 0x00, 0x00, 0x10};
+  private static final byte[] CONFIRM_APDU = {(byte) 0x80, 0x12};
+  private static final byte[] SW_OK = {(byte) 0x90, 0x00};
+  private static final byte[] SW_NO_TOKEN = {0x6a, (byte) 0x88};
+  private static final byte[] SW_CONDITIONS_NOT_SATISFIED = {0x69, (byte) 0x85};
+  private static final byte[] SW_SECURITY_NOT_SATISFIED = {0x69, (byte) 0x82};
+  private static final byte[] SW_INS_NOT_SUPPORTED = {0x6d, 0x00};
+
+  private static final int CHALLENGE_LENGTH = 16;
+  private static final long TOKEN_SKEW = 300;    // Token accepted by the reader 300 s before its start at most (CREDENTIAL_SKEW of the card reader)
+
+  private static final LinkedList<String> tokens = new LinkedList<>();
+  private static final LinkedList<String[]> challenges = new LinkedList<>();  // {challenge, expected response} in hex
+
+  private static String[] currentChallenge;   // Challenge disclosed to the reader, waiting for its response
+  private static String sentToken;            // Token sent to the reader, waiting for its confirmation
+
+  /** Replace the tokens, ordered by expiration time. */
+  static synchronized void setTokens(List<String> newTokens) {
+    tokens.clear();
+    tokens.addAll(newTokens);
+  }
+
+  /** Tokens not confirmed by a reader yet. */
+  static synchronized List<String> getTokens() {
+    return new ArrayList<>(tokens);
+  }
+
+  /** Remove a token confirmed by a reader (BLE). */
+  static synchronized void removeToken(String token) {
+    tokens.remove(token);
+  }
+
+  /** Replace the reader challenges ({challenge, response} in hex). */
+  static synchronized void setChallenges(List<String[]> newChallenges) {
+    challenges.clear();
+    challenges.addAll(newChallenges);
+  }
+
+  /** Number of reader challenges not used yet. */
+  static synchronized int challengeCount() {
+    return challenges.size();
+  }
+
+  /** Next reader challenge, removed (each challenge is used once), null if none. */
+  static synchronized String[] takeChallenge() {
+    return challenges.pollFirst();
+  }
+
+  /** Start time of a token (characters 16 to 31). */
+  private static long tokenStart(String token) {
+    return Long.parseLong(token.substring(16, 32), 16);
+  }
+
+  /**
+   * Next valid token, kept until confirmed, null if none : expired tokens (expiration time : characters
+   * 32 to 47) removed, the first one whose window has started is sent, the later ones wait for the next taps.
+   */
+  private static String nextToken() {
+    long now = System.currentTimeMillis() / 1000;
+
+    tokens.removeIf(token -> Long.parseLong(token.substring(32, 48), 16) <= now);
+    for (String token : tokens) {
+      if (tokenStart(token) <= now + TOKEN_SKEW) {
+        return token;
+      }
+    }
+    return null;
+  }
+
+  private static boolean startsWith(byte[] apdu, byte[] header) {
+    return apdu.length >= header.length && Arrays.equals(Arrays.copyOf(apdu, header.length), header);
+  }
+
+  private static byte[] hexToBytes(String hex) {
+    byte[] bytes = new byte[hex.length() / 2];
+    for (int i = 0; i < bytes.length; i++) {
+      bytes[i] = (byte) Integer.parseInt(hex.substring(2 * i, 2 * i + 2), 16);
+    }
+    return bytes;
+  }
+
+  private static byte[] withStatus(byte[] data) {
+    byte[] response = Arrays.copyOf(data, data.length + 2);
+    response[data.length] = SW_OK[0];
+    response[data.length + 1] = SW_OK[1];
+    return response;
+  }
+
+  /** SELECT : disclose the next challenge. */
+  private static synchronized byte[] select() {
+    currentChallenge = null;
+    sentToken = null;
+
+    if (nextToken() == null) {
+      return SW_NO_TOKEN;
+    }
+    currentChallenge = challenges.pollFirst();
+    if (currentChallenge == null) {
+      return SW_CONDITIONS_NOT_SATISFIED;   // No challenge left : new batch from the middleware needed
+    }
+    return withStatus(hexToBytes(currentChallenge[0]));
+  }
+
+  /** Reader response to the challenge : the token only if it is the expected response. */
+  private static synchronized byte[] authenticate(byte[] apdu) {
+    String[] challenge = currentChallenge;
+
+    currentChallenge = null;
+    if (challenge == null || apdu.length < AUTHENTICATE_APDU.length + CHALLENGE_LENGTH) {
+      return SW_CONDITIONS_NOT_SATISFIED;
+    }
+
+    byte[] response = Arrays.copyOfRange(apdu, AUTHENTICATE_APDU.length, AUTHENTICATE_APDU.length + CHALLENGE_LENGTH);
+    if (!MessageDigest.isEqual(response, hexToBytes(challenge[1]))) {
+      return SW_SECURITY_NOT_SATISFIED;     // Reader without the key
+    }
+
+    sentToken = nextToken();
+    if (sentToken == null) {
+      return SW_NO_TOKEN;
+    }
+    return withStatus(sentToken.getBytes(StandardCharsets.US_ASCII));
+  }
+
+  /**
+   * Reader confirmation (P1 : 00 = identified, 01 = rejected) : a used token is removed, a rejected one
+   * only if its window has started (a reader with a late clock rejects a token valid for the next taps).
+   */
+  private static synchronized byte[] confirm(byte[] apdu) {
+    if (sentToken == null) {
+      return SW_CONDITIONS_NOT_SATISFIED;
+    }
+    boolean rejected = apdu.length > 2 && apdu[2] != 0;
+    if (!rejected || tokenStart(sentToken) <= System.currentTimeMillis() / 1000) {
+      tokens.remove(sentToken);
+    }
+    sentToken = null;
+    return SW_OK;
+  }
+
+  @Override
+  public byte[] processCommandApdu(byte[] commandApdu, Bundle extras) {
+    if (startsWith(commandApdu, SELECT_APDU)) {
+      return select();
+    }
+    if (startsWith(commandApdu, AUTHENTICATE_APDU)) {
+      return authenticate(commandApdu);
+    }
+    if (startsWith(commandApdu, CONFIRM_APDU)) {
+      return confirm(commandApdu);
+    }
+    return SW_INS_NOT_SUPPORTED;
+  }
+
+  @Override
+  public void onDeactivated(int reason) {
+    synchronized (TokenApduService.class) {
+      currentChallenge = null;      // Disclosed, never used again
+      sentToken = null;             // Not confirmed : kept for the next tap
+    }
+  }
+}
@@ -0,0 +1,79 @@
+package com.mobileapp;
+
+import com.facebook.react.bridge.Arguments;
+import com.facebook.react.bridge.Promise;
+import com.facebook.react.bridge.ReactApplicationContext;
+import com.facebook.react.bridge.ReactContextBaseJavaModule;
+import com.facebook.react.bridge.ReactMethod;
+import com.facebook.react.bridge.ReadableArray;
+import com.facebook.react.bridge.ReadableMap;
+import com.facebook.react.bridge.WritableArray;
+import com.facebook.react.bridge.WritableMap;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Tokens and reader challenges of the NFC service, shared with the BLE component (NativeModules.NFCToken).
+ */
+public class TokenModule extends ReactContextBaseJavaModule {
+
+  TokenModule(ReactApplicationContext context) {
+    super(context);
+  }
+
+  @Override
+  public String getName() {
+    return "NFCToken";
+  }
+
+  @ReactMethod
+  public void setTokens(ReadableArray tokens) {
+    List<String> list = new ArrayList<>();
+    for (int i = 0; i < tokens.size(); i++) {
+      list.add(tokens.getString(i));
+    }
+    TokenApduService.setTokens(list);
+  }
+
+  @ReactMethod
+  public void getTokens(Promise promise) {
+    WritableArray tokens = Arguments.createArray();
+    for (String token : TokenApduService.getTokens()) {
+      tokens.pushString(token);
+    }
+    promise.resolve(tokens);
+  }
+
+  @ReactMethod
+  public void removeToken(String token) {
+    TokenApduService.removeToken(token);
+  }
+
+  @ReactMethod
+  public void setChallenges(ReadableArray challenges) {
+    List<String[]> list = new ArrayList<>();
+    for (int i = 0; i < challenges.size(); i++) {
+      ReadableMap challenge = challenges.getMap(i);
+      list.add(new String[] {challenge.getString("challenge"), challenge.getString("response")});
+    }
+    TokenApduService.setChallenges(list);
+  }
+
+  @ReactMethod
+  public void getChallengeCount(Promise promise) {
+    promise.resolve(TokenApduService.challengeCount());
+  }
+
+  @ReactMethod
+  public void takeChallenge(Promise promise) {
+    String[] challenge = TokenApduService.takeChallenge();
+    if (challenge == null) {
+      promise.resolve(null);
+      return;
+    }
+    WritableMap map = Arguments.createMap();
+    map.putString("challenge", challenge[0]);
+    map.putString("response", challenge[1]);
+    promise.resolve(map);
+  }
+}
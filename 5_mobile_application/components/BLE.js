@@ -10,7 +10,9 @@ import {
     StyleSheet,
     PermissionsAndroid, 
     Pressable, 
-    FlatList
+    FlatList,
+    NativeModules,
+    Platform
 } from 'react-native';
 
 import { BleManager, Characteristic } from "react-native-ble-plx";
@@ -26,15 +28,33 @@ const SERVICE_UUID = '5a44c004-4112-4274-880e-cd9b3daedf8e';    // Service UUID
 const CHARAC_UUID = '495f449c-fc60-4048-b53e-bdb3046d4495';     // Characteristic UUID
 
 
+const CREDENTIAL_BATCH = 16;    // Number of pre-issued credentials requested in one batch
+const CREDENTIAL_REFILL = 4;    // A new batch is requested when less credentials remain
+const CREDENTIAL_MARGIN = 60;   // A credential expiring in less than 60s is not used
+const CREDENTIAL_SKEW = 300;    // A credential is accepted by the reader 300s before its start at most (CREDENTIAL_SKEW of the card reader)
+const CREDENTIAL_SIGNATURE = false;     // Request Ed25519 signed tokens (192 hex chars) instead of MAC credentials (64 hex chars)
+const NFC_TOKENS = CREDENTIAL_SIGNATURE && Platform.OS === 'android';   // Signed tokens also sent by a NFC tap (host card emulation)
+
+const { NFCToken } = NativeModules;     // Tokens and reader challenges of the NFC service (TokenApduService)
+
+
 var userID = '';        // User ID 
 var connectedDevice;    // Connected device
 var modifiedCharac;     // Modified characteristic value
 var randNum;            // Random number value
+var credentials = [];   // Pre-issued credentials (hex string) ordered by expiration time, used without any middleware call during the BLE session
+var challenges = [];    // One-time reader challenges {challenge, response} of the middleware, a credential is only sent to a reader that answers one
+var readerChallenge;    // Challenge sent to the reader, waiting for its response
+var sentCredential;     // Credential written to the reader, removed when the reader answers
 
 // SM states
 const States = {
     ST_OnIdle: 'ST_OnIdle',
     ST_StartAuthentication: 'ST_StartAuthentication',
+    ST_ReaderChallenge: 'ST_ReaderChallenge',
+    ST_WaitReaderResponse: 'ST_WaitReaderResponse',
+    ST_ReaderCheck: 'ST_ReaderCheck',
+    ST_SendCredential: 'ST_SendCredential',
     ST_DeviceAuthentication: 'ST_DeviceAuthentication',
     ST_WaitDeviceAuthentication: 'ST_WaitDeviceAuthentication',
     ST_DeviceAuthenticated: 'ST_DeviceAuthenticated',
@@ -153,6 +173,10 @@ const BLE = () => {
 
             // Select the SM state after receiving a notification
             switch(currentState) {
+                case States.ST_WaitReaderResponse:
+                    currentState = States.ST_ReaderCheck;
+                    break;
+
                 case States.ST_WaitDeviceAuthentication:
                     currentState = States.ST_DeviceAuthentication;
                 break;
@@ -206,6 +230,8 @@ const BLE = () => {
      */
     scanForDevices = async () => {
         if(userID !== '' && currentState === States.ST_OnIdle){
+            await fetchCredentials();   // Get the credentials while the middleware is reachable
+
             console.log("Start scanning...");
             setPrintedText('Discovering ...');
 
@@ -253,7 +279,8 @@ const BLE = () => {
                 console.log('Enable monitor notification.');
                 await connectedDevice.monitorCharacteristicForService(SERVICE_UUID, CHARAC_UUID, (error, characteristic) => onNotificationReceived(error, characteristic));
                 
-                currentState = States.ST_StartAuthentication;
+                // Use a pre-issued credential if available (reader checked first), else the complete authentication protocol
+                currentState = await canUseCredential() ? States.ST_ReaderChallenge : States.ST_StartAuthentication;
                 chooseSMstate(connectedDevice);  
 
             // Connection failed
@@ -391,6 +418,140 @@ const BLE = () => {
         }
     };
 
+    /**
+     * Get the expiration time of a credential
+     * 
+     * @param {*} credential credential in hex string
+     * 
+     * @returns expiration time in unix timestamp (bytes 16 to 23)
+     */
+    const getCredentialExpiration = (credential) => {
+        return parseInt(credential.substring(32, 48), 16);
+    };
+
+    /**
+     * Get the start time of a credential
+     * 
+     * @param {*} credential credential in hex string
+     * 
+     * @returns start time in unix timestamp (bytes 8 to 15)
+     */
+    const getCredentialStart = (credential) => {
+        return parseInt(credential.substring(16, 32), 16);
+    };
+
+    /**
+     * Remove the expired credentials
+     */
+    const removeExpiredCredentials = () => {
+        const now = Math.floor(Date.now() / 1000);
+        credentials = credentials.filter(credential => getCredentialExpiration(credential) > now + CREDENTIAL_MARGIN);
+    };
+
+    /**
+     * Get the credential to send : the first one whose window has started (skew of the reader
+     * tolerated), the credentials of the later windows are kept for the next taps
+     * 
+     * @returns credential in hex string, null if none
+     */
+    const getUsableCredential = () => {
+        const now = Math.floor(Date.now() / 1000);
+
+        removeExpiredCredentials();
+        return credentials.find(credential => getCredentialStart(credential) <= now + CREDENTIAL_SKEW) ?? null;
+    };
+
+    /**
+     * Check if a valid credential is available
+     * 
+     * @returns true if a credential can be sent to the reader
+     */
+    const hasCredential = () => {
+        return getUsableCredential() !== null;
+    };
+
+    /**
+     * Get the number of reader challenges not used yet
+     * 
+     * @returns number of challenges (shared with the NFC service)
+     */
+    const getChallengeCount = async() => {
+        return NFC_TOKENS ? await NFCToken.getChallengeCount() : challenges.length;
+    };
+
+    /**
+     * Take the next reader challenge, each challenge is used once
+     * 
+     * @returns {challenge, response} in hex string, null if none
+     */
+    const takeChallenge = async() => {
+        return NFC_TOKENS ? await NFCToken.takeChallenge() : (challenges.shift() ?? null);
+    };
+
+    /**
+     * Check if a credential can be sent without the middleware
+     * 
+     * @returns true if a valid credential and a reader challenge are available
+     */
+    const canUseCredential = async() => {
+        return hasCredential() && await getChallengeCount() > 0;
+    };
+
+    /**
+     * Remove a credential answered by the reader (identified or rejected)
+     * 
+     * @param {*} credential credential to remove
+     */
+    const removeCredential = (credential) => {
+        credentials = credentials.filter(value => value !== credential);
+        if(NFC_TOKENS) {
+            NFCToken.removeToken(credential);
+        }
+    };
+
+    /**
+     * Remove a credential rejected by the reader, only if its window has started : a reader whose
+     * clock is late rejects a credential still valid for the next taps
+     * 
+     * @param {*} credential credential to remove
+     */
+    const removeRejectedCredential = (credential) => {
+        if(getCredentialStart(credential) <= Math.floor(Date.now() / 1000)) {
+            removeCredential(credential);
+        }
+    };
+
+    /**
+     * Get pre-issued credentials from the middleware component
+     * 
+     * Request a new batch of credentials with staggered expirations and reader challenges
+     * when less than CREDENTIAL_REFILL credentials or challenges remain. Called before the BLE
+     * session, a failure only means that the complete authentication protocol will be used.
+     * The first credential of the list whose window has started is the next one sent.
+     */
+    const fetchCredentials = async() => {
+        if(NFC_TOKENS) {
+            credentials = await NFCToken.getTokens();   // Tokens confirmed by a NFC reader are removed
+        }
+        removeExpiredCredentials();
+        if(credentials.length >= CREDENTIAL_REFILL && await getChallengeCount() >= CREDENTIAL_REFILL) {
+            return;
+        }
+
+        try {
+            const response = await axios.get(`http://${ipAddress}:8080/getCredentialBatch?userID=${userID}&count=${CREDENTIAL_BATCH}&signature=${CREDENTIAL_SIGNATURE}`);
+            credentials = response.data.credentials;
+            challenges = response.data.challenges.map((challenge, i) => ({ challenge: challenge, response: response.data.responses[i] }));
+            if(NFC_TOKENS) {
+                NFCToken.setTokens(credentials);
+                NFCToken.setChallenges(challenges);
+                challenges = [];    // Kept by the NFC service only, a challenge is never used twice
+            }
+        } catch (error) {
+            console.log('Credentials not available : ', error);
+        }
+    };
+
     /**
      * Choose state machine state
      * 
@@ -403,6 +564,47 @@ const BLE = () => {
         while(true){
             switch(currentState) {
 
+                // Write a one-time challenge in the characteristic, the reader answers it encrypted
+                case States.ST_ReaderChallenge:
+                    console.log('Reader authentication...');
+                    readerChallenge = await takeChallenge();
+                    if(readerChallenge && await writeValue(readerChallenge.challenge)){
+                        currentState = States.ST_WaitReaderResponse;
+                        return;     // Quit this function. Wait a notification
+                    } else {
+                        currentState = States.ST_AuthenticationFailed;
+                    }
+                    break;
+
+                // Compare the reader response with the response given by the middleware
+                // A reader without the key never receives a credential
+                case States.ST_ReaderCheck:
+                    if(modifiedCharac.toLowerCase() === readerChallenge.response.toLowerCase()) {
+                        currentState = States.ST_SendCredential;
+                    } else {
+                        console.log('Reader not authenticated');
+                        currentState = States.ST_AuthenticationFailed;
+                    }
+                    readerChallenge = null;
+                    break;
+
+                // Write a pre-issued credential in the characteristic (each credential is used once)
+                // The credential is removed when the reader answers, a failed write keeps it
+                case States.ST_SendCredential:
+                    console.log('Identification with a pre-issued credential...');
+                    if(NFC_TOKENS) {
+                        credentials = await NFCToken.getTokens();   // Same list as the NFC service
+                    }
+                    const credential = getUsableCredential();
+                    if(credential && await writeValue(credential)){
+                        sentCredential = credential;
+                        currentState = States.ST_WaitIdentification;
+                        return;     // Quit this function. Wait a notification
+                    } else {
+                        currentState = States.ST_AuthenticationFailed;
+                    }
+                    break;
+
                 // Write random number in the characteristic 
                 case States.ST_StartAuthentication:
                     console.log('Authentication protocol started...');
@@ -460,6 +662,10 @@ const BLE = () => {
                 case States.ST_Identify:
                     Alert.alert('User ID successfully sent to the card reader !');
                     console.log('Authentication done, ID send !');
+                    if(sentCredential) {
+                        removeCredential(sentCredential);
+                        sentCredential = null;
+                    }
                     disconnectFromDevice(connectedDevice);
 
                     currentState = States.ST_OnIdle;
@@ -470,6 +676,10 @@ const BLE = () => {
                 case States.ST_AuthenticationFailed:
                     Alert.alert('Authentication failed !');
                     console.log('Authentication failed !');
+                    if(sentCredential) {
+                        removeRejectedCredential(sentCredential);   // Rejected by the reader (expired, replayed) or used
+                        sentCredential = null;
+                    }
 
                     if(connectedDevice.isConnected()) {
                         disconnectFromDevice(connectedDevice)
@@ -489,6 +699,14 @@ const BLE = () => {
      * @param {*} id user identifier to set
      */
     BLE.setUserID = (id) => {
+        if(userID !== id) {
+            credentials = [];   // Credentials of the previous user
+            challenges = [];
+            if(NFC_TOKENS) {
+                NFCToken.setTokens([]);
+                NFCToken.setChallenges([]);
+            }
+        }
         userID = id;
     };
 
@@ -0,0 +1,258 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                ID FRAME PARSER
+//
+// Decode the identification frames received from the card reader.
+//
+// - The bytes are added to the buffer of the parser, a frame is checked as soon
+//   as its length is known (length byte) and decoded when complete
+// - Wrong length, version or CRC : the start of frame is dropped and the
+//   buffer is scanned for the next one (bytes of the bad frame reused)
+// - Sequence numbers : a gap counts the frames lost (host output overflow,
+//   serial errors), a number already received marks a duplicate, a return to 0
+//   is a restart of the reader
+//
+// Usage :
+//   while (length > 0) {
+//       int used = idFrameParserFeed(&parser, data, length, &frame, &decoded);
+//       data += used; length -= used;
+//       if (decoded) ... frame ...
+//   }
+//
+// Memory : sizeof(TIDFrameParser) (168 bytes) per reader
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "id_frame_parser.h"
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Init a parser
+ *
+ * @param parser : pointer to the parser
+ *
+*/
+void idFrameParserInit(TIDFrameParser* parser)
+{
+    memset(parser, 0, sizeof(*parser));
+}
+
+/**
+ * Compute the CRC of a frame
+ *
+ * CRC-16/CCITT, reverse polynom 0x8408, init 0xffff (as the card reader)
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ *
+ * @return CRC
+*/
+uint16_t idFrameCRC(const uint8_t* data, int length)
+{
+    uint16_t CRC = 0xffff;
+
+    for (int i = 0; i < length; i++) {
+        uint8_t value = data[i] ^ (uint8_t)CRC;
+
+        value ^= (uint8_t)(value << 4);
+        CRC = (uint16_t)(((value << 8) | (CRC >> 8)) ^ (value >> 4) ^ (value << 3));
+    }
+    return CRC;
+}
+
+/**
+ * Name of a source
+ *
+ * @param source : IDFRAME_SOURCE_xxx
+ *
+ * @return "card", "ble", "nfc", "wiegand" or "unknown"
+*/
+const char* idFrameSourceName(uint8_t source)
+{
+    switch (source) {
+        case IDFRAME_SOURCE_CARD:
+            return "card";
+        case IDFRAME_SOURCE_BLE:
+            return "ble";
+        case IDFRAME_SOURCE_NFC:
+            return "nfc";
+        case IDFRAME_SOURCE_WIEGAND:
+            return "wiegand";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Read a little endian value
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes (2 or 4)
+ *
+ * @return value
+*/
+static uint32_t idFrameParserValue(const uint8_t* data, int length)
+{
+    uint32_t value = 0;
+
+    for (int i = length - 1; i >= 0; i--) {
+        value = (value << 8) | data[i];
+    }
+    return value;
+}
+
+/**
+ * Follow the sequence numbers
+ * Only a repeat of the last sequence number is a duplicate. A step back or a jump
+ * ahead farther than IDFRAME_MAXGAP is a restart of the reader (its first frames may
+ * be lost, 0 included) : the parser resynchronizes on the frame, which is delivered.
+ *
+ * @param parser : pointer to the parser
+ * @param frame : pointer to the decoded frame, Missed, Duplicate and Restarted filled
+ *
+*/
+static void idFrameParserSequence(TIDFrameParser* parser, TIDFrame* frame)
+{
+    frame->Missed = 0;
+    frame->Duplicate = false;
+    frame->Restarted = false;
+
+    if (parser->Synchronized) {
+        uint16_t step = (uint16_t)(frame->Sequence - parser->LastSequence);
+
+        if (step == 0) {
+            frame->Duplicate = true;
+        } else if (step <= IDFRAME_MAXGAP) {
+            frame->Missed = step - 1;       // Wraps from 0xffff to 0 as a forward step
+        } else {
+            frame->Restarted = true;
+        }
+    }
+
+    if (frame->Duplicate) {
+        parser->Duplicates++;
+        return;
+    }
+    if (frame->Restarted) {
+        parser->Restarts++;
+    }
+    parser->MissedFrames += frame->Missed;
+    parser->LastSequence = frame->Sequence;
+    parser->Synchronized = true;
+}
+
+/**
+ * Check the frame at the start of the buffer
+ *
+ * @param parser : pointer to the parser
+ * @param frame : pointer to the frame to fill
+ *
+ * @return length of the frame if decoded, 0 if incomplete, -1 if invalid
+*/
+static int idFrameParserCheck(TIDFrameParser* parser, TIDFrame* frame)
+{
+    const uint8_t* buffer = parser->Buffer;
+
+    if (parser->Length < 2) {
+        return 0;
+    }
+    if (buffer[1] < IDFRAME_HEADERLENGTH || buffer[1] > IDFRAME_HEADERLENGTH + IDFRAME_MAXID) {
+        parser->FormatErrors++;
+        return -1;
+    }
+
+    int total = 2 + buffer[1] + 2;
+
+    if (parser->Length < total) {
+        return 0;
+    }
+
+    if (idFrameCRC(&buffer[1], 1 + buffer[1]) != idFrameParserValue(&buffer[total - 2], 2)) {
+        parser->CRCErrors++;
+        return -1;
+    }
+    if (buffer[2] != IDFRAME_VERSION || buffer[13] != buffer[1] - IDFRAME_HEADERLENGTH) {
+        parser->FormatErrors++;
+        return -1;
+    }
+
+    frame->Sequence = idFrameParserValue(&buffer[3], 2);
+    frame->Source = buffer[5];
+    frame->Technology = buffer[6];
+    frame->Timestamp = idFrameParserValue(&buffer[7], 4);
+    frame->DurationTicks = idFrameParserValue(&buffer[11], 2);
+    frame->IDLength = buffer[13];
+    memcpy(frame->ID, &buffer[14], frame->IDLength);
+    frame->ID[frame->IDLength] = 0;
+
+    idFrameParserSequence(parser, frame);
+    parser->Frames++;
+    return total;
+}
+
+/**
+ * Drop the bytes of the buffer up to the next start of frame
+ *
+ * @param parser : pointer to the parser
+ * @param count : bytes to drop at least
+ *
+*/
+static void idFrameParserDrop(TIDFrameParser* parser, int count)
+{
+    while (count < parser->Length && parser->Buffer[count] != IDFRAME_SOF) {
+        count++;
+    }
+    memmove(parser->Buffer, &parser->Buffer[count], parser->Length - count);
+    parser->Length -= count;
+}
+
+/**
+ * Add received bytes to the parser, stop after a decoded frame
+ *
+ * @param parser : pointer to the parser
+ * @param data : pointer to the received bytes
+ * @param length : number of bytes
+ * @param frame : pointer to the frame to fill
+ * @param decoded : set to true if a frame is decoded
+ *
+ * @return number of bytes used, the others are given again
+*/
+int idFrameParserFeed(TIDFrameParser* parser, const uint8_t* data, int length, TIDFrame* frame, bool* decoded)
+{
+    int used = 0;
+
+    *decoded = false;
+
+    for (;;) {
+        int result = idFrameParserCheck(parser, frame);
+
+        if (result != 0) {
+            int count = (result > 0) ? result : 1;      // Frame decoded, or its start of frame
+            int buffered = parser->Length;
+
+            idFrameParserDrop(parser, count);
+            parser->SkippedBytes += buffered - parser->Length - ((result > 0) ? result : 0);
+
+            if (result > 0) {
+                *decoded = true;
+                return used;
+            }
+            continue;
+        }
+
+        if (used >= length) {
+            return used;
+        }
+
+        uint8_t value = data[used++];
+
+        if (parser->Length == 0 && value != IDFRAME_SOF) {
+            parser->SkippedBytes++;
+            continue;
+        }
+        parser->Buffer[parser->Length++] = value;
+    }
+}
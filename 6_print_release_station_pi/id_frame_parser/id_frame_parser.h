@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                ID FRAME PARSER
+//
+// Host side decoder of the identification frames of the card reader
+// (format : 4_card_reader/id_frame.h, HOSTFORMAT_FRAME)
+// - Byte stream decoder, resynchronized on the start of frame after an error
+// - CRC checked, frames lost or repeated found with the sequence number
+// - Plain C99, no allocation : usable by the release station and its tools
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __ID_FRAME_PARSER_H__
+#define __ID_FRAME_PARSER_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                DEFINE CONSTANT
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Same values as 4_card_reader/id_frame.h
+#define IDFRAME_SOF                 0xa5
+#define IDFRAME_VERSION             1
+
+#define IDFRAME_SOURCE_CARD         0           // Card ID (technology : TWN4 tag type)
+#define IDFRAME_SOURCE_BLE          1           // User of a BLE session
+#define IDFRAME_SOURCE_NFC          2           // User of the token of a phone tapped on the reader
+#define IDFRAME_SOURCE_WIEGAND      3           // Card number of a Wiegand reader (technology : WIEGAND_FORMAT_xxx)
+
+#define IDFRAME_HEADERLENGTH        12          // Version to ID length
+#define IDFRAME_MAXID               128         // Longest ID in bytes
+#define IDFRAME_MAXLENGTH           (2 + IDFRAME_HEADERLENGTH + IDFRAME_MAXID + 2)
+
+#ifndef IDFRAME_MAXGAP
+#define IDFRAME_MAXGAP              1024        // Longest forward sequence step counted as lost frames, farther : reader restarted
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                  DEFINE TYPES
+//////////////////////////////////////////////////////////////////////////////////////
+
+// Decoded identification
+typedef struct
+{
+    uint16_t Sequence;
+    uint8_t Source;             // IDFRAME_SOURCE_xxx
+    uint8_t Technology;         // TWN4 tag type of the card, 0 for BLE
+    uint32_t Timestamp;         // Reader time of the identification (Unix seconds)
+    uint16_t DurationTicks;     // Detection to identification in milliseconds
+    int IDLength;
+    char ID[IDFRAME_MAXID + 1]; // Null-terminated
+    uint16_t Missed;            // Frames lost since the previous frame (sequence gap)
+    bool Duplicate;             // Same sequence number as the previous frame (repeated frame)
+    bool Restarted;             // Sequence moved back or jumped ahead (reader reset), parser resynchronized
+} TIDFrame;
+
+// Decoder state and counters
+typedef struct
+{
+    uint8_t Buffer[IDFRAME_MAXLENGTH];
+    int Length;                 // Bytes of the current frame in the buffer
+    bool Synchronized;          // A frame has been received (LastSequence valid)
+    uint16_t LastSequence;
+
+    uint32_t Frames;            // Valid frames
+    uint32_t CRCErrors;         // Frames with a wrong CRC
+    uint32_t FormatErrors;      // Frames with a wrong version or length
+    uint32_t SkippedBytes;      // Bytes dropped to find a start of frame
+    uint32_t MissedFrames;      // Frames lost (sequence gaps)
+    uint32_t Duplicates;        // Frames repeated
+    uint32_t Restarts;          // Sequence restarts (reader reset)
+} TIDFrameParser;
+
+//////////////////////////////////////////////////////////////////////////////////////
+//                                    FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////
+
+void idFrameParserInit(TIDFrameParser* parser);
+int idFrameParserFeed(TIDFrameParser* parser, const uint8_t* data, int length, TIDFrame* frame, bool* decoded);
+uint16_t idFrameCRC(const uint8_t* data, int length);
+const char* idFrameSourceName(uint8_t source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                BRIDGE METRICS
+//
+// The text file is written to a temporary file then renamed : a collector
+// (node_exporter textfile) never reads a partial file.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "bridge_metrics.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Record the latency of a release
+ *
+ * @param milliseconds : tap to release
+*/
+void BridgeMetrics::recordLatency(uint32_t milliseconds)
+{
+    size_t bucket = 0;
+
+    while (bucket < LatencyBounds.size() && milliseconds > LatencyBounds[bucket]) {
+        bucket++;
+    }
+    latencyBuckets[bucket]++;
+    latencyCount++;
+    latencySum += milliseconds;
+    if (milliseconds > latencyMax) {
+        latencyMax = milliseconds;
+    }
+}
+
+/**
+ * Format the counters
+ *
+ * @return Prometheus text format
+*/
+std::string BridgeMetrics::prometheus() const
+{
+    std::string text;
+    auto line = [&text](const std::string& name, const std::string& labels, uint64_t value) {
+        text += name + (labels.empty() ? "" : "{" + labels + "}") + " " + std::to_string(value) + "\n";
+    };
+
+    text += "# TYPE release_bridge_events_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_events_total", "reader=\"" + reader.first + "\"", reader.second.events);
+    }
+    text += "# TYPE release_bridge_reader_opens_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_reader_opens_total", "reader=\"" + reader.first + "\"", reader.second.opens);
+    }
+    text += "# TYPE release_bridge_frame_errors_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_frame_errors_total", "reader=\"" + reader.first + "\"", reader.second.frameErrors);
+    }
+    text += "# TYPE release_bridge_frames_missed_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_frames_missed_total", "reader=\"" + reader.first + "\"", reader.second.framesMissed);
+    }
+    text += "# TYPE release_bridge_reader_restarts_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_reader_restarts_total", "reader=\"" + reader.first + "\"", reader.second.restarts);
+    }
+    text += "# TYPE release_bridge_overlong_lines_total counter\n";
+    for (const auto& reader : readers) {
+        line("release_bridge_overlong_lines_total", "reader=\"" + reader.first + "\"", reader.second.overlongLines);
+    }
+
+    text += "# TYPE release_bridge_suppressed_total counter\n";
+    line("release_bridge_suppressed_total", "", suppressed);
+    text += "# TYPE release_bridge_batches_total counter\n";
+    line("release_bridge_batches_total", "", batches);
+    text += "# TYPE release_bridge_calls_total counter\n";
+    line("release_bridge_calls_total", "", calls);
+    text += "# TYPE release_bridge_results_total counter\n";
+    line("release_bridge_results_total", "result=\"released\"", released);
+    line("release_bridge_results_total", "result=\"unknown\"", unknown);
+    line("release_bridge_results_total", "result=\"failed\"", failed);
+    text += "# TYPE release_bridge_connects_total counter\n";
+    line("release_bridge_connects_total", "", connects);
+
+    uint64_t cumulative = 0;
+
+    text += "# TYPE release_bridge_tap_to_release_ms histogram\n";
+    for (size_t i = 0; i < LatencyBounds.size(); i++) {
+        cumulative += latencyBuckets[i];
+        line("release_bridge_tap_to_release_ms_bucket", "le=\"" + std::to_string(LatencyBounds[i]) + "\"", cumulative);
+    }
+    line("release_bridge_tap_to_release_ms_bucket", "le=\"+Inf\"", latencyCount);
+    line("release_bridge_tap_to_release_ms_sum", "", latencySum);
+    line("release_bridge_tap_to_release_ms_count", "", latencyCount);
+    text += "# TYPE release_bridge_tap_to_release_max_ms gauge\n";
+    line("release_bridge_tap_to_release_max_ms", "", latencyMax);
+    return text;
+}
+
+/**
+ * Write the counters to a file
+ *
+ * @param path : path of the text file
+ * @param error : description of the error
+ *
+ * @return true if succeed, else false
+*/
+bool BridgeMetrics::write(const std::string& path, std::string& error) const
+{
+    std::string temporary = path + ".tmp";
+    std::string text = prometheus();
+    FILE* file = fopen(temporary.c_str(), "w");
+
+    if (file == nullptr) {
+        error = "Open " + temporary + " : " + strerror(errno);
+        return false;
+    }
+
+    bool written = fwrite(text.data(), 1, text.size(), file) == text.size();
+
+    if (fclose(file) != 0 || !written) {
+        error = "Write " + temporary + " : " + strerror(errno);
+        remove(temporary.c_str());
+        return false;
+    }
+    if (rename(temporary.c_str(), path.c_str()) != 0) {
+        error = "Rename " + temporary + " : " + strerror(errno);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                BRIDGE METRICS
+//
+// Counters of the release bridge, written as a Prometheus text file
+// - Identifications per reader, suppressed repeats, batches and calls
+// - Release results : released, unknown ID, failed
+// - Tap to release latency histogram (reader identification + bridge + server)
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef BRIDGE_METRICS_H
+#define BRIDGE_METRICS_H
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+
+class BridgeMetrics
+{
+public:
+    static constexpr std::array<uint32_t, 10> LatencyBounds = {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000};
+
+    // Counters of a reader
+    struct Reader
+    {
+        uint64_t events = 0;        // Identifications decoded
+        uint64_t opens = 0;         // Device opened (start and reconnections)
+        uint64_t frameErrors = 0;   // Frames with a wrong CRC or format
+        uint64_t framesMissed = 0;  // Frames lost (sequence gaps)
+        uint64_t restarts = 0;      // Sequence restarts (reader reset)
+        uint64_t overlongLines = 0; // Text lines too long, dropped
+    };
+
+    void recordLatency(uint32_t milliseconds);
+
+    std::string prometheus() const;
+    bool write(const std::string& path, std::string& error) const;
+
+    std::map<std::string, Reader> readers;
+    uint64_t suppressed = 0;        // Repeats dropped by the dedup filter
+    uint64_t batches = 0;           // HTTP requests (one batch each)
+    uint64_t calls = 0;             // XML-RPC calls (several per multicall)
+    uint64_t released = 0;          // IDs resolved to a user
+    uint64_t unknown = 0;           // IDs without user
+    uint64_t failed = 0;            // IDs lost on a server or connection error
+    uint64_t connects = 0;          // TCP connections opened to the server
+
+    std::array<uint64_t, LatencyBounds.size() + 1> latencyBuckets = {};    // Last bucket : above the bounds
+    uint64_t latencyCount = 0;
+    uint64_t latencySum = 0;
+    uint32_t latencyMax = 0;
+};
+
+#endif
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 DEDUP FILTER
+//
+// An ID is accepted when the same reader did not report it during the window
+// before it. A repeat restarts the window : a card left on a reader that reports
+// it again and again stays suppressed until it is removed for a whole window.
+// Another reader of the station is not filtered : the same card or phone used on
+// two printers is two releases.
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "dedup_filter.h"
+
+/**
+ * Create a filter
+ *
+ * @param window : time an ID is suppressed after its reception, 0 = no filtering
+*/
+DedupFilter::DedupFilter(std::chrono::milliseconds window) : _window(window)
+{
+}
+
+/**
+ * Check an identification
+ *
+ * @param event : identification, key = reader and ID
+ *
+ * @return true if new, false if repeated within the window
+*/
+bool DedupFilter::accept(const IdentificationEvent& event)
+{
+    if (_window.count() <= 0) {
+        return true;
+    }
+
+    std::string key = keyOf(event);
+    auto entry = _lastSeen.find(key);
+
+    if (entry != _lastSeen.end() && event.receivedAt - entry->second < _window) {
+        entry->second = event.receivedAt;
+        _suppressed++;
+        return false;
+    }
+
+    if (_lastSeen.size() >= PruneSize) {
+        prune(event.receivedAt);
+    }
+    _lastSeen[key] = event.receivedAt;
+    return true;
+}
+
+/**
+ * Key of an identification in the table
+ *
+ * @param event : identification
+ *
+ * @return reader and ID separated by a line feed (never part of a device path or of an ID line)
+*/
+std::string DedupFilter::keyOf(const IdentificationEvent& event)
+{
+    return event.reader + '\n' + event.id;
+}
+
+/**
+ * Remove the IDs not received during the window
+ *
+ * @param now : current time
+*/
+void DedupFilter::prune(Clock::time_point now)
+{
+    for (auto entry = _lastSeen.begin(); entry != _lastSeen.end();) {
+        if (now - entry->second >= _window) {
+            entry = _lastSeen.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+}
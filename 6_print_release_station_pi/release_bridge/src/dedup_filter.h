@@ -0,0 +1,39 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 DEDUP FILTER
+//
+// Drop the identifications repeated within a window
+// - Same ID from the same reader (card left on the reader, repeated reports)
+// - The same ID on two readers is two identifications (two stations, two users)
+// - Expired IDs pruned while the table grows
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEDUP_FILTER_H
+#define DEDUP_FILTER_H
+
+#include <string>
+#include <unordered_map>
+
+#include "identification_event.h"
+
+class DedupFilter
+{
+public:
+    static constexpr size_t PruneSize = 1024;      // Table size that triggers a prune of the expired IDs
+
+    explicit DedupFilter(std::chrono::milliseconds window);
+
+    bool accept(const IdentificationEvent& event);
+
+    uint64_t suppressed() const { return _suppressed; }
+    size_t size() const { return _lastSeen.size(); }
+
+private:
+    static std::string keyOf(const IdentificationEvent& event);
+    void prune(Clock::time_point now);
+
+    std::chrono::milliseconds _window;
+    std::unordered_map<std::string, Clock::time_point> _lastSeen;      // Reader and ID -> last reception
+    uint64_t _suppressed = 0;
+};
+
+#endif
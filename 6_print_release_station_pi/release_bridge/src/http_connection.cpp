@@ -0,0 +1,337 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                HTTP CONNECTION
+//
+// Blocking socket with SO_SNDTIMEO / SO_RCVTIMEO : a request never waits more
+// than the timeout for one step. The release bridge sends one batch at a
+// time, the readers are buffered by the kernel meanwhile.
+//
+// - A request on a reused connection that fails before any response byte is
+//   sent again on a new connection (idle connection closed by the server). The
+//   lookups of the bridge are read-only, a repeated request is harmless.
+// - "Connection: close" of the server, or an HTTP/1.0 response, closes the
+//   connection after the response
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "http_connection.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Create a connection, opened at the first request
+ *
+ * @param host : name or address of the server
+ * @param port : TCP port
+ * @param path : path of the requests
+ * @param timeout : limit of connect, send and receive
+*/
+HttpConnection::HttpConnection(std::string host, uint16_t port, std::string path, std::chrono::milliseconds timeout)
+    : _host(std::move(host)), _port(port), _path(std::move(path)), _timeout(timeout)
+{
+}
+
+HttpConnection::~HttpConnection()
+{
+    close();
+}
+
+/**
+ * Split an URL
+ *
+ * @param url : http://host[:port][/path]
+ * @param host : host
+ * @param port : port (80 if not given)
+ * @param path : path ("/" if not given)
+ *
+ * @return true if succeed, false if not an http URL
+*/
+bool HttpConnection::parseUrl(const std::string& url, std::string& host, uint16_t& port, std::string& path)
+{
+    const std::string scheme = "http://";
+
+    if (url.compare(0, scheme.size(), scheme) != 0) {
+        return false;
+    }
+
+    std::string rest = url.substr(scheme.size());
+    size_t slash = rest.find('/');
+    std::string authority = rest.substr(0, slash);
+    size_t colon = authority.rfind(':');
+
+    path = (slash == std::string::npos) ? "/" : rest.substr(slash);
+    port = 80;
+    if (colon != std::string::npos) {
+        long value = strtol(authority.c_str() + colon + 1, nullptr, 10);
+
+        if (value <= 0 || value > 0xffff) {
+            return false;
+        }
+        port = static_cast<uint16_t>(value);
+        authority.erase(colon);
+    }
+    host = authority;
+    return !host.empty();
+}
+
+/**
+ * Close the connection
+*/
+void HttpConnection::close()
+{
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _buffer.clear();
+}
+
+/**
+ * Open the connection
+ *
+ * @param error : description of the error
+ *
+ * @return true if succeed, else false
+*/
+bool HttpConnection::open(std::string& error)
+{
+    struct addrinfo hints = {};
+    struct addrinfo* addresses = nullptr;
+    std::string port = std::to_string(_port);
+
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    int result = getaddrinfo(_host.c_str(), port.c_str(), &hints, &addresses);
+
+    if (result != 0) {
+        error = std::string("Resolve ") + _host + " : " + gai_strerror(result);
+        return false;
+    }
+
+    struct timeval timeout;
+
+    timeout.tv_sec = _timeout.count() / 1000;
+    timeout.tv_usec = (_timeout.count() % 1000) * 1000;
+
+    for (struct addrinfo* address = addresses; address != nullptr; address = address->ai_next) {
+        int fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+
+        if (fd < 0) {
+            continue;
+        }
+
+        int noDelay = 1;
+
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));     // Also limits connect
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+            _fd = fd;
+            break;
+        }
+        error = std::string("Connect ") + _host + ":" + port + " : " + strerror(errno);
+        ::close(fd);
+    }
+    freeaddrinfo(addresses);
+
+    if (_fd < 0) {
+        return false;
+    }
+    _buffer.clear();
+    _connects++;
+    return true;
+}
+
+/**
+ * Send bytes
+ *
+ * @param data : bytes
+ * @param error : description of the error
+ *
+ * @return true if all sent, else false
+*/
+bool HttpConnection::sendAll(const std::string& data, std::string& error)
+{
+    size_t sent = 0;
+
+    while (sent < data.size()) {
+        ssize_t result = send(_fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            error = std::string("Send : ") + strerror(errno);
+            return false;
+        }
+        sent += result;
+    }
+    return true;
+}
+
+/**
+ * Receive more bytes in the buffer
+ *
+ * @param error : description of the error
+ *
+ * @return true if bytes received, false on error, timeout or connection closed
+*/
+bool HttpConnection::receive(std::string& error)
+{
+    char chunk[4096];
+
+    for (;;) {
+        ssize_t result = recv(_fd, chunk, sizeof(chunk), 0);
+
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result > 0) {
+            _buffer.append(chunk, result);
+            _receivedBytes += result;
+            return true;
+        }
+        error = (result == 0) ? "Connection closed by the server"
+                              : (errno == EAGAIN || errno == EWOULDBLOCK) ? "Response timeout"
+                              : std::string("Receive : ") + strerror(errno);
+        return false;
+    }
+}
+
+/**
+ * Read a response
+ *
+ * @param body : body of the response
+ * @param keepAlive : false if the server closes the connection
+ * @param error : description of the error
+ *
+ * @return true if a 200 response is read, else false
+*/
+bool HttpConnection::readResponse(std::string& body, bool& keepAlive, std::string& error)
+{
+    size_t headerEnd;
+
+    while ((headerEnd = _buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (!receive(error)) {
+            return false;
+        }
+    }
+
+    std::string headers = _buffer.substr(0, headerEnd + 2);
+    std::string lower = headers;
+
+    _buffer.erase(0, headerEnd + 4);
+    for (char& c : lower) {
+        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    }
+
+    int status = (headers.size() > 12) ? atoi(headers.c_str() + 9) : 0;
+    bool chunked = lower.find("\r\ntransfer-encoding: chunked") != std::string::npos;
+    size_t lengthHeader = lower.find("\r\ncontent-length:");
+
+    keepAlive = lower.compare(0, 8, "http/1.1") == 0 && lower.find("\r\nconnection: close") == std::string::npos;
+    body.clear();
+
+    if (chunked) {
+        for (;;) {
+            size_t lineEnd;
+
+            while ((lineEnd = _buffer.find("\r\n")) == std::string::npos) {
+                if (!receive(error)) {
+                    return false;
+                }
+            }
+
+            size_t size = strtoul(_buffer.c_str(), nullptr, 16);
+
+            while (_buffer.size() < lineEnd + 2 + size + 2) {
+                if (!receive(error)) {
+                    return false;
+                }
+            }
+            body.append(_buffer, lineEnd + 2, size);
+            _buffer.erase(0, lineEnd + 2 + size + 2);
+            if (size == 0) {
+                break;      // Trailers not supported (not sent by the PaperCut server)
+            }
+        }
+    } else if (lengthHeader != std::string::npos) {
+        size_t length = strtoul(lower.c_str() + lengthHeader + 17, nullptr, 10);
+
+        while (_buffer.size() < length) {
+            if (!receive(error)) {
+                return false;
+            }
+        }
+        body = _buffer.substr(0, length);
+        _buffer.erase(0, length);
+    } else {
+        keepAlive = false;      // Body up to the end of the connection
+        std::string ignored;
+
+        while (receive(ignored)) {
+        }
+        body.swap(_buffer);
+    }
+
+    if (status != 200) {
+        error = "HTTP status " + std::to_string(status);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Send a POST request and read its response
+ *
+ * @param body : XML document
+ * @param response : body of the response
+ * @param error : description of the error
+ *
+ * @return true if succeed, else false
+*/
+bool HttpConnection::post(const std::string& body, std::string& response, std::string& error)
+{
+    std::string request = "POST " + _path + " HTTP/1.1\r\n"
+                          "Host: " + _host + ":" + std::to_string(_port) + "\r\n"
+                          "Content-Type: text/xml\r\n"
+                          "Connection: keep-alive\r\n"
+                          "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+
+    for (int attempt = 0; attempt < 2; attempt++) {
+        bool reused = _fd >= 0;
+        bool keepAlive = false;
+
+        if (!reused && !open(error)) {
+            return false;
+        }
+
+        _requests++;
+        if (sendAll(request, error)) {
+            uint64_t received = _receivedBytes;
+            bool succeed = readResponse(response, keepAlive, error);
+
+            if (succeed || _receivedBytes != received) {
+                if (!succeed || !keepAlive) {
+                    close();
+                }
+                return succeed;
+            }
+        }
+
+        close();
+        if (!reused) {
+            return false;       // New connection failed : no retry
+        }
+    }
+    return false;
+}
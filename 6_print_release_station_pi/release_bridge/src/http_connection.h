@@ -0,0 +1,54 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                HTTP CONNECTION
+//
+// HTTP/1.1 POST over a persistent TCP connection (keep-alive)
+// - One connection reused for all the requests to the server
+// - Reconnected when the server closed it (request retried once)
+// - Response body with Content-Length or chunked transfer encoding
+// - Plain HTTP (PaperCut API port 9191), timeouts on connect, send and receive
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+class HttpConnection
+{
+public:
+    HttpConnection(std::string host, uint16_t port, std::string path, std::chrono::milliseconds timeout);
+    ~HttpConnection();
+
+    HttpConnection(const HttpConnection&) = delete;
+    HttpConnection& operator=(const HttpConnection&) = delete;
+
+    static bool parseUrl(const std::string& url, std::string& host, uint16_t& port, std::string& path);
+
+    bool post(const std::string& body, std::string& response, std::string& error);
+    void close();
+
+    bool connected() const { return _fd >= 0; }
+    uint64_t connects() const { return _connects; }
+    uint64_t requests() const { return _requests; }
+
+private:
+    bool open(std::string& error);
+    bool sendAll(const std::string& data, std::string& error);
+    bool receive(std::string& error);
+    bool readResponse(std::string& body, bool& keepAlive, std::string& error);
+
+    std::string _host;
+    uint16_t _port;
+    std::string _path;
+    std::chrono::milliseconds _timeout;
+
+    int _fd = -1;
+    std::string _buffer;            // Bytes received and not consumed
+    uint64_t _connects = 0;
+    uint64_t _requests = 0;
+    uint64_t _receivedBytes = 0;
+};
+
+#endif
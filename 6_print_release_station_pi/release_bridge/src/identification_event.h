@@ -0,0 +1,31 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                            IDENTIFICATION EVENT
+//
+// Identification received from a card reader, text line or binary frame
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef IDENTIFICATION_EVENT_H
+#define IDENTIFICATION_EVENT_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "id_frame_parser.h"
+
+using Clock = std::chrono::steady_clock;
+
+struct IdentificationEvent
+{
+    std::string reader;             // Name of the reader (device path)
+    std::string id;                 // Card number or user ID
+    uint8_t source = IDFRAME_SOURCE_CARD;   // IDFRAME_SOURCE_xxx (text lines : card)
+    uint8_t technology = 0;         // TWN4 tag type of the card
+    bool framed = false;            // Received as a binary frame
+    uint16_t sequence = 0;          // Sequence number of the frame
+    uint32_t readerTimestamp = 0;   // Reader time of the identification (Unix seconds, frames only)
+    uint16_t durationTicks = 0;     // Detection to identification on the reader in milliseconds (frames only)
+    Clock::time_point receivedAt;   // Reception of the last byte
+};
+
+#endif
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 RELEASE BRIDGE
+//
+// Daemon of the print release station : identifications of the card readers
+// sent to the PaperCut XML-RPC API
+//
+// Usage :
+//   release_bridge --reader /dev/ttyACM0[:auto|text|frame] [--reader ...]
+//                  --server http://papercut:9191/rpc/api/xmlrpc --token TOKEN
+//                  [--batch 8] [--batch-delay 50] [--dedup 3000] [--timeout 2000]
+//                  [--metrics /var/lib/node_exporter/release_bridge.prom]
+//                  [--card-method api.lookUpUserNameByCardNo]
+//                  [--user-method api.lookUpUserNameByIDNo]
+//
+// One line per identification on stdout : reader, source, ID, result, user and
+// tap to release latency
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "release_bridge.h"
+
+static ReleaseBridge* bridge = nullptr;
+
+static void onSignal(int)
+{
+    if (bridge != nullptr) {
+        bridge->stop();
+    }
+}
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+            "Usage : %s --reader DEVICE[:auto|text|frame] [--reader ...] --server URL --token TOKEN\n"
+            "       [--batch N] [--batch-delay MS] [--dedup MS] [--timeout MS] [--metrics FILE]\n"
+            "       [--card-method METHOD] [--user-method METHOD]\n",
+            program);
+}
+
+/**
+ * Read a reader argument
+ *
+ * @param text : DEVICE[:auto|text|frame]
+ * @param reader : reader to fill
+ *
+ * @return true if succeed, false if the format is unknown
+*/
+static bool parseReader(const std::string& text, ReaderConfig& reader)
+{
+    size_t colon = text.rfind(':');
+    std::string format = (colon == std::string::npos) ? "auto" : text.substr(colon + 1);
+
+    reader.path = (colon == std::string::npos) ? text : text.substr(0, colon);
+    if (format == "auto") {
+        reader.format = StreamFormat::Auto;
+    } else if (format == "text") {
+        reader.format = StreamFormat::Text;
+    } else if (format == "frame") {
+        reader.format = StreamFormat::Frame;
+    } else {
+        return false;
+    }
+    return !reader.path.empty();
+}
+
+static const char* statusName(ReleaseResult::Status status)
+{
+    switch (status) {
+        case ReleaseResult::Status::Released:
+            return "released";
+        case ReleaseResult::Status::Unknown:
+            return "unknown";
+        default:
+            return "failed";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    BridgeConfig config;
+
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 2;
+        }
+
+        std::string value = argv[++i];
+
+        if (option == "--reader") {
+            ReaderConfig reader;
+
+            if (!parseReader(value, reader)) {
+                usage(argv[0]);
+                return 2;
+            }
+            config.readers.push_back(reader);
+        } else if (option == "--server") {
+            config.url = value;
+        } else if (option == "--token") {
+            config.batch.token = value;
+        } else if (option == "--batch") {
+            config.batch.batchSize = strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "--batch-delay") {
+            config.batch.batchDelay = std::chrono::milliseconds(strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--dedup") {
+            config.dedupWindow = std::chrono::milliseconds(strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--timeout") {
+            config.httpTimeout = std::chrono::milliseconds(strtoul(value.c_str(), nullptr, 10));
+        } else if (option == "--metrics") {
+            config.metricsPath = value;
+        } else if (option == "--card-method") {
+            config.batch.cardMethod = value;
+        } else if (option == "--user-method") {
+            config.batch.userMethod = value;
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    ReleaseBridge releaseBridge(config);
+    std::string error;
+
+    if (!releaseBridge.open(error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        usage(argv[0]);
+        return 1;
+    }
+
+    releaseBridge.onResult = [](const ReleaseResult& result) {
+        printf("%s %s %s %s %s %ums\n", result.event.reader.c_str(), idFrameSourceName(result.event.source),
+               result.event.id.c_str(), statusName(result.status),
+               result.status == ReleaseResult::Status::Failed ? result.error.c_str() : result.user.c_str(),
+               result.latencyMs);
+        fflush(stdout);
+    };
+
+    bridge = &releaseBridge;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    releaseBridge.run();
+    bridge = nullptr;
+    return 0;
+}
@@ -0,0 +1,150 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 READER STREAM
+//
+// Split the bytes of a reader into identifications.
+//
+// - Text : the bytes up to CR or LF form the ID, blank lines are ignored
+//   (CR LF, prefix or suffix of the card format trimmed of spaces)
+// - Frames : bytes given to idFrameParserFeed until they are all used, a
+//   repeated frame (same sequence number) is not an identification
+// - Auto : the first byte other than CR, LF or space decides, the format is
+//   kept until reset (reader reconnected)
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "reader_stream.h"
+
+#include <utility>
+
+/**
+ * Create the decoder of a reader
+ *
+ * @param name : name of the reader, copied to the events
+ * @param format : format of the stream
+*/
+ReaderStream::ReaderStream(std::string name, StreamFormat format)
+    : _name(std::move(name)), _configured(format), _format(format)
+{
+    idFrameParserInit(&_parser);
+}
+
+/**
+ * Forget the partial line or frame
+ *
+ * Called when the reader is reconnected, the automatic format is chosen again
+*/
+void ReaderStream::reset()
+{
+    _format = _configured;
+    _line.clear();
+    _overlong = false;
+    idFrameParserInit(&_parser);
+}
+
+/**
+ * Decode received bytes
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ * @param now : time of the reception
+ * @param events : identifications completed by these bytes, appended
+*/
+void ReaderStream::feed(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events)
+{
+    if (_format == StreamFormat::Auto) {
+        size_t skipped = 0;
+
+        while (skipped < length && (data[skipped] == '\r' || data[skipped] == '\n' || data[skipped] == ' ')) {
+            skipped++;
+        }
+        if (skipped == length) {
+            return;
+        }
+        _format = (data[skipped] == IDFRAME_SOF) ? StreamFormat::Frame : StreamFormat::Text;
+        data += skipped;
+        length -= skipped;
+    }
+
+    if (_format == StreamFormat::Frame) {
+        feedFrames(data, length, now, events);
+    } else {
+        feedText(data, length, now, events);
+    }
+}
+
+/**
+ * Decode text lines
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ * @param now : time of the reception
+ * @param events : identifications, appended
+*/
+void ReaderStream::feedText(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events)
+{
+    for (size_t i = 0; i < length; i++) {
+        char value = static_cast<char>(data[i]);
+
+        if (value != '\r' && value != '\n') {
+            if (_line.size() < MaxLineLength) {
+                _line.push_back(value);
+            } else {
+                _overlong = true;
+            }
+            continue;
+        }
+
+        size_t first = _line.find_first_not_of(' ');
+        size_t last = _line.find_last_not_of(' ');
+
+        if (_overlong) {
+            _overlongLines++;
+        } else if (first != std::string::npos) {
+            IdentificationEvent event;
+
+            event.reader = _name;
+            event.id = _line.substr(first, last - first + 1);
+            event.receivedAt = now;
+            events.push_back(std::move(event));
+            _lines++;
+        }
+        _line.clear();
+        _overlong = false;
+    }
+}
+
+/**
+ * Decode binary frames
+ *
+ * @param data : pointer to the bytes
+ * @param length : number of bytes
+ * @param now : time of the reception
+ * @param events : identifications, appended
+*/
+void ReaderStream::feedFrames(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events)
+{
+    while (length > 0) {
+        TIDFrame frame;
+        bool decoded;
+        int used = idFrameParserFeed(&_parser, data, static_cast<int>(length), &frame, &decoded);
+
+        data += used;
+        length -= used;
+
+        if (!decoded || frame.Duplicate) {
+            continue;
+        }
+
+        IdentificationEvent event;
+
+        event.reader = _name;
+        event.id.assign(frame.ID, frame.IDLength);
+        event.source = frame.Source;
+        event.technology = frame.Technology;
+        event.framed = true;
+        event.sequence = frame.Sequence;
+        event.readerTimestamp = frame.Timestamp;
+        event.durationTicks = frame.DurationTicks;
+        event.receivedAt = now;
+        events.push_back(std::move(event));
+    }
+}
@@ -0,0 +1,56 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 READER STREAM
+//
+// Decoder of the byte stream of one card reader
+// - Legacy text output : one ID per line ("ID\r", CR or LF)
+// - Binary frames (HOSTFORMAT_FRAME) : id_frame_parser, repeated frames dropped
+// - Automatic format : chosen on the first byte (start of frame or text)
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef READER_STREAM_H
+#define READER_STREAM_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "identification_event.h"
+
+enum class StreamFormat
+{
+    Auto,                           // Frame if the first byte is IDFRAME_SOF, else text
+    Text,
+    Frame
+};
+
+class ReaderStream
+{
+public:
+    static constexpr size_t MaxLineLength = IDFRAME_MAXID;
+
+    ReaderStream(std::string name, StreamFormat format);
+
+    void feed(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events);
+    void reset();
+
+    const std::string& name() const { return _name; }
+    StreamFormat format() const { return _format; }
+    const TIDFrameParser& frameParser() const { return _parser; }
+    uint64_t lines() const { return _lines; }
+    uint64_t overlongLines() const { return _overlongLines; }
+
+private:
+    void feedText(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events);
+    void feedFrames(const uint8_t* data, size_t length, Clock::time_point now, std::vector<IdentificationEvent>& events);
+
+    std::string _name;
+    StreamFormat _configured;       // Format given by the configuration
+    StreamFormat _format;           // Format in use (Auto until the first byte)
+    TIDFrameParser _parser;
+    std::string _line;
+    bool _overlong = false;         // Current line longer than MaxLineLength, dropped
+    uint64_t _lines = 0;
+    uint64_t _overlongLines = 0;
+};
+
+#endif
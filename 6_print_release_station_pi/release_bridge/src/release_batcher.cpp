@@ -0,0 +1,240 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                RELEASE BATCHER
+//
+// - A multicall result is an array with one entry per call : the result in an
+//   array of one value, or a fault struct (that call only)
+// - A fault of the whole system.multicall (method unknown to the server) :
+//   the batch is sent again as single calls and multicall is not used anymore
+// - A connection error fails every identification of the batch, the user taps
+//   again (an old tap must not release the jobs of a user who left)
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "release_batcher.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Create the batcher
+ *
+ * @param connection : connection to the XML-RPC server
+ * @param config : API token, methods and batch limits
+ * @param metrics : counters to update
+*/
+ReleaseBatcher::ReleaseBatcher(HttpConnection& connection, BatchConfig config, BridgeMetrics& metrics)
+    : _connection(connection), _config(std::move(config)), _metrics(metrics)
+{
+    if (_config.batchSize == 0) {
+        _config.batchSize = 1;
+    }
+}
+
+/**
+ * Add an identification to the batch
+ *
+ * @param event : identification accepted by the dedup filter
+*/
+void ReleaseBatcher::add(IdentificationEvent event)
+{
+    _events.push_back(std::move(event));
+}
+
+/**
+ * Time to send the batch of the first identification
+ *
+ * @return reception of the first identification + batch delay, max if the batch is empty
+*/
+Clock::time_point ReleaseBatcher::deadline() const
+{
+    if (_events.empty()) {
+        return Clock::time_point::max();
+    }
+    return _events.front().receivedAt + _config.batchDelay;
+}
+
+/**
+ * Check if the batch has to be sent
+ *
+ * @param now : current time
+ *
+ * @return true if the batch is full or the first identification waited the batch delay
+*/
+bool ReleaseBatcher::due(Clock::time_point now) const
+{
+    return !_events.empty() && (_events.size() >= _config.batchSize || now >= deadline());
+}
+
+/**
+ * Build the lookup call of an identification
+ *
+ * @param event : identification
+ *
+ * @return method and parameters (token, ID)
+*/
+xmlrpc::Call ReleaseBatcher::callOf(const IdentificationEvent& event) const
+{
+    bool user = event.source == IDFRAME_SOURCE_BLE || event.source == IDFRAME_SOURCE_NFC;
+
+    return {user ? _config.userMethod : _config.cardMethod,
+            {xmlrpc::Value::string(_config.token), xmlrpc::Value::string(event.id)}};
+}
+
+/**
+ * Send a request and decode the response
+ *
+ * @param body : XML of the request
+ * @param response : decoded response
+ * @param error : description of the error
+ *
+ * @return true if a response (result or fault) is received, else false
+*/
+bool ReleaseBatcher::send(const std::string& body, xmlrpc::Response& response, std::string& error)
+{
+    std::string xml;
+    uint64_t connects = _connection.connects();
+    bool succeed = _connection.post(body, xml, error) && xmlrpc::parseResponse(xml, response, error);
+
+    _metrics.batches++;
+    _metrics.connects += _connection.connects() - connects;
+    return succeed;
+}
+
+/**
+ * Complete a result with the value returned by the server
+ *
+ * @param result : result to fill
+ * @param value : user name, empty if the ID is unknown
+*/
+void ReleaseBatcher::complete(ReleaseResult& result, const xmlrpc::Value& value)
+{
+    int code = 0;
+    std::string message;
+
+    if (xmlrpc::faultOf(value, code, message)) {
+        fail(result, "Fault " + std::to_string(code) + " : " + message);
+        return;
+    }
+
+    result.user = value.text;
+    result.status = result.user.empty() ? ReleaseResult::Status::Unknown : ReleaseResult::Status::Released;
+    if (result.status == ReleaseResult::Status::Released) {
+        _metrics.released++;
+    } else {
+        _metrics.unknown++;
+    }
+
+    auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - result.event.receivedAt);
+
+    result.latencyMs = static_cast<uint32_t>(waited.count()) + result.event.durationTicks;
+    _metrics.recordLatency(result.latencyMs);
+}
+
+/**
+ * Mark a result as failed
+ *
+ * @param result : result to fill
+ * @param error : description of the error
+*/
+void ReleaseBatcher::fail(ReleaseResult& result, const std::string& error)
+{
+    result.status = ReleaseResult::Status::Failed;
+    result.error = error;
+    _metrics.failed++;
+}
+
+/**
+ * Send the batch as one system.multicall
+ *
+ * @param results : results of the batch, filled
+ *
+ * @return false if the server has no system.multicall (nothing filled), else true
+*/
+bool ReleaseBatcher::flushMulticall(std::vector<ReleaseResult>& results)
+{
+    std::vector<xmlrpc::Call> calls;
+    xmlrpc::Response response;
+    std::string error;
+
+    for (const auto& result : results) {
+        calls.push_back(callOf(result.event));
+    }
+
+    bool succeed = send(xmlrpc::encodeMulticall(calls), response, error);
+
+    if (succeed && response.fault) {
+        _multicall = false;
+        return false;
+    }
+
+    _metrics.calls += results.size();
+    if (succeed && (response.result.type != xmlrpc::Value::Type::Array || response.result.items.size() != results.size())) {
+        error = "Multicall result does not match the calls";
+        succeed = false;
+    }
+
+    for (size_t i = 0; i < results.size(); i++) {
+        if (!succeed) {
+            fail(results[i], error);
+            continue;
+        }
+
+        const xmlrpc::Value& item = response.result.items[i];
+
+        if (item.type == xmlrpc::Value::Type::Array && item.items.size() == 1) {
+            complete(results[i], item.items[0]);
+        } else {
+            complete(results[i], item);             // Fault struct of this call
+        }
+    }
+    return true;
+}
+
+/**
+ * Send the batch as one call per identification
+ *
+ * @param results : results of the batch, filled
+*/
+void ReleaseBatcher::flushSingle(std::vector<ReleaseResult>& results)
+{
+    for (auto& result : results) {
+        xmlrpc::Call call = callOf(result.event);
+        xmlrpc::Response response;
+        std::string error;
+
+        _metrics.calls++;
+        if (!send(xmlrpc::encodeCall(call.method, call.params), response, error)) {
+            fail(result, error);
+        } else if (response.fault) {
+            fail(result, "Fault " + std::to_string(response.faultCode) + " : " + response.faultString);
+        } else {
+            complete(result, response.result);
+        }
+    }
+}
+
+/**
+ * Send the oldest identifications, batch size at most
+ *
+ * A batch of one identification is sent as a single call (smaller request).
+ *
+ * @return results in the order of the identifications
+*/
+std::vector<ReleaseResult> ReleaseBatcher::flush()
+{
+    std::vector<ReleaseResult> results;
+    size_t count = std::min(_events.size(), _config.batchSize);
+
+    for (size_t i = 0; i < count; i++) {
+        results.emplace_back();
+        results.back().event = std::move(_events[i]);
+    }
+    _events.erase(_events.begin(), _events.begin() + count);
+
+    if (results.empty()) {
+        return results;
+    }
+    if (results.size() == 1 || !_multicall || !flushMulticall(results)) {
+        flushSingle(results);
+    }
+    return results;
+}
@@ -0,0 +1,71 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                RELEASE BATCHER
+//
+// Resolve the identifications to PaperCut users
+// - Card and Wiegand numbers : card method (api.lookUpUserNameByCardNo)
+// - BLE and NFC users : user method (api.lookUpUserNameByIDNo)
+// - Identifications grouped in one system.multicall request, sent when the batch
+//   is full or when the first identification waited the batch delay
+// - Server without system.multicall : one call per identification
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RELEASE_BATCHER_H
+#define RELEASE_BATCHER_H
+
+#include <string>
+#include <vector>
+
+#include "bridge_metrics.h"
+#include "http_connection.h"
+#include "identification_event.h"
+#include "xml_rpc.h"
+
+struct BatchConfig
+{
+    std::string token;                                      // Authentication token of the API
+    std::string cardMethod = "api.lookUpUserNameByCardNo";
+    std::string userMethod = "api.lookUpUserNameByIDNo";
+    size_t batchSize = 8;                                   // Identifications per request at most
+    std::chrono::milliseconds batchDelay{50};               // Longest wait of the first identification
+};
+
+struct ReleaseResult
+{
+    enum class Status { Released, Unknown, Failed };
+
+    IdentificationEvent event;
+    Status status = Status::Failed;
+    std::string user;               // User name (Released)
+    std::string error;              // Description of the error (Failed)
+    uint32_t latencyMs = 0;         // Tap to release : reader identification + bridge + server
+};
+
+class ReleaseBatcher
+{
+public:
+    ReleaseBatcher(HttpConnection& connection, BatchConfig config, BridgeMetrics& metrics);
+
+    void add(IdentificationEvent event);
+    bool pending() const { return !_events.empty(); }
+    bool due(Clock::time_point now) const;
+    Clock::time_point deadline() const;
+    std::vector<ReleaseResult> flush();
+
+    bool multicall() const { return _multicall; }
+
+private:
+    xmlrpc::Call callOf(const IdentificationEvent& event) const;
+    bool send(const std::string& body, xmlrpc::Response& response, std::string& error);
+    void complete(ReleaseResult& result, const xmlrpc::Value& value);
+    void fail(ReleaseResult& result, const std::string& error);
+    bool flushMulticall(std::vector<ReleaseResult>& results);
+    void flushSingle(std::vector<ReleaseResult>& results);
+
+    HttpConnection& _connection;
+    BatchConfig _config;
+    BridgeMetrics& _metrics;
+    std::vector<IdentificationEvent> _events;
+    bool _multicall = true;         // Cleared when the server has no system.multicall
+};
+
+#endif
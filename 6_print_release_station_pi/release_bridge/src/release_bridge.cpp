@@ -0,0 +1,374 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                RELEASE BRIDGE
+//
+// - One thread : epoll on the readers and an eventfd (stop), the timeout of
+//   the wait is the next batch deadline, reopen attempt or metrics write
+// - The readers are opened O_NONBLOCK, raw mode (no echo, no line editing, no
+//   CR to LF translation : the frames are binary)
+// - A reader is closed on hang-up, EIO or end of file (USB unplugged) and its
+//   stream reset : a partial line or frame is not merged with the next one
+// - The parser counters are kept across the resets for the metrics
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "release_bridge.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <unistd.h>
+#include <utility>
+
+static constexpr uint32_t WakeupIndex = UINT32_MAX;    // epoll data of the eventfd
+static constexpr size_t ReadSize = 512;
+
+/**
+ * Convert a baud rate
+ *
+ * @param baud : bits per second
+ *
+ * @return termios speed, B115200 if not supported
+*/
+static speed_t speedOf(unsigned baud)
+{
+    switch (baud) {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 230400:
+            return B230400;
+        default:
+            return B115200;
+    }
+}
+
+/**
+ * Create the bridge, opened by open()
+ *
+ * @param config : readers, server and limits
+*/
+ReleaseBridge::ReleaseBridge(BridgeConfig config)
+    : _config(std::move(config)), _dedup(_config.dedupWindow)
+{
+    for (const auto& reader : _config.readers) {
+        _readers.push_back({reader, ReaderStream(reader.path, reader.format), -1, Clock::time_point(), 0, 0, 0});
+        _metrics.readers[reader.path];
+    }
+}
+
+ReleaseBridge::~ReleaseBridge()
+{
+    for (auto& reader : _readers) {
+        if (reader.fd >= 0) {
+            ::close(reader.fd);
+        }
+    }
+    if (_wakeup >= 0) {
+        ::close(_wakeup);
+    }
+    if (_epoll >= 0) {
+        ::close(_epoll);
+    }
+}
+
+/**
+ * Check the configuration and open the readers
+ *
+ * A reader missing at start is not an error, it is opened when it is plugged.
+ *
+ * @param error : description of the error
+ *
+ * @return true if succeed, else false
+*/
+bool ReleaseBridge::open(std::string& error)
+{
+    std::string host;
+    std::string path;
+    uint16_t port = 0;
+
+    if (_readers.empty()) {
+        error = "No reader";
+        return false;
+    }
+    if (!HttpConnection::parseUrl(_config.url, host, port, path)) {
+        error = "Invalid server URL " + _config.url + " (http://host[:port]/path)";
+        return false;
+    }
+
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    _wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_epoll < 0 || _wakeup < 0) {
+        error = std::string("epoll : ") + strerror(errno);
+        return false;
+    }
+
+    epoll_event event = {};
+
+    event.events = EPOLLIN;
+    event.data.u32 = WakeupIndex;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event);
+
+    _connection.reset(new HttpConnection(host, port, path, _config.httpTimeout));
+    _batcher.reset(new ReleaseBatcher(*_connection, _config.batch, _metrics));
+
+    Clock::time_point now = Clock::now();
+
+    for (size_t i = 0; i < _readers.size(); i++) {
+        if (!openReader(_readers[i], i)) {
+            _readers[i].retryAt = now + _config.reopenDelay;
+        }
+    }
+    _metricsAt = now + _config.metricsPeriod;
+    return true;
+}
+
+/**
+ * Open a reader and add it to epoll
+ *
+ * @param reader : reader closed
+ * @param index : index of the reader, epoll data
+ *
+ * @return true if succeed, else false
+*/
+bool ReleaseBridge::openReader(Reader& reader, size_t index)
+{
+    int fd = ::open(reader.config.path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    termios options;
+
+    if (tcgetattr(fd, &options) == 0) {
+        cfmakeraw(&options);
+        cfsetispeed(&options, speedOf(reader.config.baud));
+        cfsetospeed(&options, speedOf(reader.config.baud));
+        options.c_cflag |= CLOCAL | CREAD;
+        options.c_cc[VMIN] = 1;
+        options.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &options);
+    }
+
+    epoll_event event = {};
+
+    event.events = EPOLLIN;
+    event.data.u32 = static_cast<uint32_t>(index);
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    reader.fd = fd;
+    _metrics.readers[reader.config.path].opens++;
+    fprintf(stderr, "Reader %s opened\n", reader.config.path.c_str());
+    return true;
+}
+
+/**
+ * Close a reader unplugged or in error
+ *
+ * @param reader : reader open
+ * @param now : current time
+*/
+void ReleaseBridge::closeReader(Reader& reader, Clock::time_point now)
+{
+    const TIDFrameParser& parser = reader.stream.frameParser();
+
+    reader.frameErrors += parser.CRCErrors + parser.FormatErrors;
+    reader.framesMissed += parser.MissedFrames;
+    reader.restarts += parser.Restarts;
+    reader.stream.reset();
+
+    epoll_ctl(_epoll, EPOLL_CTL_DEL, reader.fd, nullptr);
+    ::close(reader.fd);
+    reader.fd = -1;
+    reader.retryAt = now + _config.reopenDelay;
+    fprintf(stderr, "Reader %s closed\n", reader.config.path.c_str());
+}
+
+/**
+ * Read the bytes of a reader and batch its identifications
+ *
+ * @param reader : reader open
+*/
+void ReleaseBridge::readReader(Reader& reader)
+{
+    uint8_t data[ReadSize];
+    std::vector<IdentificationEvent> events;
+
+    for (;;) {
+        ssize_t length = read(reader.fd, data, sizeof(data));
+
+        if (length > 0) {
+            reader.stream.feed(data, static_cast<size_t>(length), Clock::now(), events);
+            continue;
+        }
+        if (length < 0 && errno == EINTR) {
+            continue;
+        }
+        if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        closeReader(reader, Clock::now());      // End of file or EIO : unplugged
+        break;
+    }
+
+    for (auto& event : events) {
+        _metrics.readers[reader.config.path].events++;
+        if (_dedup.accept(event)) {
+            _batcher->add(std::move(event));
+        }
+    }
+    _metrics.suppressed = _dedup.suppressed();
+}
+
+/**
+ * Send the batches due
+ *
+ * @param all : send every identification waiting (stop)
+*/
+void ReleaseBridge::flushBatches(bool all)
+{
+    while (_batcher->pending() && (all || _batcher->due(Clock::now()))) {
+        for (const auto& result : _batcher->flush()) {
+            if (onResult) {
+                onResult(result);
+            }
+        }
+    }
+}
+
+/**
+ * Copy the counters of the readers to the metrics
+*/
+void ReleaseBridge::updateMetrics()
+{
+    for (const auto& reader : _readers) {
+        const TIDFrameParser& parser = reader.stream.frameParser();
+        BridgeMetrics::Reader& counters = _metrics.readers[reader.config.path];
+
+        counters.frameErrors = reader.frameErrors + parser.CRCErrors + parser.FormatErrors;
+        counters.framesMissed = reader.framesMissed + parser.MissedFrames;
+        counters.restarts = reader.restarts + parser.Restarts;
+        counters.overlongLines = reader.stream.overlongLines();
+    }
+}
+
+/**
+ * Get the metrics
+ *
+ * @return counters, reader counters updated
+*/
+const BridgeMetrics& ReleaseBridge::metrics()
+{
+    updateMetrics();
+    return _metrics;
+}
+
+/**
+ * Write the metrics file
+*/
+void ReleaseBridge::writeMetrics()
+{
+    std::string error;
+
+    updateMetrics();
+    if (!_config.metricsPath.empty() && !_metrics.write(_config.metricsPath, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+    }
+}
+
+/**
+ * Wait for the readers and handle the identifications, batches and metrics
+ *
+ * @param maxWait : longest wait for an event
+*/
+void ReleaseBridge::runOnce(std::chrono::milliseconds maxWait)
+{
+    Clock::time_point now = Clock::now();
+    Clock::time_point wakeAt = std::min(now + maxWait, _batcher->deadline());
+
+    for (size_t i = 0; i < _readers.size(); i++) {
+        Reader& reader = _readers[i];
+
+        if (reader.fd < 0 && now >= reader.retryAt && !openReader(reader, i)) {
+            reader.retryAt = now + _config.reopenDelay;
+        }
+        if (reader.fd < 0) {
+            wakeAt = std::min(wakeAt, reader.retryAt);
+        }
+    }
+    if (!_config.metricsPath.empty()) {
+        wakeAt = std::min(wakeAt, _metricsAt);
+    }
+
+    auto timeout = std::chrono::duration_cast<std::chrono::milliseconds>(wakeAt - now);
+    epoll_event events[8];
+    int count = epoll_wait(_epoll, events, 8, static_cast<int>(std::max<int64_t>(timeout.count(), 0)));
+
+    for (int i = 0; i < count; i++) {
+        uint32_t index = events[i].data.u32;
+
+        if (index == WakeupIndex) {
+            uint64_t value;
+
+            while (read(_wakeup, &value, sizeof(value)) > 0) {
+            }
+            continue;
+        }
+
+        Reader& reader = _readers[index];
+
+        if (reader.fd < 0) {
+            continue;                           // Closed by a previous event of this wait
+        }
+        if (events[i].events & EPOLLIN) {
+            readReader(reader);
+        } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+            closeReader(reader, Clock::now());
+        }
+    }
+
+    flushBatches(false);
+
+    now = Clock::now();
+    if (!_config.metricsPath.empty() && now >= _metricsAt) {
+        writeMetrics();
+        _metricsAt = now + _config.metricsPeriod;
+    }
+}
+
+/**
+ * Run until stop(), send the identifications waiting and write the metrics
+*/
+void ReleaseBridge::run()
+{
+    while (!_stopping) {
+        runOnce(std::chrono::milliseconds(1000));
+    }
+    flushBatches(true);
+    writeMetrics();
+}
+
+/**
+ * Stop run(), can be called from a signal handler
+*/
+void ReleaseBridge::stop()
+{
+    uint64_t value = 1;
+
+    _stopping = true;
+    if (_wakeup >= 0 && write(_wakeup, &value, sizeof(value)) < 0) {
+        // Nothing to do : the flag is checked at the latest after the next wait
+    }
+}
@@ -0,0 +1,97 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                RELEASE BRIDGE
+//
+// Event loop of the release station
+// - Card readers (USB CDC or serial) read without blocking through epoll
+// - Identifications decoded (text or frames), repeats dropped, batched to the
+//   PaperCut XML-RPC API on one persistent connection
+// - Reader unplugged : reopened every reopen delay until it is back
+// - Metrics written periodically to a Prometheus text file
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RELEASE_BRIDGE_H
+#define RELEASE_BRIDGE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bridge_metrics.h"
+#include "dedup_filter.h"
+#include "http_connection.h"
+#include "reader_stream.h"
+#include "release_batcher.h"
+
+struct ReaderConfig
+{
+    std::string path;                       // Device (/dev/ttyACM0, /dev/serial/by-id/...)
+    StreamFormat format = StreamFormat::Auto;
+    unsigned baud = 115200;                 // Serial readers only (ignored by USB CDC)
+};
+
+struct BridgeConfig
+{
+    std::vector<ReaderConfig> readers;
+    std::string url = "http://localhost:9191/rpc/api/xmlrpc";
+    BatchConfig batch;
+    std::chrono::milliseconds dedupWindow{3000};
+    std::chrono::milliseconds httpTimeout{2000};
+    std::chrono::milliseconds reopenDelay{1000};
+    std::string metricsPath;                // Empty : no metrics file
+    std::chrono::milliseconds metricsPeriod{10000};
+};
+
+class ReleaseBridge
+{
+public:
+    explicit ReleaseBridge(BridgeConfig config);
+    ~ReleaseBridge();
+
+    ReleaseBridge(const ReleaseBridge&) = delete;
+    ReleaseBridge& operator=(const ReleaseBridge&) = delete;
+
+    bool open(std::string& error);
+    void runOnce(std::chrono::milliseconds maxWait);
+    void run();
+    void stop();
+
+    const BridgeMetrics& metrics();
+    bool readerOpen(size_t index) const { return _readers[index].fd >= 0; }
+
+    std::function<void(const ReleaseResult&)> onResult;     // Called for each identification sent
+
+private:
+    struct Reader
+    {
+        ReaderConfig config;
+        ReaderStream stream;
+        int fd = -1;
+        Clock::time_point retryAt;          // Next open attempt while closed
+        uint64_t frameErrors = 0;           // Counters of the parser before the last reset
+        uint64_t framesMissed = 0;
+        uint64_t restarts = 0;
+    };
+
+    bool openReader(Reader& reader, size_t index);
+    void closeReader(Reader& reader, Clock::time_point now);
+    void readReader(Reader& reader);
+    void flushBatches(bool all);
+    void updateMetrics();
+    void writeMetrics();
+
+    BridgeConfig _config;
+    std::vector<Reader> _readers;
+    std::unique_ptr<HttpConnection> _connection;
+    std::unique_ptr<ReleaseBatcher> _batcher;
+    DedupFilter _dedup;
+    BridgeMetrics _metrics;
+
+    int _epoll = -1;
+    int _wakeup = -1;                       // eventfd written by stop()
+    std::atomic<bool> _stopping{false};
+    Clock::time_point _metricsAt;
+};
+
+#endif
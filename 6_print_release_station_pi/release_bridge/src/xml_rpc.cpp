@@ -0,0 +1,482 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    XML RPC
+//
+// The documents of the XML-RPC specification only, no DTD, no namespace : the
+// decoder is a tag reader over the response, not a general XML parser.
+//
+// - <value> without type tag is a string (specification)
+// - Entities : &lt; &gt; &amp; &quot; &apos; and numeric references (ASCII)
+// - system.multicall result : one array per call, [result] or a fault struct
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "xml_rpc.h"
+
+#include <cstdlib>
+
+namespace xmlrpc {
+
+/**
+ * String value
+ *
+ * @param text : string
+ *
+ * @return value
+*/
+Value Value::string(std::string text)
+{
+    Value value;
+
+    value.type = Type::String;
+    value.text = std::move(text);
+    return value;
+}
+
+/**
+ * Integer value (i4)
+ *
+ * @param number : integer
+ *
+ * @return value
+*/
+Value Value::integer(int number)
+{
+    Value value;
+
+    value.type = Type::Int;
+    value.text = std::to_string(number);
+    return value;
+}
+
+/**
+ * Array value
+ *
+ * @param items : values of the array
+ *
+ * @return value
+*/
+Value Value::array(std::vector<Value> items)
+{
+    Value value;
+
+    value.type = Type::Array;
+    value.items = std::move(items);
+    return value;
+}
+
+/**
+ * Struct value
+ *
+ * @param members : names and values
+ *
+ * @return value
+*/
+Value Value::structure(std::vector<std::pair<std::string, Value>> members)
+{
+    Value value;
+
+    value.type = Type::Struct;
+    value.members = std::move(members);
+    return value;
+}
+
+/**
+ * Member of a struct
+ *
+ * @param name : name of the member
+ *
+ * @return pointer to the value, nullptr if not a struct or no such member
+*/
+const Value* Value::member(const std::string& name) const
+{
+    for (const auto& entry : members) {
+        if (entry.first == name) {
+            return &entry.second;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Check if the value is a fault struct (faultCode and faultString)
+ *
+ * @return true if fault, else false
+*/
+bool Value::isFault() const
+{
+    return type == Type::Struct && member("faultCode") != nullptr && member("faultString") != nullptr;
+}
+
+/**
+ * Escape the characters of a text
+ *
+ * @param text : text
+ *
+ * @return text with &, < and > replaced by entities
+*/
+std::string escape(const std::string& text)
+{
+    std::string escaped;
+
+    escaped.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * Encode a value
+ *
+ * @param value : value
+ *
+ * @return <value> element
+*/
+std::string encodeValue(const Value& value)
+{
+    std::string xml = "<value>";
+
+    switch (value.type) {
+        case Value::Type::Nil:
+            xml += "<nil/>";
+            break;
+        case Value::Type::String:
+            xml += "<string>" + escape(value.text) + "</string>";
+            break;
+        case Value::Type::Int:
+            xml += "<int>" + value.text + "</int>";
+            break;
+        case Value::Type::Boolean:
+            xml += "<boolean>" + value.text + "</boolean>";
+            break;
+        case Value::Type::Double:
+            xml += "<double>" + value.text + "</double>";
+            break;
+        case Value::Type::Array:
+            xml += "<array><data>";
+            for (const auto& item : value.items) {
+                xml += encodeValue(item);
+            }
+            xml += "</data></array>";
+            break;
+        case Value::Type::Struct:
+            xml += "<struct>";
+            for (const auto& entry : value.members) {
+                xml += "<member><name>" + escape(entry.first) + "</name>" + encodeValue(entry.second) + "</member>";
+            }
+            xml += "</struct>";
+            break;
+    }
+    return xml + "</value>";
+}
+
+/**
+ * Encode a method call
+ *
+ * @param method : method name
+ * @param params : parameters
+ *
+ * @return XML document
+*/
+std::string encodeCall(const std::string& method, const std::vector<Value>& params)
+{
+    std::string xml = "<?xml version=\"1.0\"?><methodCall><methodName>" + escape(method) + "</methodName><params>";
+
+    for (const auto& param : params) {
+        xml += "<param>" + encodeValue(param) + "</param>";
+    }
+    return xml + "</params></methodCall>";
+}
+
+/**
+ * Encode several calls in a system.multicall
+ *
+ * @param calls : methods and parameters
+ *
+ * @return XML document
+*/
+std::string encodeMulticall(const std::vector<Call>& calls)
+{
+    std::vector<Value> items;
+
+    items.reserve(calls.size());
+    for (const auto& call : calls) {
+        items.push_back(Value::structure({{"methodName", Value::string(call.method)},
+                                          {"params", Value::array(call.params)}}));
+    }
+    return encodeCall("system.multicall", {Value::array(std::move(items))});
+}
+
+namespace {
+
+// Tag reader over a document
+class Reader
+{
+public:
+    explicit Reader(const std::string& xml) : _xml(xml) {}
+
+    /**
+     * Read the next tag, the text before it is kept
+     *
+     * @param tag : name of the tag ("/name" for an end tag, "name/" for an empty tag)
+     *
+     * @return true if a tag is read, false at the end of the document
+    */
+    bool next(std::string& tag)
+    {
+        for (;;) {
+            size_t start = _xml.find('<', _position);
+
+            if (start == std::string::npos) {
+                return false;
+            }
+            _text = _xml.substr(_position, start - _position);
+
+            size_t end = _xml.find('>', start);
+
+            if (end == std::string::npos) {
+                return false;
+            }
+            _position = end + 1;
+
+            if (_xml[start + 1] == '?' || _xml[start + 1] == '!') {
+                continue;       // Declaration, comment
+            }
+
+            tag = _xml.substr(start + 1, end - start - 1);
+
+            bool empty = !tag.empty() && tag.back() == '/';
+            size_t space = tag.find_first_of(" \t\r\n/", 1);
+
+            if (space != std::string::npos) {
+                tag.erase(space);       // Attributes
+            }
+            if (empty) {
+                tag += '/';
+            }
+            return true;
+        }
+    }
+
+    /**
+     * Text before the last tag, entities decoded
+     *
+     * @return text
+    */
+    std::string text() const
+    {
+        std::string decoded;
+
+        for (size_t i = 0; i < _text.size(); i++) {
+            if (_text[i] != '&') {
+                decoded += _text[i];
+                continue;
+            }
+
+            size_t end = _text.find(';', i);
+
+            if (end == std::string::npos) {
+                decoded += _text[i];
+                continue;
+            }
+
+            std::string entity = _text.substr(i + 1, end - i - 1);
+
+            if (entity == "lt") decoded += '<';
+            else if (entity == "gt") decoded += '>';
+            else if (entity == "amp") decoded += '&';
+            else if (entity == "quot") decoded += '"';
+            else if (entity == "apos") decoded += '\'';
+            else if (!entity.empty() && entity[0] == '#') {
+                long code = (entity.size() > 1 && entity[1] == 'x') ? strtol(entity.c_str() + 2, nullptr, 16)
+                                                                   : strtol(entity.c_str() + 1, nullptr, 10);
+                decoded += (code > 0 && code < 0x80) ? static_cast<char>(code) : '?';
+            } else {
+                decoded += _text.substr(i, end - i + 1);
+            }
+            i = end;
+        }
+        return decoded;
+    }
+
+private:
+    const std::string& _xml;
+    size_t _position = 0;
+    std::string _text;
+};
+
+bool parseValue(Reader& reader, Value& value, std::string& error);
+
+/**
+ * Read tags until an end tag
+ *
+ * @param reader : tag reader
+ * @param name : name of the end tag
+ *
+ * @return true if found, else false
+*/
+bool skipTo(Reader& reader, const std::string& name)
+{
+    std::string tag;
+
+    while (reader.next(tag)) {
+        if (tag == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parse the content of a <value> (opening tag read)
+ *
+ * @param reader : tag reader
+ * @param value : value to fill
+ * @param error : description of the error
+ *
+ * @return true if succeed, else false
+*/
+bool parseValue(Reader& reader, Value& value, std::string& error)
+{
+    std::string tag;
+
+    if (!reader.next(tag)) {
+        error = "Truncated value";
+        return false;
+    }
+
+    if (tag == "/value") {
+        value = Value::string(reader.text());       // No type : string
+        return true;
+    }
+
+    if (tag == "nil/") {
+        value = Value();
+    } else if (tag == "string" || tag == "int" || tag == "i4" || tag == "i8" || tag == "boolean" || tag == "double") {
+        if (!reader.next(tag) || tag[0] != '/') {
+            error = "Malformed scalar";
+            return false;
+        }
+        value.type = (tag == "/string") ? Value::Type::String
+                   : (tag == "/boolean") ? Value::Type::Boolean
+                   : (tag == "/double") ? Value::Type::Double : Value::Type::Int;
+        value.text = reader.text();
+    } else if (tag == "string/") {
+        value = Value::string("");
+    } else if (tag == "array") {
+        value = Value::array({});
+        if (!skipTo(reader, "data")) {
+            error = "Array without data";
+            return false;
+        }
+        while (reader.next(tag) && tag == "value") {
+            Value item;
+
+            if (!parseValue(reader, item, error)) {
+                return false;
+            }
+            value.items.push_back(std::move(item));
+        }
+        if (tag != "/data" || !skipTo(reader, "/array")) {
+            error = "Malformed array";
+            return false;
+        }
+    } else if (tag == "struct") {
+        value = Value::structure({});
+        while (reader.next(tag) && tag == "member") {
+            std::string name;
+            Value member;
+
+            if (!skipTo(reader, "name") || !reader.next(tag) || tag != "/name") {
+                error = "Member without name";
+                return false;
+            }
+            name = reader.text();
+            if (!skipTo(reader, "value") || !parseValue(reader, member, error) || !skipTo(reader, "/member")) {
+                if (error.empty()) {
+                    error = "Malformed member";
+                }
+                return false;
+            }
+            value.members.emplace_back(std::move(name), std::move(member));
+        }
+        if (tag != "/struct") {
+            error = "Malformed struct";
+            return false;
+        }
+    } else {
+        error = "Unknown type " + tag;
+        return false;
+    }
+
+    if (!skipTo(reader, "/value")) {
+        error = "Value not closed";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Parse a method response
+ *
+ * @param xml : XML document
+ * @param response : result or fault to fill
+ * @param error : description of the error
+ *
+ * @return true if the document is a method response, else false
+*/
+bool parseResponse(const std::string& xml, Response& response, std::string& error)
+{
+    Reader reader(xml);
+    std::string tag;
+
+    response = Response();
+    if (!skipTo(reader, "methodResponse") || !reader.next(tag)) {
+        error = "Not a method response";
+        return false;
+    }
+
+    if (tag == "fault") {
+        Value fault;
+
+        if (!skipTo(reader, "value") || !parseValue(reader, fault, error)) {
+            return false;
+        }
+        response.fault = true;
+        faultOf(fault, response.faultCode, response.faultString);
+        return true;
+    }
+
+    if (tag != "params" || !skipTo(reader, "param") || !skipTo(reader, "value")) {
+        error = "Response without result";
+        return false;
+    }
+    return parseValue(reader, response.result, error);
+}
+
+/**
+ * Read a fault struct
+ *
+ * @param value : fault struct
+ * @param code : fault code
+ * @param message : fault string
+ *
+ * @return true if the value is a fault, else false
+*/
+bool faultOf(const Value& value, int& code, std::string& message)
+{
+    if (!value.isFault()) {
+        return false;
+    }
+    code = atoi(value.member("faultCode")->text.c_str());
+    message = value.member("faultString")->text;
+    return true;
+}
+
+} // namespace xmlrpc
@@ -0,0 +1,62 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                    XML RPC
+//
+// Minimal XML-RPC encoder and decoder for the PaperCut web services API
+// - Values : string, int, boolean, double, array, struct (nil read as empty)
+// - Method calls and system.multicall (several calls in one request)
+// - Responses : result value or fault (code and message)
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef XML_RPC_H
+#define XML_RPC_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xmlrpc {
+
+struct Value
+{
+    enum class Type { Nil, String, Int, Boolean, Double, Array, Struct };
+
+    Type type = Type::Nil;
+    std::string text;                                   // String, or text of Int, Boolean and Double
+    std::vector<Value> items;                           // Array
+    std::vector<std::pair<std::string, Value>> members; // Struct
+
+    static Value string(std::string text);
+    static Value integer(int value);
+    static Value array(std::vector<Value> items);
+    static Value structure(std::vector<std::pair<std::string, Value>> members);
+
+    const Value* member(const std::string& name) const;
+    bool isFault() const;
+};
+
+// Call of a system.multicall
+struct Call
+{
+    std::string method;
+    std::vector<Value> params;
+};
+
+struct Response
+{
+    bool fault = false;
+    int faultCode = 0;
+    std::string faultString;
+    Value result;
+};
+
+std::string escape(const std::string& text);
+std::string encodeValue(const Value& value);
+std::string encodeCall(const std::string& method, const std::vector<Value>& params);
+std::string encodeMulticall(const std::vector<Call>& calls);
+
+bool parseResponse(const std::string& xml, Response& response, std::string& error);
+bool faultOf(const Value& value, int& code, std::string& message);
+
+} // namespace xmlrpc
+
+#endif
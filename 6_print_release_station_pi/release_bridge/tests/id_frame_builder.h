@@ -0,0 +1,37 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                               ID FRAME BUILDER
+//
+// Frames of the card reader (HOSTFORMAT_FRAME) built for the tests
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ID_FRAME_BUILDER_H
+#define ID_FRAME_BUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "id_frame_parser.h"
+
+static std::vector<uint8_t> buildFrame(uint16_t sequence, uint8_t source, const std::string& id, uint16_t durationTicks = 0,
+                                       uint32_t timestamp = 0)
+{
+    std::vector<uint8_t> frame = {IDFRAME_SOF, static_cast<uint8_t>(IDFRAME_HEADERLENGTH + id.size()), IDFRAME_VERSION,
+                                  static_cast<uint8_t>(sequence), static_cast<uint8_t>(sequence >> 8), source, 0};
+
+    for (int i = 0; i < 4; i++) {
+        frame.push_back(static_cast<uint8_t>(timestamp >> (8 * i)));
+    }
+    frame.push_back(static_cast<uint8_t>(durationTicks));
+    frame.push_back(static_cast<uint8_t>(durationTicks >> 8));
+    frame.push_back(static_cast<uint8_t>(id.size()));
+    frame.insert(frame.end(), id.begin(), id.end());
+
+    uint16_t CRC = idFrameCRC(&frame[1], static_cast<int>(frame.size() - 1));
+
+    frame.push_back(static_cast<uint8_t>(CRC));
+    frame.push_back(static_cast<uint8_t>(CRC >> 8));
+    return frame;
+}
+
+#endif
@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                             MOCK XML-RPC SERVER
+//
+// One thread accepts the connections, one thread per connection answers its
+// requests until the client closes it. The requests are read with string
+// searches : the mock only understands the calls of the release batcher
+// (string parameters token and ID).
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "mock_xml_rpc_server.h"
+
+#include <arpa/inet.h>
+#include <cstdlib>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "xml_rpc.h"
+
+/**
+ * Extract the texts of the elements of a tag
+ *
+ * @param xml : document
+ * @param tag : tag name
+ *
+ * @return texts in the order of the document
+*/
+static std::vector<std::string> elements(const std::string& xml, const std::string& tag)
+{
+    std::vector<std::string> texts;
+    std::string open = "<" + tag + ">";
+    std::string close = "</" + tag + ">";
+    size_t start = xml.find(open);
+
+    while (start != std::string::npos) {
+        size_t end = xml.find(close, start);
+
+        if (end == std::string::npos) {
+            break;
+        }
+        texts.push_back(xml.substr(start + open.size(), end - start - open.size()));
+        start = xml.find(open, end);
+    }
+    return texts;
+}
+
+static std::string responseOf(const xmlrpc::Value& value)
+{
+    return "<?xml version=\"1.0\"?><methodResponse><params><param>" + xmlrpc::encodeValue(value) +
+           "</param></params></methodResponse>";
+}
+
+static std::string faultOf(int code, const std::string& message)
+{
+    xmlrpc::Value fault = xmlrpc::Value::structure({{"faultCode", xmlrpc::Value::integer(code)},
+                                                    {"faultString", xmlrpc::Value::string(message)}});
+
+    return "<?xml version=\"1.0\"?><methodResponse><fault>" + xmlrpc::encodeValue(fault) + "</fault></methodResponse>";
+}
+
+MockXmlRpcServer::MockXmlRpcServer()
+{
+    sockaddr_in address = {};
+    socklen_t length = sizeof(address);
+
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    _listen = socket(AF_INET, SOCK_STREAM, 0);
+    if (_listen < 0 || bind(_listen, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(_listen, 8) != 0 || getsockname(_listen, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+        abort();
+    }
+    _port = ntohs(address.sin_port);
+    _thread = std::thread(&MockXmlRpcServer::serve, this);
+}
+
+MockXmlRpcServer::~MockXmlRpcServer()
+{
+    _stopping = true;
+    _thread.join();
+    ::close(_listen);
+}
+
+std::string MockXmlRpcServer::url() const
+{
+    return "http://127.0.0.1:" + std::to_string(_port) + "/rpc/api/xmlrpc";
+}
+
+std::vector<std::string> MockXmlRpcServer::methods()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _methods;
+}
+
+void MockXmlRpcServer::serve()
+{
+    std::vector<std::thread> threads;
+
+    while (!_stopping) {
+        pollfd entry = {_listen, POLLIN, 0};
+
+        if (poll(&entry, 1, 50) == 1) {
+            int fd = accept(_listen, nullptr, nullptr);
+
+            if (fd >= 0) {
+                connections++;
+                threads.emplace_back(&MockXmlRpcServer::serveConnection, this, fd);
+            }
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void MockXmlRpcServer::serveConnection(int fd)
+{
+    std::string buffer;
+
+    while (!_stopping) {
+        size_t headerEnd = buffer.find("\r\n\r\n");
+
+        if (headerEnd != std::string::npos) {
+            size_t position = buffer.find("Content-Length: ");
+            size_t length = (position < headerEnd) ? strtoul(buffer.c_str() + position + 16, nullptr, 10) : 0;
+
+            if (buffer.size() >= headerEnd + 4 + length) {
+                std::string body = answer(buffer.substr(headerEnd + 4, length));
+                std::string reply = "HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nContent-Length: " +
+                                    std::to_string(body.size()) + "\r\n\r\n" + body;
+
+                buffer.erase(0, headerEnd + 4 + length);
+                requests++;
+                if (send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) != static_cast<ssize_t>(reply.size())) {
+                    break;
+                }
+                continue;
+            }
+        }
+
+        pollfd entry = {fd, POLLIN, 0};
+
+        if (poll(&entry, 1, 50) != 1) {
+            continue;
+        }
+
+        char data[4096];
+        ssize_t received = recv(fd, data, sizeof(data), 0);
+
+        if (received <= 0) {
+            break;
+        }
+        buffer.append(data, static_cast<size_t>(received));
+    }
+    ::close(fd);
+}
+
+std::string MockXmlRpcServer::answer(const std::string& body)
+{
+    std::vector<std::string> names = elements(body, "methodName");
+    std::vector<std::string> strings = elements(body, "string");
+    std::vector<std::pair<std::string, std::string>> calls;      // Method, ID
+
+    if (names.empty()) {
+        return faultOf(-32700, "Parse error");
+    }
+    if (names[0] == "system.multicall") {
+        if (!multicall) {
+            return faultOf(-32601, "Method system.multicall not found");
+        }
+        for (size_t i = 0; i + 2 < strings.size(); i += 3) {
+            calls.emplace_back(strings[i], strings[i + 2]);      // methodName, token, ID
+        }
+    } else if (strings.size() == 2) {
+        calls.emplace_back(names[0], strings[1]);
+    } else {
+        return faultOf(-32602, "Invalid parameters");
+    }
+
+    std::vector<xmlrpc::Value> results;
+
+    for (const auto& call : calls) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        xmlrpc::Value user = xmlrpc::Value::string(unknownIds.count(call.second) ? "" : "user-" + call.second);
+
+        _methods.push_back(call.first);
+        results.push_back(names[0] == "system.multicall" ? xmlrpc::Value::array({user}) : user);
+    }
+    return responseOf(names[0] == "system.multicall" ? xmlrpc::Value::array(results) : results[0]);
+}
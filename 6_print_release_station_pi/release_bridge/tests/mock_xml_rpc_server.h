@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                             MOCK XML-RPC SERVER
+//
+// PaperCut API stand-in for the tests, on 127.0.0.1 (port chosen by the system)
+// - Lookup methods : user "user-<ID>", empty for the IDs of unknownIds
+// - system.multicall answered unless disabled (fault -32601)
+// - Keep-alive connections, connections and requests counted
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MOCK_XML_RPC_SERVER_H
+#define MOCK_XML_RPC_SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MockXmlRpcServer
+{
+public:
+    MockXmlRpcServer();
+    ~MockXmlRpcServer();
+
+    std::string url() const;
+
+    std::atomic<int> connections{0};
+    std::atomic<int> requests{0};
+    std::atomic<bool> multicall{true};
+    std::set<std::string> unknownIds;
+
+    std::vector<std::string> methods();     // Methods called, multicall expanded
+
+private:
+    void serve();
+    void serveConnection(int fd);
+    std::string answer(const std::string& body);
+
+    int _listen = -1;
+    uint16_t _port = 0;
+    std::atomic<bool> _stopping{false};
+    std::thread _thread;
+    std::mutex _mutex;
+    std::vector<std::string> _methods;
+};
+
+#endif
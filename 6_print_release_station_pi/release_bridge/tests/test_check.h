@@ -0,0 +1,25 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                  TEST CHECK
+//
+// Checks of the tests : a failed check is printed, the test returns the number
+// of failed checks
+//////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <cstdio>
+
+static int testFailures = 0;
+
+#define CHECK(condition)                                                            \
+    do {                                                                            \
+        if (!(condition)) {                                                         \
+            fprintf(stderr, "%s:%d : check failed : %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++;                                                         \
+        }                                                                           \
+    } while (0)
+
+#define TEST_RESULT() (testFailures == 0 ? 0 : (fprintf(stderr, "%d check(s) failed\n", testFailures), 1))
+
+#endif
@@ -0,0 +1,45 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                               TEST DEDUP FILTER
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "dedup_filter.h"
+#include "test_check.h"
+
+static IdentificationEvent eventOf(const std::string& reader, const std::string& id, Clock::time_point at)
+{
+    IdentificationEvent event;
+
+    event.reader = reader;
+    event.id = id;
+    event.receivedAt = at;
+    return event;
+}
+
+int main()
+{
+    using std::chrono::milliseconds;
+
+    DedupFilter filter(milliseconds(3000));
+    Clock::time_point start = Clock::now();
+
+    CHECK(filter.accept(eventOf("a", "1234", start)));
+    CHECK(!filter.accept(eventOf("a", "1234", start + milliseconds(50))));      // Same reader
+    CHECK(filter.accept(eventOf("b", "1234", start + milliseconds(100))));      // Second reader : another release
+    CHECK(!filter.accept(eventOf("b", "1234", start + milliseconds(150))));
+    CHECK(filter.accept(eventOf("a", "5678", start + milliseconds(200))));
+    CHECK(!filter.accept(eventOf("a", "1234", start + milliseconds(3000))));    // Window restarted by the repeat
+    CHECK(filter.accept(eventOf("a", "1234", start + milliseconds(6100))));
+    CHECK(filter.suppressed() == 3);
+    CHECK(filter.accept(eventOf("a1", "234", start + milliseconds(6200))));     // Not the key of reader "a", ID "1234"
+
+    for (int i = 0; i < 2000; i++) {
+        filter.accept(eventOf("a", std::to_string(i), start + milliseconds(10000 + 10 * i)));
+    }
+    CHECK(filter.size() <= DedupFilter::PruneSize + 1);
+
+    DedupFilter disabled(milliseconds(0));
+
+    CHECK(disabled.accept(eventOf("a", "1234", start)));
+    CHECK(disabled.accept(eventOf("a", "1234", start)));
+    return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                              TEST ID FRAME PARSER
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "id_frame_builder.h"
+#include "test_check.h"
+
+/**
+ * Feed one frame to the parser
+ *
+ * @param parser : parser
+ * @param sequence : sequence number of the frame
+ * @param frame : decoded frame
+ *
+ * @return true if a frame has been decoded
+*/
+static bool feedFrame(TIDFrameParser& parser, uint16_t sequence, TIDFrame& frame)
+{
+    std::vector<uint8_t> bytes = buildFrame(sequence, IDFRAME_SOURCE_CARD, "04A1B2C3");
+    const uint8_t* data = bytes.data();
+    int length = static_cast<int>(bytes.size());
+    bool decoded = false;
+
+    while (length > 0 && !decoded) {
+        int used = idFrameParserFeed(&parser, data, length, &frame, &decoded);
+
+        data += used;
+        length -= used;
+    }
+    return decoded;
+}
+
+// Reader reset and its frame 0 lost : the frames after the restart are delivered
+static void testRestartFirstFrameLost()
+{
+    TIDFrameParser parser;
+    TIDFrame frame;
+
+    idFrameParserInit(&parser);
+    for (uint16_t sequence = 498; sequence <= 500; sequence++) {
+        CHECK(feedFrame(parser, sequence, frame) && !frame.Duplicate);
+    }
+
+    CHECK(feedFrame(parser, 1, frame));
+    CHECK(frame.Restarted && !frame.Duplicate && frame.Missed == 0);
+    for (uint16_t sequence = 2; sequence <= 4; sequence++) {
+        CHECK(feedFrame(parser, sequence, frame) && !frame.Duplicate && !frame.Restarted && frame.Missed == 0);
+    }
+    CHECK(parser.Restarts == 1);
+    CHECK(parser.Duplicates == 0);
+    CHECK(parser.MissedFrames == 0);
+}
+
+// Restart from a sequence number past 0x8000, with and without its frame 0
+static void testRestartHighSequence()
+{
+    TIDFrameParser parser;
+    TIDFrame frame;
+
+    idFrameParserInit(&parser);
+    CHECK(feedFrame(parser, 0x9000, frame));
+    CHECK(feedFrame(parser, 0, frame) && frame.Restarted && !frame.Duplicate);
+    CHECK(feedFrame(parser, 0x9000, frame) && frame.Restarted);
+    CHECK(feedFrame(parser, 1, frame) && frame.Restarted && frame.Missed == 0);
+    CHECK(parser.Restarts == 3);
+}
+
+// Sequence wrapping from 0xffff to 0 : a forward step, not a restart
+static void testWraparound()
+{
+    TIDFrameParser parser;
+    TIDFrame frame;
+
+    idFrameParserInit(&parser);
+    CHECK(feedFrame(parser, 0xfffe, frame));
+    CHECK(feedFrame(parser, 0xffff, frame) && frame.Missed == 0);
+    CHECK(feedFrame(parser, 0, frame) && !frame.Restarted && !frame.Duplicate && frame.Missed == 0);
+    CHECK(feedFrame(parser, 3, frame) && !frame.Restarted && frame.Missed == 2);
+    CHECK(parser.Restarts == 0);
+    CHECK(parser.MissedFrames == 2);
+}
+
+// Same frame received twice : dropped once, the reference stays
+static void testExactRepeat()
+{
+    TIDFrameParser parser;
+    TIDFrame frame;
+
+    idFrameParserInit(&parser);
+    CHECK(feedFrame(parser, 10, frame) && !frame.Duplicate);
+    CHECK(feedFrame(parser, 10, frame) && frame.Duplicate && !frame.Restarted);
+    CHECK(feedFrame(parser, 11, frame) && !frame.Duplicate && frame.Missed == 0);
+    CHECK(parser.Duplicates == 1);
+    CHECK(parser.Restarts == 0);
+    CHECK(parser.MissedFrames == 0);
+}
+
+// Gap longer than IDFRAME_MAXGAP : reader restarted, not frames lost
+static void testLongGap()
+{
+    TIDFrameParser parser;
+    TIDFrame frame;
+
+    idFrameParserInit(&parser);
+    CHECK(feedFrame(parser, 100, frame));
+    CHECK(feedFrame(parser, 100 + IDFRAME_MAXGAP, frame) && !frame.Restarted && frame.Missed == IDFRAME_MAXGAP - 1);
+    CHECK(feedFrame(parser, 100 + 2 * IDFRAME_MAXGAP + 1, frame) && frame.Restarted && frame.Missed == 0);
+    CHECK(parser.MissedFrames == IDFRAME_MAXGAP - 1);
+}
+
+int main()
+{
+    testRestartFirstFrameLost();
+    testRestartHighSequence();
+    testWraparound();
+    testExactRepeat();
+    testLongGap();
+    return TEST_RESULT();
+}
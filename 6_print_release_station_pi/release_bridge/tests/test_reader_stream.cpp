@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                              TEST READER STREAM
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#include "id_frame_builder.h"
+#include "reader_stream.h"
+#include "test_check.h"
+
+static std::vector<IdentificationEvent> feed(ReaderStream& stream, const std::string& text)
+{
+    std::vector<IdentificationEvent> events;
+
+    stream.feed(reinterpret_cast<const uint8_t*>(text.data()), text.size(), Clock::now(), events);
+    return events;
+}
+
+static std::vector<IdentificationEvent> feed(ReaderStream& stream, const std::vector<uint8_t>& bytes)
+{
+    std::vector<IdentificationEvent> events;
+
+    for (uint8_t value : bytes) {
+        stream.feed(&value, 1, Clock::now(), events);       // Byte by byte : split reads
+    }
+    return events;
+}
+
+static void testText()
+{
+    ReaderStream stream("reader", StreamFormat::Auto);
+    std::vector<IdentificationEvent> events = feed(stream, "\r\n12345678\r 87654321\r\nABCD\n\r\n");
+
+    CHECK(stream.format() == StreamFormat::Text);
+    CHECK(events.size() == 3);
+    CHECK(events.size() == 3 && events[0].id == "12345678" && events[1].id == "87654321" && events[2].id == "ABCD");
+    CHECK(!events.empty() && events[0].reader == "reader" && !events[0].framed && events[0].source == IDFRAME_SOURCE_CARD);
+
+    events = feed(stream, "1234");
+    CHECK(events.empty());
+    events = feed(stream, "5\r");
+    CHECK(events.size() == 1 && events[0].id == "12345");
+
+    events = feed(stream, std::string(ReaderStream::MaxLineLength + 1, '7') + "\r42\r");
+    CHECK(events.size() == 1 && events[0].id == "42");
+    CHECK(stream.overlongLines() == 1);
+}
+
+static void testFrames()
+{
+    ReaderStream stream("reader", StreamFormat::Auto);
+    std::vector<uint8_t> bytes = buildFrame(1, IDFRAME_SOURCE_CARD, "04A1B2C3", 120);
+    std::vector<uint8_t> ble = buildFrame(2, IDFRAME_SOURCE_BLE, "user42");
+
+    bytes.insert(bytes.end(), ble.begin(), ble.end());
+    bytes.insert(bytes.end(), ble.begin(), ble.end());      // Repeated frame
+
+    std::vector<IdentificationEvent> events = feed(stream, bytes);
+
+    CHECK(stream.format() == StreamFormat::Frame);
+    CHECK(events.size() == 2);
+    CHECK(events.size() == 2 && events[0].id == "04A1B2C3" && events[0].durationTicks == 120 && events[0].framed);
+    CHECK(events.size() == 2 && events[1].id == "user42" && events[1].source == IDFRAME_SOURCE_BLE && events[1].sequence == 2);
+    CHECK(stream.frameParser().Duplicates == 1);
+
+    std::vector<uint8_t> corrupted = buildFrame(3, IDFRAME_SOURCE_CARD, "11111111");
+    std::vector<uint8_t> next = buildFrame(5, IDFRAME_SOURCE_CARD, "22222222");
+
+    corrupted[16] ^= 0xff;
+    corrupted.insert(corrupted.end(), next.begin(), next.end());
+    events = feed(stream, corrupted);
+    CHECK(events.size() == 1 && events[0].id == "22222222");
+    CHECK(stream.frameParser().CRCErrors == 1);
+    CHECK(stream.frameParser().MissedFrames == 2);
+
+    stream.reset();
+    CHECK(stream.format() == StreamFormat::Auto);
+    CHECK(feed(stream, "99\r").size() == 1);
+}
+
+int main()
+{
+    testText();
+    testFrames();
+    return TEST_RESULT();
+}
@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                              TEST RELEASE BRIDGE
+//
+// Card readers replaced by pseudo-terminals, PaperCut by the mock server
+//////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <pty.h>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+#include "id_frame_builder.h"
+#include "mock_xml_rpc_server.h"
+#include "release_bridge.h"
+#include "test_check.h"
+
+// Pseudo-terminal standing for a card reader
+struct FakeReader
+{
+    int master = -1;
+    int slave = -1;                 // Kept open : the device stays while the bridge reopens it
+    std::string path;
+
+    FakeReader()
+    {
+        char name[64];
+
+        if (openpty(&master, &slave, name, nullptr, nullptr) == 0) {
+            path = name;
+        }
+    }
+
+    ~FakeReader()
+    {
+        unplug();
+        if (slave >= 0) {
+            close(slave);
+        }
+    }
+
+    void write(const std::string& text) { CHECK(::write(master, text.data(), text.size()) == static_cast<ssize_t>(text.size())); }
+    void write(const std::vector<uint8_t>& bytes) { CHECK(::write(master, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size())); }
+
+    void unplug()
+    {
+        if (master >= 0) {
+            close(master);
+            master = -1;
+        }
+    }
+};
+
+static void runUntil(ReleaseBridge& bridge, const std::vector<ReleaseResult>& results, size_t count)
+{
+    Clock::time_point limit = Clock::now() + std::chrono::seconds(5);
+
+    while (results.size() < count && Clock::now() < limit) {
+        bridge.runOnce(std::chrono::milliseconds(20));
+    }
+}
+
+static const ReleaseResult* find(const std::vector<ReleaseResult>& results, const std::string& id)
+{
+    for (const auto& result : results) {
+        if (result.event.id == id) {
+            return &result;
+        }
+    }
+    return nullptr;
+}
+
+int main()
+{
+    MockXmlRpcServer server;
+    FakeReader text;
+    FakeReader frames;
+    BridgeConfig config;
+    std::vector<ReleaseResult> results;
+    std::string error;
+    char metricsPath[] = "/tmp/release_bridge_metricsXXXXXX";
+    int metricsFd = mkstemp(metricsPath);
+
+    CHECK(!text.path.empty() && !frames.path.empty() && metricsFd >= 0);
+    close(metricsFd);
+
+    config.readers = {{text.path, StreamFormat::Auto, 115200}, {frames.path, StreamFormat::Frame, 115200}};
+    config.url = server.url();
+    config.batch.token = "secret";
+    config.batch.batchDelay = std::chrono::milliseconds(100);
+    config.metricsPath = metricsPath;
+
+    ReleaseBridge bridge(config);
+
+    bridge.onResult = [&results](const ReleaseResult& result) { results.push_back(result); };
+    CHECK(bridge.open(error));
+    CHECK(bridge.readerOpen(0) && bridge.readerOpen(1));
+
+    // Text IDs with a repeat and a BLE user in a frame : one batch on one connection
+    text.write("1111\r2222\r1111\r");
+    frames.write(buildFrame(1, IDFRAME_SOURCE_BLE, "user42", 200));
+    runUntil(bridge, results, 3);
+
+    CHECK(results.size() == 3);
+    CHECK(find(results, "1111") && find(results, "1111")->status == ReleaseResult::Status::Released &&
+          find(results, "1111")->user == "user-1111");
+    CHECK(find(results, "2222") && find(results, "2222")->user == "user-2222");
+    CHECK(find(results, "user42") && find(results, "user42")->user == "user-user42" && find(results, "user42")->latencyMs >= 200);
+    CHECK(server.connections == 1);
+
+    std::vector<std::string> methods = server.methods();
+    int cardCalls = 0;
+    int userCalls = 0;
+
+    for (const auto& method : methods) {
+        cardCalls += method == "api.lookUpUserNameByCardNo";
+        userCalls += method == "api.lookUpUserNameByIDNo";
+    }
+    CHECK(cardCalls == 2 && userCalls == 1);
+
+    // Server without system.multicall : single calls on the same connection, unknown ID
+    server.multicall = false;
+    server.unknownIds.insert("4444");
+    results.clear();
+    text.write("3333\r4444\r");
+    runUntil(bridge, results, 2);
+
+    CHECK(results.size() == 2);
+    CHECK(find(results, "3333") && find(results, "3333")->status == ReleaseResult::Status::Released);
+    CHECK(find(results, "4444") && find(results, "4444")->status == ReleaseResult::Status::Unknown);
+    CHECK(server.connections == 1);
+
+    const BridgeMetrics& metrics = bridge.metrics();
+
+    CHECK(metrics.readers.at(text.path).events == 5);
+    CHECK(metrics.readers.at(frames.path).events == 1);
+    CHECK(metrics.suppressed == 1);
+    CHECK(metrics.released == 4 && metrics.unknown == 1 && metrics.failed == 0);
+    CHECK(metrics.connects == 1);
+    CHECK(metrics.latencyCount == 5);
+
+    // Reader unplugged : closed, the other reader keeps working
+    frames.unplug();
+    for (int i = 0; i < 5 && bridge.readerOpen(1); i++) {
+        bridge.runOnce(std::chrono::milliseconds(20));
+    }
+    CHECK(!bridge.readerOpen(1));
+
+    results.clear();
+    text.write("5555\r");
+    runUntil(bridge, results, 1);
+    CHECK(results.size() == 1 && results[0].user == "user-5555");
+
+    // Stop : metrics file written
+    std::thread runner([&bridge]() { bridge.run(); });
+
+    bridge.stop();
+    runner.join();
+
+    std::ifstream file(metricsPath);
+    std::stringstream content;
+
+    content << file.rdbuf();
+    CHECK(content.str().find("release_bridge_results_total{result=\"released\"} 5") != std::string::npos);
+    CHECK(content.str().find("release_bridge_suppressed_total 1") != std::string::npos);
+    CHECK(content.str().find("release_bridge_tap_to_release_ms_count 6") != std::string::npos);
+    remove(metricsPath);
+    return TEST_RESULT();
+}
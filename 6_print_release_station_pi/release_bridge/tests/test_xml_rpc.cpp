@@ -0,0 +1,73 @@
+//////////////////////////////////////////////////////////////////////////////////
+//                                 TEST XML RPC
+//////////////////////////////////////////////////////////////////////////////////
+
+#include "test_check.h"
+#include "xml_rpc.h"
+
+using namespace xmlrpc;
+
+static void testEncode()
+{
+    std::string xml = encodeCall("api.lookUpUserNameByCardNo", {Value::string("tok&en"), Value::string("<1234>")});
+
+    CHECK(xml.find("<methodName>api.lookUpUserNameByCardNo</methodName>") != std::string::npos);
+    CHECK(xml.find("<param><value><string>tok&amp;en</string></value></param>") != std::string::npos);
+    CHECK(xml.find("<string>&lt;1234&gt;</string>") != std::string::npos);
+
+    xml = encodeMulticall({{"api.a", {Value::integer(1)}}, {"api.b", {}}});
+    CHECK(xml.find("<methodName>system.multicall</methodName>") != std::string::npos);
+    CHECK(xml.find("<member><name>methodName</name><value><string>api.a</string></value></member>") != std::string::npos);
+    CHECK(xml.find("<member><name>params</name><value><array><data><value><int>1</int></value></data></array></value></member>") !=
+          std::string::npos);
+}
+
+static void testParse()
+{
+    Response response;
+    std::string error;
+
+    CHECK(parseResponse("<?xml version=\"1.0\"?>\n<methodResponse>\n <params>\n  <param>\n   <value><string>j&amp;doe</string></value>\n"
+                        "  </param>\n </params>\n</methodResponse>\n",
+                        response, error));
+    CHECK(!response.fault && response.result.type == Value::Type::String && response.result.text == "j&doe");
+
+    CHECK(parseResponse("<methodResponse><params><param><value>untyped</value></param></params></methodResponse>", response, error));
+    CHECK(response.result.type == Value::Type::String && response.result.text == "untyped");
+
+    CHECK(parseResponse("<methodResponse><params><param><value><array><data>"
+                        "<value><array><data><value><string>alice</string></value></data></array></value>"
+                        "<value><struct><member><name>faultCode</name><value><int>-1</int></value></member>"
+                        "<member><name>faultString</name><value><string>Invalid card</string></value></member></struct></value>"
+                        "<value><array><data><value><string/></value></data></array></value>"
+                        "</data></array></value></param></params></methodResponse>",
+                        response, error));
+    CHECK(response.result.type == Value::Type::Array && response.result.items.size() == 3);
+    if (response.result.items.size() == 3) {
+        int code = 0;
+        std::string message;
+
+        CHECK(response.result.items[0].items.size() == 1 && response.result.items[0].items[0].text == "alice");
+        CHECK(faultOf(response.result.items[1], code, message) && code == -1 && message == "Invalid card");
+        CHECK(!faultOf(response.result.items[0], code, message));
+        CHECK(response.result.items[2].items.size() == 1 && response.result.items[2].items[0].text.empty());
+    }
+
+    CHECK(parseResponse("<methodResponse><fault><value><struct>"
+                        "<member><name>faultCode</name><value><i4>-32601</i4></value></member>"
+                        "<member><name>faultString</name><value>Method not found</value></member>"
+                        "</struct></value></fault></methodResponse>",
+                        response, error));
+    CHECK(response.fault && response.faultCode == -32601 && response.faultString == "Method not found");
+
+    CHECK(!parseResponse("<html>Not found</html>", response, error));
+    CHECK(!parseResponse("<methodResponse><params><param><value><array><data><value><string>x", response, error));
+    CHECK(!parseResponse("<methodResponse><params><param><value><base64>AA==</base64></value>", response, error));
+}
+
+int main()
+{
+    testEncode();
+    testParse();
+    return TEST_RESULT();
+}